@@ -0,0 +1,117 @@
+/*
+ * DE1-SoC Board Initialisation
+ * ----------------------------
+ * Description:
+ * Brings up the common DE1-SoC peripherals in parallel
+ * using the HPS_InitSched scheduler.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#include "DE1SoC_BoardInit.h"
+#include "DE1SoC_Addresses/DE1SoC_Addresses.h"
+#include "HPS_InitSched/HPS_InitSched.h"
+#include "Util/macros.h"
+
+#ifdef DE1SOC_BOARDINIT_SDCARD
+#include "FatFS/ff.h"
+#include "FatFS/diskio.h"
+#endif
+
+/*
+ * LT24 Chain
+ */
+
+static HpsErr_t _BoardInit_lt24Setup(void* param, unsigned int* delayUs) {
+    PBoardDrivers_t drivers = (PBoardDrivers_t)param;
+    return LT24_initialiseStart(LSC_BASE_GPIO_JP1, LSC_BASE_LT24HWDATA, &drivers->lt24);
+}
+
+static HpsErr_t _BoardInit_lt24Reset(void* param, unsigned int* delayUs) {
+    PBoardDrivers_t drivers = (PBoardDrivers_t)param;
+    return LT24_initialiseContinue(&drivers->lt24, delayUs);
+}
+
+static const InitPhase_t _BoardInit_lt24Phases[] = {
+    //Name      Function                 Deadline (us)
+    {"setup"  , &_BoardInit_lt24Setup,        0},
+    {"reset"  , &_BoardInit_lt24Reset,   500000}  // 251ms of power-up delays
+};
+
+/*
+ * Audio Chain
+ */
+
+static HpsErr_t _BoardInit_gpioSetup(void* param, unsigned int* delayUs) {
+    PBoardDrivers_t drivers = (PBoardDrivers_t)param;
+    //I2C mux pins must be output-high to route the HPS I2C controllers
+    return HPS_GPIO_initialise(LSC_BASE_ARM_GPIO, ARM_GPIO_DIR, ARM_GPIO_I2C_GENERAL_MUX | ARM_GPIO_I2C_LT14HDR_MUX, 0, &drivers->gpio);
+}
+
+static HpsErr_t _BoardInit_i2cSetup(void* param, unsigned int* delayUs) {
+    PBoardDrivers_t drivers = (PBoardDrivers_t)param;
+    return HPS_I2C_initialise(LSC_BASE_I2C_GENERAL, I2C_SPEED_STANDARD, &drivers->i2c);
+}
+
+static HpsErr_t _BoardInit_codecSetup(void* param, unsigned int* delayUs) {
+    PBoardDrivers_t drivers = (PBoardDrivers_t)param;
+    return WM8731_initialiseStart(LSC_BASE_AUDIOCODEC, drivers->i2c, &drivers->audio);
+}
+
+static HpsErr_t _BoardInit_codecConfig(void* param, unsigned int* delayUs) {
+    PBoardDrivers_t drivers = (PBoardDrivers_t)param;
+    return WM8731_initialiseContinue(&drivers->audio, delayUs);
+}
+
+static const InitPhase_t _BoardInit_audioPhases[] = {
+    //Name      Function                 Deadline (us)
+    {"i2c mux", &_BoardInit_gpioSetup,        0},
+    {"i2c"    , &_BoardInit_i2cSetup,         0},
+    {"setup"  , &_BoardInit_codecSetup,       0},
+    {"config" , &_BoardInit_codecConfig, 100000}  // 11 register writes
+};
+
+/*
+ * SD Card Chain
+ */
+
+#ifdef DE1SOC_BOARDINIT_SDCARD
+
+static HpsErr_t _BoardInit_sdIdentify(void* param, unsigned int* delayUs) {
+    DSTATUS stat = disk_initialize(0);
+    if (stat & STA_NODISK) return ERR_NOTFOUND;
+    if (stat & STA_NOINIT) return ERR_BADDISK;
+    return ERR_SUCCESS;
+}
+
+static const InitPhase_t _BoardInit_sdPhases[] = {
+    //Name      Function                 Deadline (us)
+    {"identify", &_BoardInit_sdIdentify,      0}  // Blocking, so deadline can't be enforced
+};
+
+#endif
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the board drivers
+HpsErr_t BoardInit_initialise(PBoardDrivers_t drivers, bool showTimeline) {
+    if (!drivers) return ERR_NULLPTR;
+    const InitChain_t chains[] = {
+        {"LT24" , ARRAYWITHSIZE(_BoardInit_lt24Phases) , drivers},
+        {"Audio", ARRAYWITHSIZE(_BoardInit_audioPhases), drivers},
+#ifdef DE1SOC_BOARDINIT_SDCARD
+        {"SD"   , ARRAYWITHSIZE(_BoardInit_sdPhases)   , drivers},
+#endif
+    };
+    return HPS_InitSched_run(chains, ARRAYSIZE(chains), showTimeline);
+}
@@ -0,0 +1,58 @@
+/*
+ * DE1-SoC Board Initialisation
+ * ----------------------------
+ * Description:
+ * Brings up the common DE1-SoC peripherals in parallel
+ * using the HPS_InitSched scheduler. The LT24 display,
+ * audio codec and (optionally) SD card are each run as
+ * an independent chain, so the 250ms LT24 power-up is
+ * overlapped with the I2C codec configuration and the
+ * SD card identification.
+ *
+ * Chains (see DE1SoC_BoardInit.c for the phase tables):
+ *
+ *   LT24  : setup -> reset sequence
+ *   Audio : I2C mux GPIO -> I2C -> codec setup -> codec config
+ *   SD    : card identification (if enabled)
+ *
+ * SD card initialisation is performed by FatFS disk_initialize(),
+ * which blocks during card identification, so runs as a single
+ * phase. It is only included if DE1SOC_BOARDINIT_SDCARD is
+ * globally defined, as FatFS must then be part of the project.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DE1SoC_BOARDINIT_H_
+#define DE1SoC_BOARDINIT_H_
+
+#include "HPS_GPIO/HPS_GPIO.h"
+#include "HPS_I2C/HPS_I2C.h"
+#include "DE1SoC_LT24/DE1SoC_LT24.h"
+#include "DE1SoC_WM8731/DE1SoC_WM8731.h"
+
+//Drivers initialised by the board
+typedef struct {
+    PHPSGPIOCtx_t gpio;  // ARM GPIO 1 (HPS LED/KEY and I2C mux)
+    PHPSI2CCtx_t i2c;    // General I2C (Audio/Accelerometer/VGA/ADC)
+    PWM8731Ctx_t audio;  // Audio codec
+    PLT24Ctx_t lt24;     // LT24 display
+} BoardDrivers_t, *PBoardDrivers_t;
+
+//Initialise the board drivers
+// - Runs all initialisation chains in parallel.
+// - If showTimeline is true, the per-phase timeline is printed once done.
+// - Returns ERR_SUCCESS if all drivers were initialised, otherwise the
+//   error of the first chain to fail. Drivers in chains which completed
+//   are still valid and can be checked with their *_isInitialised().
+HpsErr_t BoardInit_initialise(PBoardDrivers_t drivers, bool showTimeline);
+
+#endif /* DE1SoC_BOARDINIT_H_ */
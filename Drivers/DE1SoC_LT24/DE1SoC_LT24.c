@@ -11,6 +11,8 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 17/10/2026 | Split initialisation into non-blocking steps
+ * 17/10/2026 | Move register write to header for fast path APIs
  * 31/01/2024 | Update to new driver contexts
  * 20/10/2017 | Update driver to match new styles
  * 05/02/2017 | Creation of driver
@@ -26,24 +28,6 @@
 // Useful Defines
 //
 
-//PIO Bit Map
-#define LT24_WRn        (   1 << 16)
-#define LT24_RS         (   1 << 17)
-#define LT24_RDn        (   1 << 18)
-#define LT24_CSn        (   1 << 19)
-#define LT24_RESETn     (   1 << 20)
-#define LT24_LCD_ON     (   1 << 21)
-#define LT24_HW_OPT(en) ((en) << 23)
-#define LT24_CMDDATMASK (LT24_CSn | LT24_RDn | LT24_RS | LT24_WRn | 0x0000FFFF) //CMD and Data bits in PIO
-
-//LT24 Dedicated Address Offsets
-#define LT24_DEDCMD  (0x00/sizeof(unsigned short))
-#define LT24_DEDDATA (0x02/sizeof(unsigned short))
-
-//LT24 PIO Address Offsets
-#define LT24_PIO_DATA (0x00/sizeof(unsigned int))
-#define LT24_PIO_DIR  (0x04/sizeof(unsigned int))
-
 //Display Initialisation Data
 //You don't need to worry about what all these registers are.
 //The LT24 LCDs are complicated things with many settings that need
@@ -159,42 +143,6 @@ unsigned short LT24_initData [][2] = {
  * Internal Functions
  */
 
-//Function for writing to LT24 Registers
-static void _LT24_write( PLT24Ctx_t ctx, bool isData, unsigned short value ) {
-    if (ctx->hwOpt) {
-        // Use data interface in hwOpt mode
-        if (isData) {
-            ctx->data[LT24_DEDDATA] = value;
-        } else {
-            ctx->data[LT24_DEDCMD ] = value;
-        }
-    } else {
-        //PIO controls more than just LT24, so need to Read-Modify-Write
-        //First we have to output the value with the LT24_WRn bit low (first cycle of write)
-        //Read
-        unsigned int regVal = ctx->cntrl[LT24_PIO_DATA];
-        //Modify
-        //Mask all bits for command and data (sets them all to 0)
-        regVal = regVal & ~LT24_CMDDATMASK;
-        //Set the data bits (unsigned value, so cast pads MSBs with 0's)
-        regVal = regVal | ((unsigned int)value); 
-        if (isData) {
-            //For data we set the RS bit high.
-            regVal = regVal | (LT24_RS | LT24_RDn);
-        } else {
-            //For command we don't set the RS bit
-            regVal = regVal | (LT24_RDn);
-        }
-        //Write
-        ctx->cntrl[LT24_PIO_DATA] = regVal;
-        //Then we need to output the value again with LT24_WRn high (second cycle of write)
-        //Rest of regVal is unchanged, so we just or on the LT24_WRn bit
-        regVal = regVal | (LT24_WRn); 
-        //Write
-        ctx->cntrl[LT24_PIO_DATA] = regVal;
-    }
-}
-
 //Internal function to generate Red/Green corner of test pattern
 static HpsErr_t _LT24_redGreen( PLT24Ctx_t ctx, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height ) {
     HpsErr_t status;
@@ -309,6 +257,21 @@ static void _LT24_cleanup( PLT24Ctx_t ctx ) {
 //  - Returns Util/error Code
 //  - Returns context pointer to *ctx
 HpsErr_t LT24_initialise( void* cntrlBase, void* dataBase, PLT24Ctx_t* pCtx ) {
+    //Configure the PIO
+    HpsErr_t status = LT24_initialiseStart(cntrlBase, dataBase, pCtx);
+    if (IS_ERROR(status)) return status;
+    //Then run through the power-up sequence, waiting between each step
+    unsigned int delayUs;
+    while (IS_RETRY(status = LT24_initialiseContinue(pCtx, &delayUs))) {
+        usleep(delayUs);
+    }
+    return status;
+}
+
+//Function to start a non-blocking initialisation of the LCD
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t LT24_initialiseStart( void* cntrlBase, void* dataBase, PLT24Ctx_t* pCtx ) {
     //Ensure user pointers valid. dataBase can be NULL.
     if (!cntrlBase) return ERR_NULLPTR;
     if (!pointerIsAligned(cntrlBase, sizeof(unsigned int))) return ERR_ALIGNMENT;
@@ -321,6 +284,7 @@ HpsErr_t LT24_initialise( void* cntrlBase, void* dataBase, PLT24Ctx_t* pCtx ) {
     ctx->cntrl = (unsigned int*)cntrlBase;
     ctx->data  = (unsigned int*)dataBase;
     ctx->hwOpt = (dataBase != NULL); // Use HW Opt mode if we have a data pointer
+    ctx->initStep = 0;
     //Initialise LCD PIO direction
     ctx->cntrl[LT24_PIO_DIR] |= (LT24_CMDDATMASK | LT24_LCD_ON | LT24_RESETn | LT24_HW_OPT(1)); //All data/cmd bits are outputs
     //Initialise LCD data/control register.
@@ -328,31 +292,49 @@ HpsErr_t LT24_initialise( void* cntrlBase, void* dataBase, PLT24Ctx_t* pCtx ) {
     regVal &= ~(LT24_CMDDATMASK | LT24_LCD_ON | LT24_RESETn | LT24_HW_OPT(1)); //Mask all data/cmd bits
     regVal |=  (LT24_CSn | LT24_WRn | LT24_RDn | LT24_HW_OPT(ctx->hwOpt));     //Deselect Chip and set write and read signals to idle and set HW opt bit if enabled.
     ctx->cntrl[LT24_PIO_DATA] = regVal;
-    
+    return ERR_SUCCESS;
+}
+
+//Function to continue a non-blocking initialisation of the LCD
+//  - Returns ERR_AGAIN with *delayUs set if there are more steps
+//  - Returns ERR_SUCCESS once the LCD is initialised.
+HpsErr_t LT24_initialiseContinue( PLT24Ctx_t* pCtx, unsigned int* delayUs ) {
+    if (!pCtx || !delayUs) return ERR_NULLPTR;
+    PLT24Ctx_t ctx = *pCtx;
+    //Nothing to do if already initialised. Must have been started.
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (status != ERR_NOINIT) return status;
+    *delayUs = 0;
     //LCD requires specific reset sequence:
-    _LT24_powerConfig(ctx, true);  //turn on for 1ms
-    usleep(1000);
-    _LT24_powerConfig(ctx, false); //then off for 10ms
-    usleep(10000);
-    _LT24_powerConfig(ctx, true);  //finally back on and wait 120ms for LCD to power on
-    usleep(120000);
-    
-    //Upload Initialisation Data
-    for (unsigned int idx = 0; idx < LT24_INIT_DATA_LEN; idx++) {
-        _LT24_write(ctx, LT24_initData[idx][0], LT24_initData[idx][1]);
+    switch (ctx->initStep++) {
+        case 0:
+            _LT24_powerConfig(ctx, true);  //turn on for 1ms
+            *delayUs = 1000;
+            return ERR_AGAIN;
+        case 1:
+            _LT24_powerConfig(ctx, false); //then off for 10ms
+            *delayUs = 10000;
+            return ERR_AGAIN;
+        case 2:
+            _LT24_powerConfig(ctx, true);  //finally back on and wait 120ms for LCD to power on
+            *delayUs = 120000;
+            return ERR_AGAIN;
+        case 3:
+            //Upload Initialisation Data
+            for (unsigned int idx = 0; idx < LT24_INIT_DATA_LEN; idx++) {
+                _LT24_write(ctx, LT24_initData[idx][0], LT24_initData[idx][1]);
+            }
+            //Allow 120ms time for LCD to wake up
+            *delayUs = 120000;
+            return ERR_AGAIN;
+        default:
+            //Turn on display drivers
+            _LT24_write(ctx, false, 0x0029);
+            //Mark as initialised so later functions know we are ready
+            DriverContextSetInit(ctx);
+            //And clear the display
+            return LT24_clearDisplay(ctx, LT24_BLACK);
     }
-    
-    //Allow 120ms time for LCD to wake up
-    usleep(120000);
-    
-    //Turn on display drivers
-    _LT24_write(ctx, false, 0x0029);
-
-    //Mark as initialised so later functions know we are ready
-    DriverContextSetInit(ctx);
-    
-    //And clear the display
-    return LT24_clearDisplay(ctx, LT24_BLACK);
 }
 
 //Check if driver initialised
@@ -11,6 +11,8 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 17/10/2026 | Add non-blocking initialisation
+ * 17/10/2026 | Add validated handle fast path APIs
  * 31/01/2024 | Update to new driver contexts
  * 20/10/2017 | Update driver to match new styles
  * 05/02/2017 | Creation of driver
@@ -28,6 +30,24 @@
 #define LT24_INVALIDSIZE  ERR_BEYONDEND
 #define LT24_INVALIDSHAPE ERR_REVERSED
 
+//PIO Bit Map
+#define LT24_WRn        (   1 << 16)
+#define LT24_RS         (   1 << 17)
+#define LT24_RDn        (   1 << 18)
+#define LT24_CSn        (   1 << 19)
+#define LT24_RESETn     (   1 << 20)
+#define LT24_LCD_ON     (   1 << 21)
+#define LT24_HW_OPT(en) ((en) << 23)
+#define LT24_CMDDATMASK (LT24_CSn | LT24_RDn | LT24_RS | LT24_WRn | 0x0000FFFF) //CMD and Data bits in PIO
+
+//LT24 Dedicated Address Offsets
+#define LT24_DEDCMD  (0x00/sizeof(unsigned short))
+#define LT24_DEDDATA (0x02/sizeof(unsigned short))
+
+//LT24 PIO Address Offsets
+#define LT24_PIO_DATA (0x00/sizeof(unsigned int))
+#define LT24_PIO_DIR  (0x04/sizeof(unsigned int))
+
 //Size of the LCD
 #define LT24_WIDTH  240
 #define LT24_HEIGHT 320
@@ -52,6 +72,7 @@ typedef struct {
     volatile unsigned int* cntrl;
     volatile unsigned int* data;
     bool hwOpt;
+    unsigned int initStep;
 } LT24Ctx_t, *PLT24Ctx_t;
 
 //Function to initialise the LCD
@@ -59,6 +80,20 @@ typedef struct {
 //  - Returns context pointer to *ctx
 HpsErr_t LT24_initialise( void* cntrlBase, void* dataBase, PLT24Ctx_t* pCtx );
 
+//Function to start a non-blocking initialisation of the LCD
+//  - Configures the PIO and then returns without waiting for the LCD.
+//  - LT24_initialiseContinue() must then be called until it returns ERR_SUCCESS.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t LT24_initialiseStart( void* cntrlBase, void* dataBase, PLT24Ctx_t* pCtx );
+
+//Function to continue a non-blocking initialisation of the LCD
+//  - Performs the next step of the LCD power-up sequence.
+//  - Returns ERR_AGAIN if there are more steps. *delayUs is set to the time
+//    which must pass before this function is called again.
+//  - Returns ERR_SUCCESS once the LCD is initialised.
+HpsErr_t LT24_initialiseContinue( PLT24Ctx_t* pCtx, unsigned int* delayUs );
+
 //Check if driver initialised
 // - returns true if initialised
 bool LT24_isInitialised( PLT24Ctx_t ctx );
@@ -94,6 +129,52 @@ HpsErr_t LT24_copyFrameBuffer( PLT24Ctx_t ctx, const unsigned short* framebuffer
 // - returns ERR_SUCCESS if successful
 HpsErr_t LT24_drawPixel( PLT24Ctx_t ctx, unsigned short colour, unsigned int x, unsigned int y);
 
+/*
+ * Fast Path APIs
+ *
+ * Obtain a validated handle once using DriverContextGetHandle(ctx, &handle),
+ * then use the *Fast variants below in hot loops. These skip the context
+ * checks in release builds (see Util/driver_ctx.h).
+ */
+
+static inline HpsErr_t _LT24_write( PLT24Ctx_t ctx, bool isData, unsigned short value ) {
+    if (ctx->hwOpt) {
+        // Use data interface in hwOpt mode
+        if (isData) {
+            ctx->data[LT24_DEDDATA] = value;
+        } else {
+            ctx->data[LT24_DEDCMD ] = value;
+        }
+    } else {
+        //PIO controls more than just LT24, so need to Read-Modify-Write
+        //First we have to output the value with the LT24_WRn bit low (first cycle of write)
+        //Read
+        unsigned int regVal = ctx->cntrl[LT24_PIO_DATA];
+        //Modify
+        //Mask all bits for command and data (sets them all to 0)
+        regVal = regVal & ~LT24_CMDDATMASK;
+        //Set the data bits (unsigned value, so cast pads MSBs with 0's)
+        regVal = regVal | ((unsigned int)value); 
+        if (isData) {
+            //For data we set the RS bit high.
+            regVal = regVal | (LT24_RS | LT24_RDn);
+        } else {
+            //For command we don't set the RS bit
+            regVal = regVal | (LT24_RDn);
+        }
+        //Write
+        ctx->cntrl[LT24_PIO_DATA] = regVal;
+        //Then we need to output the value again with LT24_WRn high (second cycle of write)
+        //Rest of regVal is unchanged, so we just or on the LT24_WRn bit
+        regVal = regVal | (LT24_WRn); 
+        //Write
+        ctx->cntrl[LT24_PIO_DATA] = regVal;
+    }
+    return ERR_SUCCESS;
+}
+
+#define LT24_writeFast(handle, isData, value) DriverHandleCall(handle, _LT24_write, isData, value)
+
 #endif /*DE1SoC_LT24_H_*/
 
 /*
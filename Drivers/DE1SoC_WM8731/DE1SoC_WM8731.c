@@ -11,6 +11,9 @@
  *
  * Date       | Changes
  * -----------+-------------------------------
+ * 17/10/2026 | Bound the wait for the I2C bus in blocking initialisation
+ * 17/10/2026 | Split initialisation into non-blocking register writes
+ * 17/10/2026 | Share FIFO access with fast path APIs
  * 10/02/2024 | Add new API for FIFO access
  * 31/01/2024 | Update to new driver contexts
  * 20/10/2017 | Change to include status codes
@@ -21,23 +24,16 @@
 #include "DE1SoC_WM8731.h"
 #include "Util/bit_helpers.h"
 #include "Util/macros.h"
-
-//WM8731 ARM Address Offsets
-#define WM8731_CONTROL    (0x0/sizeof(unsigned int))
-#define WM8731_FIFOSPACE  (0x4/sizeof(unsigned int))
-#define WM8731_LEFTFIFO   (0x8/sizeof(unsigned int))
-#define WM8731_RIGHTFIFO  (0xC/sizeof(unsigned int))
+#include "HPS_usleep/HPS_usleep.h"
 
 //Bits
 #define WM8731_FIFO_RESET_ADC 2
 #define WM8731_FIFO_RESET_DAC 3
 
-//FIFO Offsets
-#define WM8731_FIFO_RARC 0
-#define WM8731_FIFO_RALC 8
-#define WM8731_FIFO_WSRC 16
-#define WM8731_FIFO_WSLC 24
-#define WM8731_FIFO_MASK 0xFF
+//Time to wait before checking an I2C write again, or retrying if the bus is busy
+#define WM8731_I2C_POLL_US 50
+//Limit on the total wait for the blocking initialisation (11 writes take ~4ms at 100kHz)
+#define WM8731_INIT_TIMEOUT_US 100000
 
 //I2C Register Address Offsets
 #define WM8731_I2C_LEFTINCNTRL   (0x00/sizeof(unsigned short))
@@ -51,6 +47,21 @@
 #define WM8731_I2C_SMPLINGCNTRL  (0x10/sizeof(unsigned short))
 #define WM8731_I2C_ACTIVECNTRL   (0x12/sizeof(unsigned short))
 
+//Codec initialisation sequence. See Page 46 of datasheet
+static const unsigned short _WM8731_initSequence[] = {
+    (WM8731_I2C_POWERCNTRL   <<9) | 0x12, //Power-up chip. Leave mic off as not used.
+    (WM8731_I2C_LEFTINCNTRL  <<9) | 0x17, //+4.5dB Volume. Unmute.
+    (WM8731_I2C_RIGHTINCNTRL <<9) | 0x17, //+4.5dB Volume. Unmute.
+    (WM8731_I2C_LEFTOUTCNTRL <<9) | 0x70, //-24dB Volume. Unmute.
+    (WM8731_I2C_RIGHTOUTCNTRL<<9) | 0x70, //-24dB Volume. Unmute.
+    (WM8731_I2C_ANLGPATHCNTRL<<9) | 0x12, //Use Line In. Disable Bypass. Use DAC
+    (WM8731_I2C_DGTLPATHCNTRL<<9) | 0x06, //Enable High-Pass filter. 48kHz sample rate.
+    (WM8731_I2C_DATAFMTCNTRL <<9) | 0x4E, //I2S Mode, 24bit, Master Mode (do not change this!)
+    (WM8731_I2C_SMPLINGCNTRL <<9) | 0x00, //Normal Mode, 48kHz sample rate
+    (WM8731_I2C_ACTIVECNTRL  <<9) | 0x01, //Enable Codec
+    (WM8731_I2C_POWERCNTRL   <<9) | 0x02  //Power-up output.
+};
+
 //Driver Cleanup
 void _WM8731_cleanup(PWM8731Ctx_t ctx ) {
     if (ctx->base) {
@@ -67,8 +78,25 @@ void _WM8731_cleanup(PWM8731Ctx_t ctx ) {
 // - base_address is memory-mapped address of audio controller
 // - returns 0 if successful
 HpsErr_t WM8731_initialise( void* base, PHPSI2CCtx_t i2c, PWM8731Ctx_t* pCtx ) {
+    //Allocate the context
+    HpsErr_t status = WM8731_initialiseStart(base, i2c, pCtx);
+    if (IS_ERROR(status)) return status;
+    //Then perform each register write in turn, giving up if the I2C bus stays busy
+    unsigned int delayUs;
+    unsigned int waitedUs = 0;
+    while (IS_RETRY(status = WM8731_initialiseContinue(pCtx, &delayUs))) {
+        if (waitedUs >= WM8731_INIT_TIMEOUT_US) return DriverContextInitFail(pCtx, ERR_TIMEOUT);
+        usleep(delayUs);
+        waitedUs += delayUs;
+    }
+    return status;
+}
+
+//Start a non-blocking initialisation of the Audio Codec
+// - returns 0 if successful
+HpsErr_t WM8731_initialiseStart( void* base, PHPSI2CCtx_t i2c, PWM8731Ctx_t* pCtx ) {
     //Ensure user pointers valid
-    if (!base) return ERR_NULLPTR;
+    if (!base || !i2c) return ERR_NULLPTR;
     if (!pointerIsAligned(base, sizeof(unsigned int))) return ERR_ALIGNMENT;
     //Allocate the driver context, validating return value.
     HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_WM8731_cleanup);
@@ -80,29 +108,50 @@ HpsErr_t WM8731_initialise( void* base, PHPSI2CCtx_t i2c, PWM8731Ctx_t* pCtx ) {
     ctx->i2cAddr = 0x1A;
     // - For the time being this is hard-coded to 48kHz, but could be changed later.
     ctx->sampleRate = 48000;
-    //Initialise the WM8731 codec over I2C. See Page 46 of datasheet
-    status = HPS_I2C_write16b(ctx->i2c, 0x1A, (WM8731_I2C_POWERCNTRL   <<9) | 0x12); //Power-up chip. Leave mic off as not used.
-    if (IS_ERROR(status)) return status;
-    status = HPS_I2C_write16b(ctx->i2c, 0x1A, (WM8731_I2C_LEFTINCNTRL  <<9) | 0x17); //+4.5dB Volume. Unmute.
-    if (IS_ERROR(status)) return status;
-    status = HPS_I2C_write16b(ctx->i2c, 0x1A, (WM8731_I2C_RIGHTINCNTRL <<9) | 0x17); //+4.5dB Volume. Unmute.
-    if (IS_ERROR(status)) return status;
-    status = HPS_I2C_write16b(ctx->i2c, 0x1A, (WM8731_I2C_LEFTOUTCNTRL <<9) | 0x70); //-24dB Volume. Unmute.
-    if (IS_ERROR(status)) return status;
-    status = HPS_I2C_write16b(ctx->i2c, 0x1A, (WM8731_I2C_RIGHTOUTCNTRL<<9) | 0x70); //-24dB Volume. Unmute.
-    if (IS_ERROR(status)) return status;
-    status = HPS_I2C_write16b(ctx->i2c, 0x1A, (WM8731_I2C_ANLGPATHCNTRL<<9) | 0x12); //Use Line In. Disable Bypass. Use DAC
-    if (IS_ERROR(status)) return status;
-    status = HPS_I2C_write16b(ctx->i2c, 0x1A, (WM8731_I2C_DGTLPATHCNTRL<<9) | 0x06); //Enable High-Pass filter. 48kHz sample rate.
-    if (IS_ERROR(status)) return status;
-    status = HPS_I2C_write16b(ctx->i2c, 0x1A, (WM8731_I2C_DATAFMTCNTRL <<9) | 0x4E); //I2S Mode, 24bit, Master Mode (do not change this!)
-    if (IS_ERROR(status)) return status;
-    status = HPS_I2C_write16b(ctx->i2c, 0x1A, (WM8731_I2C_SMPLINGCNTRL <<9) | 0x00); //Normal Mode, 48kHz sample rate
-    if (IS_ERROR(status)) return status;
-    status = HPS_I2C_write16b(ctx->i2c, 0x1A, (WM8731_I2C_ACTIVECNTRL  <<9) | 0x01); //Enable Codec
-    if (IS_ERROR(status)) return status;
-    status = HPS_I2C_write16b(ctx->i2c, 0x1A, (WM8731_I2C_POWERCNTRL   <<9) | 0x02); //Power-up output.
-    if (IS_ERROR(status)) return status;
+    ctx->initStep = 0;
+    ctx->initWriteQueued = false;
+    return ERR_SUCCESS;
+}
+
+//Continue a non-blocking initialisation of the Audio Codec
+// - Returns ERR_AGAIN if there are more writes to complete, with *delayUs
+//   set to the time to wait before calling again.
+// - Returns ERR_SUCCESS once the codec is initialised.
+HpsErr_t WM8731_initialiseContinue( PWM8731Ctx_t* pCtx, unsigned int* delayUs ) {
+    if (!pCtx || !delayUs) return ERR_NULLPTR;
+    PWM8731Ctx_t ctx = *pCtx;
+    //Nothing to do if already initialised. Must have been started.
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (status != ERR_NOINIT) return status;
+    *delayUs = 0;
+    //Check whether the last register write has completed
+    if (ctx->initWriteQueued) {
+        status = HPS_I2C_write(ctx->i2c, ctx->i2cAddr, NULL, 0);
+        if (IS_RETRY(status)) {
+            *delayUs = WM8731_I2C_POLL_US;
+            return ERR_AGAIN;
+        }
+        if (IS_ERROR_EXT(status)) return DriverContextInitFail(pCtx, status);
+        ctx->initWriteQueued = false;
+        ctx->initStep++;
+    }
+    //Queue the next register write
+    if (ctx->initStep < ARRAYSIZE(_WM8731_initSequence)) {
+        status = HPS_I2C_write16b(ctx->i2c, ctx->i2cAddr, _WM8731_initSequence[ctx->initStep]);
+        if (IS_BUSY(status)) {
+            //I2C in use by someone else, try again later.
+            *delayUs = WM8731_I2C_POLL_US;
+            return ERR_AGAIN;
+        }
+        if (IS_RETRY(status)) {
+            ctx->initWriteQueued = true;
+        } else if (IS_ERROR_EXT(status)) {
+            return DriverContextInitFail(pCtx, status);
+        } else {
+            ctx->initStep++; //Completed immediately
+        }
+        return ERR_AGAIN;
+    }
     //Initialised
     DriverContextSetInit(ctx);
     return WM8731_clearFIFO(ctx,true,true);
@@ -145,11 +194,8 @@ HpsErr_t WM8731_getFIFOSpace( PWM8731Ctx_t ctx, unsigned int* fifoSpace ) {
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (IS_ERROR(status)) return status;
-    //Get the FIFO fill register value
-    unsigned int fill = ctx->base[WM8731_FIFOSPACE];
-    //Space is the minimum space from either FIFO
-    *fifoSpace = min(MaskExtract(fill, WM8731_FIFO_MASK, WM8731_FIFO_WSRC), MaskExtract(fill, WM8731_FIFO_MASK, WM8731_FIFO_WSLC));
-    return ERR_SUCCESS;
+    //Get the FIFO space
+    return _WM8731_getFIFOSpace(ctx, fifoSpace);
 }
 
 //Get FIFO Fill (ADC)
@@ -158,11 +204,8 @@ HpsErr_t WM8731_getFIFOFill( PWM8731Ctx_t ctx, unsigned int* fifoFill ) {
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (IS_ERROR(status)) return status;
-    //Get the FIFO fill register value
-    unsigned int fill = ctx->base[WM8731_FIFOSPACE];
-    //Space is the minimum space from either FIFO
-    *fifoFill = min(MaskExtract(fill, WM8731_FIFO_MASK, WM8731_FIFO_RARC), MaskExtract(fill, WM8731_FIFO_MASK, WM8731_FIFO_RALC));
-    return ERR_SUCCESS;
+    //Get the FIFO fill
+    return _WM8731_getFIFOFill(ctx, fifoFill);
 }
 
 
@@ -173,9 +216,7 @@ HpsErr_t WM8731_writeSample( PWM8731Ctx_t ctx, unsigned int left, unsigned int r
     HpsErr_t status = DriverContextValidate(ctx);
     if (IS_ERROR(status)) return status;
 	//Write the sample
-    ctx->base[WM8731_LEFTFIFO] = left;
-    ctx->base[WM8731_RIGHTFIFO] = right;
-    return ERR_SUCCESS;
+    return _WM8731_writeSample(ctx, left, right);
 }
 
 //Read a sample from the FIFO for both channels
@@ -186,10 +227,7 @@ HpsErr_t WM8731_readSample( PWM8731Ctx_t ctx, unsigned int* left, unsigned int*
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (IS_ERROR(status)) return status;
-	//Write the sample
-    *left = ctx->base[WM8731_LEFTFIFO];
-    *right = ctx->base[WM8731_RIGHTFIFO];
-    return ERR_SUCCESS;
-
+	//Read the sample
+    return _WM8731_readSample(ctx, left, right);
 }
 
@@ -11,6 +11,8 @@
  *
  * Date       | Changes
  * -----------+-------------------------------
+ * 17/10/2026 | Add non-blocking initialisation
+ * 17/10/2026 | Add validated handle fast path APIs
  * 10/02/2024 | Add new API for FIFO access
  * 31/01/2024 | Update to new driver contexts
  * 20/10/2017 | Change to include status codes
@@ -24,8 +26,23 @@
 //Include required header files
 #include <stdint.h>
 #include "Util/driver_ctx.h"
+#include "Util/bit_helpers.h"
+#include "Util/macros.h"
 #include "HPS_I2C/HPS_I2C.h"
 
+//WM8731 ARM Address Offsets
+#define WM8731_CONTROL    (0x0/sizeof(unsigned int))
+#define WM8731_FIFOSPACE  (0x4/sizeof(unsigned int))
+#define WM8731_LEFTFIFO   (0x8/sizeof(unsigned int))
+#define WM8731_RIGHTFIFO  (0xC/sizeof(unsigned int))
+
+//FIFO Offsets
+#define WM8731_FIFO_RARC 0
+#define WM8731_FIFO_RALC 8
+#define WM8731_FIFO_WSRC 16
+#define WM8731_FIFO_WSLC 24
+#define WM8731_FIFO_MASK 0xFF
+
 // Driver context
 typedef struct {
     // Context Header
@@ -35,13 +52,34 @@ typedef struct {
     PHPSI2CCtx_t i2c; // I2C peripheral used by Audio Codec
     unsigned int i2cAddr;
     unsigned int sampleRate;
+    unsigned int initStep;
+    bool initWriteQueued;
 } WM8731Ctx_t, *PWM8731Ctx_t;
 
 //Initialise Audio Codec
 // - base_address is memory-mapped address of audio controller
+// - Waits for each I2C write in turn. If the I2C bus is held by another
+//   driver for more than 100ms, the context is freed and ERR_TIMEOUT returned.
 // - returns 0 if successful
 HpsErr_t WM8731_initialise( void* base, PHPSI2CCtx_t i2c, PWM8731Ctx_t* pCtx );
 
+//Start a non-blocking initialisation of the Audio Codec
+// - Allocates the context without performing any I2C writes.
+// - The I2C context does not need to be initialised until the first
+//   call to WM8731_initialiseContinue().
+// - returns 0 if successful
+HpsErr_t WM8731_initialiseStart( void* base, PHPSI2CCtx_t i2c, PWM8731Ctx_t* pCtx );
+
+//Continue a non-blocking initialisation of the Audio Codec
+// - Queues the next codec register write, or checks whether the last
+//   one has completed.
+// - Returns ERR_AGAIN if there are more writes to complete, with *delayUs
+//   set to the time to wait before calling again. This is also returned if
+//   the I2C bus is in use by another driver.
+// - Returns ERR_SUCCESS once the codec is initialised.
+// - If an I2C write fails, the context is freed and the error returned.
+HpsErr_t WM8731_initialiseContinue( PWM8731Ctx_t* pCtx, unsigned int* delayUs );
+
 //Check if driver initialised
 // - Returns true if driver previously initialised
 // - WM8731_initialise() must be called if false.
@@ -68,4 +106,46 @@ HpsErr_t WM8731_writeSample( PWM8731Ctx_t ctx, unsigned int left, unsigned int r
 // - You must check there is space in the FIFO before calling this function.
 HpsErr_t WM8731_readSample( PWM8731Ctx_t ctx, unsigned int* left, unsigned int* right);
 
+/*
+ * Fast Path APIs
+ *
+ * Obtain a validated handle once using DriverContextGetHandle(ctx, &handle),
+ * then use the *Fast variants below in hot loops. These skip the context
+ * checks in release builds (see Util/driver_ctx.h). Pointer arguments are
+ * not checked.
+ */
+
+static inline HpsErr_t _WM8731_getFIFOSpace( PWM8731Ctx_t ctx, unsigned int* fifoSpace ) {
+    //Get the FIFO fill register value
+    unsigned int fill = ctx->base[WM8731_FIFOSPACE];
+    //Space is the minimum space from either FIFO
+    *fifoSpace = min(MaskExtract(fill, WM8731_FIFO_MASK, WM8731_FIFO_WSRC), MaskExtract(fill, WM8731_FIFO_MASK, WM8731_FIFO_WSLC));
+    return ERR_SUCCESS;
+}
+
+static inline HpsErr_t _WM8731_getFIFOFill( PWM8731Ctx_t ctx, unsigned int* fifoFill ) {
+    //Get the FIFO fill register value
+    unsigned int fill = ctx->base[WM8731_FIFOSPACE];
+    //Fill is the minimum fill from either FIFO
+    *fifoFill = min(MaskExtract(fill, WM8731_FIFO_MASK, WM8731_FIFO_RARC), MaskExtract(fill, WM8731_FIFO_MASK, WM8731_FIFO_RALC));
+    return ERR_SUCCESS;
+}
+
+static inline HpsErr_t _WM8731_writeSample( PWM8731Ctx_t ctx, unsigned int left, unsigned int right ) {
+    ctx->base[WM8731_LEFTFIFO] = left;
+    ctx->base[WM8731_RIGHTFIFO] = right;
+    return ERR_SUCCESS;
+}
+
+static inline HpsErr_t _WM8731_readSample( PWM8731Ctx_t ctx, unsigned int* left, unsigned int* right ) {
+    *left = ctx->base[WM8731_LEFTFIFO];
+    *right = ctx->base[WM8731_RIGHTFIFO];
+    return ERR_SUCCESS;
+}
+
+#define WM8731_getFIFOSpaceFast(handle, fifoSpace) DriverHandleCall(handle, _WM8731_getFIFOSpace, fifoSpace)
+#define WM8731_getFIFOFillFast(handle, fifoFill)   DriverHandleCall(handle, _WM8731_getFIFOFill, fifoFill)
+#define WM8731_writeSampleFast(handle, left, right) DriverHandleCall(handle, _WM8731_writeSample, left, right)
+#define WM8731_readSampleFast(handle, left, right)  DriverHandleCall(handle, _WM8731_readSample, left, right)
+
 #endif /*DE1SoC_WM8731_H_*/
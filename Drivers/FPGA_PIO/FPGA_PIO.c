@@ -20,6 +20,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 17/10/2026 | Move output/input access to header for fast path APIs
  * 30/12/2023 | Creation of driver.
  *
  */
@@ -58,51 +59,6 @@ static HpsErr_t _FPGA_PIO_getDirection(PFPGAPIOCtx_t ctx, unsigned int* dir, uns
     return ERR_SUCCESS;
 }
 
-static HpsErr_t _FPGA_PIO_setOutput(PFPGAPIOCtx_t ctx, unsigned int port, unsigned int mask){
-    //Masking required
-    if (ctx->gpio.getOutput) {
-        // Can read output register, so do R-M-W
-        unsigned int curVal = ctx->csr->base.data;
-        ctx->csr->base.data = ((port & mask) | (curVal & ~mask));
-    } else {
-        //Configure output
-        if (mask == UINT32_MAX) {
-            //No masking required, just write port
-            ctx->csr->base.data = port;
-        } else {
-            // Can't read register. Can only do R-M-W if we have bitset support
-            if (!ctx->hasBitset) return ERR_NOSUPPORT;
-            // Clear zero bits and set one bits.
-            ctx->csr->outclear = (~port & mask);
-            ctx->csr->outset = (port & mask);
-        }
-    }
-    return ERR_SUCCESS;
-}
-
-static HpsErr_t _FPGA_PIO_toggleOutput(PFPGAPIOCtx_t ctx, unsigned int mask) {
-    //Toggle outputs
-    ctx->csr->base.data = (ctx->csr->base.data ^ mask);
-    return ERR_SUCCESS;
-}
-
-static HpsErr_t _FPGA_PIO_getOutput(PFPGAPIOCtx_t ctx, unsigned int* port, unsigned int mask) {
-    //Get output
-    *port = ctx->csr->base.data & mask;
-    return ERR_SUCCESS;
-}
-
-
-static HpsErr_t _FPGA_PIO_getInput(PFPGAPIOCtx_t ctx, unsigned int* in, unsigned int mask) {
-    //Get input
-    if (ctx->splitData) {
-        *in = ctx->csr->base.read & mask;
-    } else {
-        *in = ctx->csr->base.data & mask;
-    }
-    return ERR_SUCCESS;
-}
-
 static HpsErr_t _FPGA_PIO_setInterruptEnable(PFPGAPIOCtx_t ctx, unsigned int flags, unsigned int mask) {
     //Before changing anything we need to mask global interrupts temporarily
     HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
@@ -251,7 +207,7 @@ HpsErr_t FPGA_PIO_bitsetOutput(PFPGAPIOCtx_t ctx, unsigned int mask) {
     if (!ctx->hasBitset) return ERR_NOSUPPORT;
     if (!(ctx->pioType & FPGA_PIO_DIRECTION_OUT)) return ERR_NOSUPPORT;
     //Configure output
-    return ctx->csr->outset = mask;
+    return _FPGA_PIO_bitsetOutput(ctx, mask);
 }
 
 //Clear output bits
@@ -263,7 +219,7 @@ HpsErr_t FPGA_PIO_bitclearOutput(PFPGAPIOCtx_t ctx, unsigned int mask) {
     if (!ctx->hasBitset) return ERR_NOSUPPORT;
     if (!(ctx->pioType & FPGA_PIO_DIRECTION_OUT)) return ERR_NOSUPPORT;
     //Configure output
-    return ctx->csr->outclear = mask;
+    return _FPGA_PIO_bitclearOutput(ctx, mask);
 }
 
 //Toggle output value
@@ -20,6 +20,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 17/10/2026 | Add validated handle fast path APIs
  * 30/12/2023 | Creation of driver.
  *
  */
@@ -157,5 +158,76 @@ HpsErr_t FPGA_PIO_getInterruptFlags(PFPGAPIOCtx_t ctx, unsigned int* flags, unsi
 // - Only possible if has edge detector
 HpsErr_t FPGA_PIO_clearInterruptFlags(PFPGAPIOCtx_t ctx, unsigned int mask);
 
+/*
+ * Fast Path APIs
+ *
+ * Obtain a validated handle once using DriverContextGetHandle(ctx, &handle),
+ * then use the *Fast variants below in hot loops. These skip the context
+ * checks in release builds (see Util/driver_ctx.h). The capability checks
+ * made by the checked APIs (e.g. whether the PIO has outputs or bit-set
+ * support) are also skipped, so only use on a PIO known to support them.
+ */
+
+static inline HpsErr_t _FPGA_PIO_setOutput(PFPGAPIOCtx_t ctx, unsigned int port, unsigned int mask){
+    //Masking required
+    if (ctx->gpio.getOutput) {
+        // Can read output register, so do R-M-W
+        unsigned int curVal = ctx->csr->base.data;
+        ctx->csr->base.data = ((port & mask) | (curVal & ~mask));
+    } else {
+        //Configure output
+        if (mask == UINT32_MAX) {
+            //No masking required, just write port
+            ctx->csr->base.data = port;
+        } else {
+            // Can't read register. Can only do R-M-W if we have bitset support
+            if (!ctx->hasBitset) return ERR_NOSUPPORT;
+            // Clear zero bits and set one bits.
+            ctx->csr->outclear = (~port & mask);
+            ctx->csr->outset = (port & mask);
+        }
+    }
+    return ERR_SUCCESS;
+}
+
+static inline HpsErr_t _FPGA_PIO_toggleOutput(PFPGAPIOCtx_t ctx, unsigned int mask) {
+    //Toggle outputs
+    ctx->csr->base.data = (ctx->csr->base.data ^ mask);
+    return ERR_SUCCESS;
+}
+
+static inline HpsErr_t _FPGA_PIO_getOutput(PFPGAPIOCtx_t ctx, unsigned int* port, unsigned int mask) {
+    //Get output
+    *port = ctx->csr->base.data & mask;
+    return ERR_SUCCESS;
+}
+
+static inline HpsErr_t _FPGA_PIO_getInput(PFPGAPIOCtx_t ctx, unsigned int* in, unsigned int mask) {
+    //Get input
+    if (ctx->splitData) {
+        *in = ctx->csr->base.read & mask;
+    } else {
+        *in = ctx->csr->base.data & mask;
+    }
+    return ERR_SUCCESS;
+}
+
+static inline HpsErr_t _FPGA_PIO_bitsetOutput(PFPGAPIOCtx_t ctx, unsigned int mask) {
+    ctx->csr->outset = mask;
+    return ERR_SUCCESS;
+}
+
+static inline HpsErr_t _FPGA_PIO_bitclearOutput(PFPGAPIOCtx_t ctx, unsigned int mask) {
+    ctx->csr->outclear = mask;
+    return ERR_SUCCESS;
+}
+
+#define FPGA_PIO_setOutputFast(handle, port, mask) DriverHandleCall(handle, _FPGA_PIO_setOutput, port, mask)
+#define FPGA_PIO_bitsetOutputFast(handle, mask)    DriverHandleCall(handle, _FPGA_PIO_bitsetOutput, mask)
+#define FPGA_PIO_bitclearOutputFast(handle, mask)  DriverHandleCall(handle, _FPGA_PIO_bitclearOutput, mask)
+#define FPGA_PIO_toggleOutputFast(handle, mask)    DriverHandleCall(handle, _FPGA_PIO_toggleOutput, mask)
+#define FPGA_PIO_getOutputFast(handle, port, mask) DriverHandleCall(handle, _FPGA_PIO_getOutput, port, mask)
+#define FPGA_PIO_getInputFast(handle, in, mask)    DriverHandleCall(handle, _FPGA_PIO_getInput, in, mask)
+
 #endif /* FPGA_PIO_H_ */
 
@@ -0,0 +1,160 @@
+/*-----------------------------------------------------------------------*/
+/* Low level disk I/O dispatch                     (C)T Carpenter, 2026  */
+/*-----------------------------------------------------------------------*/
+/* Passes each FatFs disk_xxx call on to the disk driver registered for  */
+/* the physical drive, so that different media (SD card, flash, RAM)    */
+/* can be mounted as separate volumes.                                   */
+/*-----------------------------------------------------------------------*/
+
+#include <stddef.h>
+
+#include "ff.h"
+#include "diskio.h"
+
+#if FF_MULTI_PARTITION
+// Default volume to drive mapping. Volume N is the first FAT volume on
+// physical drive N. Can be overridden by the application.
+PARTITION VolToPart[FF_VOLUMES] __attribute__((weak)) = {
+    {0, 0},
+#if FF_VOLUMES > 1
+    {1, 0},
+#endif
+#if FF_VOLUMES > 2
+    {2, 0},
+#endif
+#if FF_VOLUMES > 3
+    {3, 0},
+#endif
+#if FF_VOLUMES > 4
+#error "Add default VolToPart entries for the extra volumes"
+#endif
+};
+#endif
+
+/*-----------------------------------------------------------------------*/
+/* Global Variables                                                      */
+/*-----------------------------------------------------------------------*/
+
+// Registered disk drivers
+static struct {
+    const DISKIO_DRIVER* drv;
+    void* param;
+} Disk_Drivers[FF_VOLUMES] = {
+#ifndef FF_DISKIO_NO_SDMMC
+    {&DiskIo_SDMMC, NULL}
+#endif
+};
+
+// Get the driver for a physical drive, or NULL if none
+static inline const DISKIO_DRIVER* disk_driver (BYTE pdrv)
+{
+    if (pdrv >= FF_VOLUMES) {
+        return NULL;
+    }
+    return Disk_Drivers[pdrv].drv;
+}
+
+/*-----------------------------------------------------------------------*/
+/* Register a Drive                                                      */
+/*-----------------------------------------------------------------------*/
+
+DRESULT disk_register (
+    BYTE pdrv,                  /* Physical drive number */
+    const DISKIO_DRIVER* drv,   /* Driver, or NULL to remove */
+    void* param                 /* Parameter passed to the driver */
+)
+{
+    if (pdrv >= FF_VOLUMES) {
+        return RES_PARERR;
+    }
+    if (drv && (!drv->initialize || !drv->status || !drv->read || !drv->ioctl)) {
+        return RES_PARERR; //Mandatory functions missing.
+    }
+    Disk_Drivers[pdrv].drv = drv;
+    Disk_Drivers[pdrv].param = param;
+    return RES_OK;
+}
+
+/*-----------------------------------------------------------------------*/
+/* Dispatch                                                              */
+/*-----------------------------------------------------------------------*/
+
+DSTATUS disk_status (
+    BYTE pdrv       /* Physical drive number to identify the drive */
+)
+{
+    const DISKIO_DRIVER* drv = disk_driver(pdrv);
+    if (!drv) {
+        return STA_NOINIT | STA_NODISK;
+    }
+    return drv->status(Disk_Drivers[pdrv].param);
+}
+
+DSTATUS disk_initialize (
+    BYTE pdrv       /* Physical drive number to identify the drive */
+)
+{
+    const DISKIO_DRIVER* drv = disk_driver(pdrv);
+    if (!drv) {
+        return STA_NOINIT | STA_NODISK;
+    }
+    return drv->initialize(Disk_Drivers[pdrv].param);
+}
+
+DRESULT disk_read (
+    BYTE pdrv,      /* Physical drive number to identify the drive */
+    BYTE *buff,     /* Data buffer to store read data */
+    DWORD sector,   /* Start sector in LBA */
+    UINT count      /* Number of sectors to read */
+)
+{
+    const DISKIO_DRIVER* drv = disk_driver(pdrv);
+    if (!drv) {
+        return RES_PARERR;
+    }
+    return drv->read(Disk_Drivers[pdrv].param, buff, sector, count);
+}
+
+DRESULT disk_write (
+    BYTE pdrv,          /* Physical drive number to identify the drive */
+    const BYTE *buff,   /* Data to be written */
+    DWORD sector,       /* Start sector in LBA */
+    UINT count          /* Number of sectors to write */
+)
+{
+    const DISKIO_DRIVER* drv = disk_driver(pdrv);
+    if (!drv) {
+        return RES_PARERR;
+    }
+    if (!drv->write) {
+        return RES_WRPRT; //Read-only driver.
+    }
+    return drv->write(Disk_Drivers[pdrv].param, buff, sector, count);
+}
+
+DRESULT disk_verify (
+    BYTE pdrv,          /* Physical drive number to identify the drive */
+    const BYTE *buff,   /* Data buffer that was written */
+    DWORD sector,       /* Start sector in LBA */
+    UINT count          /* Number of sectors to verify */
+)
+{
+    const DISKIO_DRIVER* drv = disk_driver(pdrv);
+    if (!drv || !drv->verify) {
+        return RES_PARERR;
+    }
+    return drv->verify(Disk_Drivers[pdrv].param, buff, sector, count);
+}
+
+DRESULT disk_ioctl (
+    BYTE pdrv,      /* Physical drive number (0..) */
+    BYTE cmd,       /* Control code */
+    void *buff      /* Buffer to send/receive control data */
+)
+{
+    const DISKIO_DRIVER* drv = disk_driver(pdrv);
+    if (!drv) {
+        return RES_PARERR;
+    }
+    return drv->ioctl(Disk_Drivers[pdrv].param, cmd, buff);
+}
@@ -37,6 +37,35 @@ DRESULT disk_verify (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count);
 DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff);
 
 
+/*---------------------------------------*/
+/* Disk driver dispatch                  */
+/*---------------------------------------*/
+/* Each physical drive is handled by a disk driver. The
+/  disk_xxx functions above pass the call on to the driver
+/  registered for the drive, along with its param value.
+/  Physical drive 0 is the SD card by default. */
+
+typedef struct {
+	DSTATUS (*initialize)(void* param);
+	DSTATUS (*status)(void* param);
+	DRESULT (*read)(void* param, BYTE* buff, DWORD sector, UINT count);
+	DRESULT (*write)(void* param, const BYTE* buff, DWORD sector, UINT count);
+	DRESULT (*verify)(void* param, const BYTE* buff, DWORD sector, UINT count);	/* Optional */
+	DRESULT (*ioctl)(void* param, BYTE cmd, void* buff);
+} DISKIO_DRIVER;
+
+/* Register a driver for a physical drive (0 to FF_VOLUMES-1)
+/  - A NULL driver removes the drive.
+/  - The drive must be initialised with disk_initialize() (or
+/    by f_mount()) once registered. */
+DRESULT disk_register (BYTE pdrv, const DISKIO_DRIVER* drv, void* param);
+
+/* SD/MMC card driver (diskio_socfpga.c) */
+#ifndef FF_DISKIO_NO_SDMMC
+extern const DISKIO_DRIVER DiskIo_SDMMC;
+#endif
+
+
 /* Disk Status Bits (DSTATUS) */
 
 #define STA_NOINIT		0x01	/* Drive not initialized */
@@ -0,0 +1,375 @@
+/*
+ * FatFS Sector Cache
+ * ------------------
+ *
+ * Write-back sector cache which sits between FatFS and
+ * another disk driver.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#include "diskio_cache.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Util/mem_fast.h"
+
+#define DISKCACHE_NONE 0xFFFFFFFFU
+
+/*
+ * Internal Functions
+ */
+
+//Convert driver status to disk result
+static DRESULT _DiskCache_result(HpsErr_t status) {
+    switch (status) {
+        case ERR_SUCCESS:   return RES_OK;
+        case ERR_NOINIT:    return RES_NOTRDY;
+        case ERR_WRITEPROT: return RES_WRPRT;
+        case ERR_NULLPTR:
+        case ERR_BEYONDEND: return RES_PARERR;
+        default:            return RES_ERROR;
+    }
+}
+
+//Convert disk result to driver status
+static HpsErr_t _DiskCache_status(DRESULT res) {
+    switch (res) {
+        case RES_OK:     return ERR_SUCCESS;
+        case RES_NOTRDY: return ERR_NOINIT;
+        case RES_WRPRT:  return ERR_WRITEPROT;
+        case RES_PARERR: return ERR_BEYONDEND;
+        default:         return ERR_IOFAIL;
+    }
+}
+
+static uint32_t _DiskCache_load16(const uint8_t* data) {
+    return data[0] | (data[1] << 8);
+}
+
+static uint32_t _DiskCache_load32(const uint8_t* data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+//Pin the FAT if the sector is the boot sector of a FAT volume
+static void _DiskCache_checkBootSector(PDiskCacheCtx_t ctx, DWORD sector, const uint8_t* data) {
+    if ((data[510] != 0x55) || (data[511] != 0xAA)) return;
+    if (!memcmp(data + 3, "EXFAT   ", 8)) {
+        //exFAT. FatOffset, FatLength and NumberOfFats
+        ctx->pinStart = sector + _DiskCache_load32(data + 80);
+        ctx->pinCount = _DiskCache_load32(data + 84) * data[110];
+        return;
+    }
+    //FAT12/16/32. Reject anything else with a boot signature, such as an MBR.
+    if ((data[0] != 0xEB) && (data[0] != 0xE9)) return;
+    if (_DiskCache_load16(data + 11) != DISKCACHE_SECTOR_SIZE) return;
+    if (!data[13] || (data[13] & (data[13] - 1))) return;
+    uint32_t reserved = _DiskCache_load16(data + 14);
+    uint32_t fats = data[16];
+    uint32_t fatSize = _DiskCache_load16(data + 22);
+    if (!fatSize) fatSize = _DiskCache_load32(data + 36);
+    if (!reserved || !fats || (fats > 2) || !fatSize) return;
+    ctx->pinStart = sector + reserved;
+    ctx->pinCount = fats * fatSize;
+}
+
+static bool _DiskCache_isPinned(PDiskCacheCtx_t ctx, DWORD sector) {
+    return (sector >= ctx->pinStart) && (sector - ctx->pinStart < ctx->pinCount);
+}
+
+//Find the cache line for a sector, or NULL if not cached
+static DiskCacheLine_t* _DiskCache_find(PDiskCacheCtx_t ctx, DWORD sector) {
+    DiskCacheLine_t* line = &ctx->lines[(sector % ctx->sets) * ctx->ways];
+    for (unsigned int way = 0; way < ctx->ways; way++, line++) {
+        if (line->sector == sector) return line;
+    }
+    return NULL;
+}
+
+//Write a cached sector back to disk
+static HpsErr_t _DiskCache_writeBack(PDiskCacheCtx_t ctx, DiskCacheLine_t* line) {
+    if (!line->dirty) return ERR_SUCCESS;
+    DRESULT res = ctx->drv->write(ctx->param, line->data, line->sector, 1);
+    if (res != RES_OK) return _DiskCache_status(res);
+    line->dirty = false;
+    ctx->stats.writeBacks++;
+    return ERR_SUCCESS;
+}
+
+//Get a cache line for a sector, evicting the least recently used
+// - If load is true, the sector contents are read from disk.
+static HpsErr_t _DiskCache_fetch(PDiskCacheCtx_t ctx, DWORD sector, bool load, DiskCacheLine_t** pLine) {
+    DiskCacheLine_t* line = _DiskCache_find(ctx, sector);
+    if (line) {
+        ctx->stats.hits++;
+    } else {
+        //Replace unused lines first, then the least recently used, keeping pinned
+        //lines unless the whole set is pinned.
+        DiskCacheLine_t* set = &ctx->lines[(sector % ctx->sets) * ctx->ways];
+        DiskCacheLine_t* pinned = NULL;
+        for (unsigned int way = 0; way < ctx->ways; way++) {
+            DiskCacheLine_t* cur = &set[way];
+            if (cur->sector == DISKCACHE_NONE) {
+                line = cur;
+                break;
+            }
+            if (_DiskCache_isPinned(ctx, cur->sector)) {
+                if (!pinned || (cur->lastUse < pinned->lastUse)) pinned = cur;
+            } else if (!line || (cur->lastUse < line->lastUse)) {
+                line = cur;
+            }
+        }
+        if (!line) line = pinned;
+        HpsErr_t status = _DiskCache_writeBack(ctx, line);
+        if (IS_ERROR(status)) return status;
+        line->sector = DISKCACHE_NONE;
+        if (load) {
+            DRESULT res = ctx->drv->read(ctx->param, line->data, sector, 1);
+            if (res != RES_OK) return _DiskCache_status(res);
+            ctx->stats.misses++;
+        }
+        line->sector = sector;
+    }
+    line->lastUse = ++ctx->useCount;
+    *pLine = line;
+    return ERR_SUCCESS;
+}
+
+//Drop all cached sectors without writing them back
+static void _DiskCache_invalidate(PDiskCacheCtx_t ctx) {
+    for (unsigned int idx = 0; idx < ctx->sets * ctx->ways; idx++) {
+        ctx->lines[idx].sector = DISKCACHE_NONE;
+        ctx->lines[idx].dirty = false;
+    }
+}
+
+static void _DiskCache_cleanup(PDiskCacheCtx_t ctx) {
+    if (ctx->lines) {
+        //Write back any changes
+        if (ctx->header.initialised) DiskCache_flush(ctx);
+        free(ctx->lines);
+    }
+    free(ctx->data);
+}
+
+/*
+ * Disk Driver
+ */
+
+static DSTATUS _DiskCache_diskStatus(void* param) {
+    PDiskCacheCtx_t ctx = (PDiskCacheCtx_t)param;
+    if (!DiskCache_isInitialised(ctx)) return STA_NOINIT;
+    return ctx->drv->status(ctx->param);
+}
+
+static DSTATUS _DiskCache_initialize(void* param) {
+    PDiskCacheCtx_t ctx = (PDiskCacheCtx_t)param;
+    if (!DiskCache_isInitialised(ctx)) return STA_NOINIT;
+    //If the disk was not already running (e.g. card changed), the cache is stale
+    if (ctx->drv->status(ctx->param) & STA_NOINIT) {
+        _DiskCache_invalidate(ctx);
+        ctx->pinCount = 0;
+    }
+    DSTATUS stat = ctx->drv->initialize(ctx->param);
+    if (stat & STA_NOINIT) return stat;
+    //Cache lines are a fixed size
+    WORD sectorSize = DISKCACHE_SECTOR_SIZE;
+    if (ctx->drv->ioctl(ctx->param, GET_SECTOR_SIZE, &sectorSize) != RES_OK) sectorSize = DISKCACHE_SECTOR_SIZE;
+    if (sectorSize != DISKCACHE_SECTOR_SIZE) return stat | STA_NOINIT;
+    return stat;
+}
+
+static DRESULT _DiskCache_read(void* param, BYTE* buff, DWORD sector, UINT count) {
+    PDiskCacheCtx_t ctx = (PDiskCacheCtx_t)param;
+    if (!buff) return RES_PARERR;
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return _DiskCache_result(status);
+    if (count > DISKCACHE_BYPASS_SECTORS) {
+        //Read directly, then replace any sectors which have changed in the cache
+        DRESULT res = ctx->drv->read(ctx->param, buff, sector, count);
+        if (res != RES_OK) return res;
+        ctx->stats.bypassed += count;
+        for (UINT idx = 0; idx < count; idx++) {
+            DiskCacheLine_t* line = _DiskCache_find(ctx, sector + idx);
+            if (line && line->dirty) MemFast_copy(buff + idx * DISKCACHE_SECTOR_SIZE, line->data, DISKCACHE_SECTOR_SIZE);
+        }
+        return RES_OK;
+    }
+    while (count--) {
+        DiskCacheLine_t* line;
+        status = _DiskCache_fetch(ctx, sector, true, &line);
+        if (IS_ERROR(status)) return _DiskCache_result(status);
+        //FatFS reads the boot sector when mounting
+        _DiskCache_checkBootSector(ctx, sector++, line->data);
+        MemFast_copy(buff, line->data, DISKCACHE_SECTOR_SIZE);
+        buff += DISKCACHE_SECTOR_SIZE;
+    }
+    return RES_OK;
+}
+
+static DRESULT _DiskCache_write(void* param, const BYTE* buff, DWORD sector, UINT count) {
+    PDiskCacheCtx_t ctx = (PDiskCacheCtx_t)param;
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return _DiskCache_result(status);
+    if (!ctx->drv->write) return RES_WRPRT;
+    if (count > DISKCACHE_BYPASS_SECTORS) {
+        //Write directly, then bring any cached copies up to date
+        DRESULT res = ctx->drv->write(ctx->param, buff, sector, count);
+        if (res != RES_OK) return res;
+        ctx->stats.bypassed += count;
+        for (UINT idx = 0; idx < count; idx++) {
+            DiskCacheLine_t* line = _DiskCache_find(ctx, sector + idx);
+            if (!line) continue;
+            if (buff) {
+                MemFast_copy(line->data, buff + idx * DISKCACHE_SECTOR_SIZE, DISKCACHE_SECTOR_SIZE);
+            } else {
+                MemFast_set(line->data, 0, DISKCACHE_SECTOR_SIZE);
+            }
+            line->dirty = false;
+        }
+        return RES_OK;
+    }
+    //Check protection now, as the write to disk is deferred
+    if (ctx->drv->status(ctx->param) & STA_PROTECT) return RES_WRPRT;
+    while (count--) {
+        //Whole sector is replaced, so no need to load it
+        DiskCacheLine_t* line;
+        status = _DiskCache_fetch(ctx, sector++, false, &line);
+        if (IS_ERROR(status)) return _DiskCache_result(status);
+        if (buff) {
+            MemFast_copy(line->data, buff, DISKCACHE_SECTOR_SIZE);
+            buff += DISKCACHE_SECTOR_SIZE;
+        } else {
+            MemFast_set(line->data, 0, DISKCACHE_SECTOR_SIZE);
+        }
+        line->dirty = true;
+    }
+    return RES_OK;
+}
+
+static DRESULT _DiskCache_verify(void* param, const BYTE* buff, DWORD sector, UINT count) {
+    PDiskCacheCtx_t ctx = (PDiskCacheCtx_t)param;
+    //Make sure the disk is up to date, then verify the disk itself
+    HpsErr_t status = DiskCache_flush(ctx);
+    if (IS_ERROR(status)) return _DiskCache_result(status);
+    if (!ctx->drv->verify) return RES_PARERR;
+    return ctx->drv->verify(ctx->param, buff, sector, count);
+}
+
+static DRESULT _DiskCache_ioctl(void* param, BYTE cmd, void* buff) {
+    PDiskCacheCtx_t ctx = (PDiskCacheCtx_t)param;
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return _DiskCache_result(status);
+    switch (cmd) {
+        case CTRL_SYNC:
+            status = DiskCache_flush(ctx);
+            if (IS_ERROR(status)) return _DiskCache_result(status);
+            break;
+        case CTRL_TRIM:
+            //Trimmed sectors no longer need writing back. The range may be far larger
+            //than the cache, so check each line once rather than each sector.
+            for (unsigned int idx = 0; idx < ctx->sets * ctx->ways; idx++) {
+                DiskCacheLine_t* line = &ctx->lines[idx];
+                if ((line->sector >= ((DWORD*)buff)[0]) && (line->sector <= ((DWORD*)buff)[1])) {
+                    line->sector = DISKCACHE_NONE;
+                    line->dirty = false;
+                }
+            }
+            break;
+    }
+    return ctx->drv->ioctl(ctx->param, cmd, buff);
+}
+
+const DISKIO_DRIVER DiskIo_Cache = {
+    .initialize = &_DiskCache_initialize,
+    .status     = &_DiskCache_diskStatus,
+    .read       = &_DiskCache_read,
+    .write      = &_DiskCache_write,
+    .verify     = &_DiskCache_verify,
+    .ioctl      = &_DiskCache_ioctl
+};
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the sector cache
+// - drv and param are the disk driver to cache, as would be passed to disk_register().
+// - The cache holds sets*ways sectors.
+HpsErr_t DiskCache_initialise(const DISKIO_DRIVER* drv, void* param, unsigned int sets, unsigned int ways, PDiskCacheCtx_t* pCtx) {
+    //Ensure user pointers valid
+    if (!drv) return ERR_NULLPTR;
+    if (!drv->initialize || !drv->status || !drv->read || !drv->ioctl) return ERR_NOSUPPORT;
+    if (!sets || !ways) return ERR_TOOSMALL;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_DiskCache_cleanup);
+    if (IS_ERROR(status)) return status;
+    PDiskCacheCtx_t ctx = *pCtx;
+    ctx->drv = drv;
+    ctx->param = param;
+    //Allocate the cache
+    ctx->data = malloc(sets * ways * DISKCACHE_SECTOR_SIZE);
+    if (!ctx->data) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    ctx->lines = calloc(sets * ways, sizeof(DiskCacheLine_t));
+    if (!ctx->lines) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    ctx->sets = sets;
+    ctx->ways = ways;
+    for (unsigned int idx = 0; idx < sets * ways; idx++) {
+        ctx->lines[idx].sector = DISKCACHE_NONE;
+        ctx->lines[idx].data = ctx->data + idx * DISKCACHE_SECTOR_SIZE;
+    }
+    //And initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+// - Returns true if driver previously initialised
+bool DiskCache_isInitialised(PDiskCacheCtx_t ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Write all changed sectors back to disk
+HpsErr_t DiskCache_flush(PDiskCacheCtx_t ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    for (unsigned int idx = 0; idx < ctx->sets * ctx->ways; idx++) {
+        status = _DiskCache_writeBack(ctx, &ctx->lines[idx]);
+        if (IS_ERROR(status)) return status;
+    }
+    return ERR_SUCCESS;
+}
+
+//Pin a range of sectors
+// - Pinned sectors are kept in preference to others.
+// - Replaces any range found automatically from the boot sector. A count of 0 unpins.
+HpsErr_t DiskCache_pin(PDiskCacheCtx_t ctx, DWORD sector, DWORD count) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    ctx->pinStart = sector;
+    ctx->pinCount = count;
+    return ERR_SUCCESS;
+}
+
+//Get cache statistics
+// - If reset is true, the statistics are cleared after reading.
+HpsErr_t DiskCache_getStats(PDiskCacheCtx_t ctx, DiskCacheStats_t* stats, bool reset) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    if (!stats) return ERR_NULLPTR;
+    *stats = ctx->stats;
+    if (reset) memset(&ctx->stats, 0, sizeof(ctx->stats));
+    return ERR_SUCCESS;
+}
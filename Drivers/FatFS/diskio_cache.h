@@ -0,0 +1,116 @@
+/*
+ * FatFS Sector Cache
+ * ------------------
+ *
+ * Write-back sector cache which sits between FatFS and
+ * another disk driver, such as the SD card. FatFS only
+ * keeps one sector window per volume and per file, so
+ * the FAT and directory sectors are otherwise read from
+ * the card again and again when creating files or
+ * appending to them.
+ *
+ * The cache is set associative, with sets*ways sectors.
+ * Sector n can be held in any of the ways of set n%sets,
+ * with the least recently used way replaced on a miss.
+ * Writes are held in the cache until the line is evicted,
+ * or FatFS syncs the volume (f_sync/f_close/f_unmount).
+ *
+ * Sectors in the FAT are pinned, so are only evicted if
+ * all ways of a set are pinned. The FAT is found when the
+ * volume boot sector is read on mount, or can be set with
+ * DiskCache_pin(). Transfers of more than
+ * DISKCACHE_BYPASS_SECTORS (normally file data) bypass
+ * the cache, updating any cached copies.
+ *
+ *    PDiskCacheCtx_t cache;
+ *    DiskCache_initialise(&DiskIo_SDMMC, NULL, 64, 4, &cache);
+ *    disk_register(0, &DiskIo_Cache, cache);
+ *    f_mount(&fs, "0:", 1);
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DISKIO_CACHE_H_
+#define DISKIO_CACHE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/driver_ctx.h"
+
+#include "diskio.h"
+
+//Sector size of the underlying disk
+#define DISKCACHE_SECTOR_SIZE 512
+
+//Largest transfer which goes through the cache
+#ifndef DISKCACHE_BYPASS_SECTORS
+#define DISKCACHE_BYPASS_SECTORS 4
+#endif
+
+//Cached sector
+typedef struct {
+    DWORD sector;             // Sector number, or DISKCACHE_NONE if unused
+    uint32_t lastUse;         // For least recently used replacement
+    bool dirty;               // Has changes not yet written to disk
+    uint8_t* data;
+} DiskCacheLine_t;
+
+//Cache statistics
+typedef struct {
+    uint32_t hits;            // Sectors found in the cache
+    uint32_t misses;          // Sectors read from disk into the cache
+    uint32_t writeBacks;      // Dirty sectors written to disk
+    uint32_t bypassed;        // Sectors transferred directly
+} DiskCacheStats_t;
+
+//Driver context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    const DISKIO_DRIVER* drv;  // Underlying disk
+    void* param;
+    unsigned int sets;
+    unsigned int ways;
+    DiskCacheLine_t* lines;    // Ways of each set are adjacent
+    uint8_t* data;
+    uint32_t useCount;
+    DWORD pinStart;            // Range of pinned sectors
+    DWORD pinCount;
+    DiskCacheStats_t stats;
+} DiskCacheCtx_t, *PDiskCacheCtx_t;
+
+//Disk driver for disk_register()
+extern const DISKIO_DRIVER DiskIo_Cache;     // param is PDiskCacheCtx_t
+
+//Initialise the sector cache
+// - drv and param are the disk driver to cache, as would be passed to disk_register().
+// - The cache holds sets*ways sectors.
+HpsErr_t DiskCache_initialise(const DISKIO_DRIVER* drv, void* param, unsigned int sets, unsigned int ways, PDiskCacheCtx_t* pCtx);
+
+//Check if driver initialised
+// - Returns true if driver previously initialised
+bool DiskCache_isInitialised(PDiskCacheCtx_t ctx);
+
+//Write all changed sectors back to disk
+HpsErr_t DiskCache_flush(PDiskCacheCtx_t ctx);
+
+//Pin a range of sectors
+// - Pinned sectors are kept in preference to others.
+// - Replaces any range found automatically from the boot sector. A count of 0 unpins.
+HpsErr_t DiskCache_pin(PDiskCacheCtx_t ctx, DWORD sector, DWORD count);
+
+//Get cache statistics
+// - If reset is true, the statistics are cleared after reading.
+HpsErr_t DiskCache_getStats(PDiskCacheCtx_t ctx, DiskCacheStats_t* stats, bool reset);
+
+#endif /* DISKIO_CACHE_H_ */
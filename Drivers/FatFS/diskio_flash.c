@@ -0,0 +1,385 @@
+/*
+ * FatFS Flash Disk Drivers
+ * ------------------------
+ *
+ * Disk drivers which allow a flash device with a generic
+ * flash driver to be mounted as a FatFS volume.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#include "diskio_flash.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "Util/macros.h"
+
+#ifdef FF_DISKIO_FLASHLOG
+#include "FlashLog/FlashLog.h"
+#endif
+
+#define DISKFLASH_NONE UINT_MAX
+
+/*
+ * Internal Functions
+ */
+
+//Convert driver status to disk result
+static DRESULT _DiskFlash_result(HpsErr_t status) {
+    switch (status) {
+        case ERR_SUCCESS:   return RES_OK;
+        case ERR_NOINIT:    return RES_NOTRDY;
+        case ERR_WRITEPROT: return RES_WRPRT;
+        case ERR_NULLPTR:
+        case ERR_BEYONDEND: return RES_PARERR;
+        default:            return RES_ERROR;
+    }
+}
+
+//Find the cache entry for a block, or NULL if not cached
+static DiskFlashCacheEntry_t* _DiskFlash_lookup(PDiskFlashCtx_t ctx, unsigned int address) {
+    for (unsigned int idx = 0; idx < ctx->cacheBlocks; idx++) {
+        if (ctx->cache[idx].address == address) {
+            ctx->cache[idx].lastUse = ++ctx->useCount;
+            return &ctx->cache[idx];
+        }
+    }
+    return NULL;
+}
+
+//Write a cached block back to flash
+static HpsErr_t _DiskFlash_writeBack(PDiskFlashCtx_t ctx, DiskFlashCacheEntry_t* entry) {
+    HpsErr_t status;
+    if (!entry->dirty) return ERR_SUCCESS;
+    if (entry->needErase) {
+        //Whole block must be erased and programmed
+        status = FLASH_erase(ctx->flash, entry->address, ctx->blockSize);
+        if (IS_ERROR(status)) return status;
+        status = FLASH_write(ctx->flash, entry->address, ctx->blockSize, entry->data);
+    } else {
+        //Only clearing bits, so the changed range can be programmed directly
+        unsigned int length = entry->dirtyEnd - entry->dirtyStart;
+        status = FLASH_write(ctx->flash, entry->address + entry->dirtyStart, length, entry->data + entry->dirtyStart);
+    }
+    if (IS_ERROR(status)) return status;
+    entry->dirty = false;
+    entry->needErase = false;
+    return ERR_SUCCESS;
+}
+
+//Get a cache entry for a block, evicting the least recently used
+// - If load is true, the block contents are read from flash.
+static HpsErr_t _DiskFlash_fetch(PDiskFlashCtx_t ctx, unsigned int address, bool load, DiskFlashCacheEntry_t** pEntry) {
+    DiskFlashCacheEntry_t* entry = _DiskFlash_lookup(ctx, address);
+    if (entry) {
+        *pEntry = entry;
+        return ERR_SUCCESS;
+    }
+    //Replace least recently used, unused entries first
+    entry = &ctx->cache[0];
+    for (unsigned int idx = 1; idx < ctx->cacheBlocks; idx++) {
+        if (entry->address == DISKFLASH_NONE) break;
+        if ((ctx->cache[idx].address == DISKFLASH_NONE) || (ctx->cache[idx].lastUse < entry->lastUse)) {
+            entry = &ctx->cache[idx];
+        }
+    }
+    HpsErr_t status = _DiskFlash_writeBack(ctx, entry);
+    if (IS_ERROR(status)) return status;
+    entry->address = DISKFLASH_NONE;
+    if (load) {
+        status = FLASH_read(ctx->flash, address, ctx->blockSize, entry->data);
+        if (IS_ERROR(status)) return status;
+    }
+    entry->address = address;
+    entry->lastUse = ++ctx->useCount;
+    *pEntry = entry;
+    return ERR_SUCCESS;
+}
+
+//Merge new data into a cached block
+// - If src is NULL, zeros are written.
+static void _DiskFlash_merge(PDiskFlashCtx_t ctx, DiskFlashCacheEntry_t* entry, unsigned int offset, unsigned int length, const uint8_t* src, bool loaded) {
+    uint8_t* dest = entry->data + offset;
+    if (!src) {
+        //Clearing bits never needs an erase
+        memset(dest, 0, length);
+    } else {
+        //Erase is needed if any bit goes from 0 to 1. Unless the block was
+        //loaded we don't know what is in the flash, so must erase.
+        if (!loaded) {
+            entry->needErase = true;
+        } else if (!entry->needErase) {
+            const uint32_t* cur = (const uint32_t*)dest;
+            for (unsigned int idx = 0; idx < length / sizeof(uint32_t); idx++) {
+                uint32_t val;
+                memcpy(&val, src + idx * sizeof(uint32_t), sizeof(val));
+                if ((cur[idx] & val) != val) {
+                    entry->needErase = true;
+                    break;
+                }
+            }
+        }
+        memcpy(dest, src, length);
+    }
+    //Track changed range
+    if (!entry->dirty) {
+        entry->dirtyStart = offset;
+        entry->dirtyEnd = offset + length;
+        entry->dirty = true;
+    } else {
+        if (offset < entry->dirtyStart) entry->dirtyStart = offset;
+        if (offset + length > entry->dirtyEnd) entry->dirtyEnd = offset + length;
+    }
+}
+
+static void _DiskFlash_cleanup(PDiskFlashCtx_t ctx) {
+    if (ctx->cache) {
+        //Write back any changes
+        if (ctx->header.initialised) DiskFlash_flush(ctx);
+        for (unsigned int idx = 0; idx < ctx->cacheBlocks; idx++) {
+            free(ctx->cache[idx].data);
+        }
+        free(ctx->cache);
+    }
+}
+
+/*
+ * Disk Driver
+ */
+
+static DSTATUS _DiskFlash_status(void* param) {
+    return DiskFlash_isInitialised((PDiskFlashCtx_t)param) ? 0 : STA_NOINIT;
+}
+
+static DRESULT _DiskFlash_read(void* param, BYTE* buff, DWORD sector, UINT count) {
+    PDiskFlashCtx_t ctx = (PDiskFlashCtx_t)param;
+    if (!buff) return RES_PARERR;
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return _DiskFlash_result(status);
+    if ((sector >= ctx->size / DISKFLASH_SECTOR_SIZE) || (count > ctx->size / DISKFLASH_SECTOR_SIZE - sector)) return RES_PARERR;
+    //Work through each erase block in the range
+    unsigned int offset = sector * DISKFLASH_SECTOR_SIZE;
+    unsigned int remain = count * DISKFLASH_SECTOR_SIZE;
+    while (remain) {
+        unsigned int blockOffset = offset % ctx->blockSize;
+        unsigned int address = ctx->base + offset - blockOffset;
+        unsigned int length = ctx->blockSize - blockOffset;
+        if (length > remain) length = remain;
+        //Use the cached copy if there is one, otherwise read directly
+        DiskFlashCacheEntry_t* entry = _DiskFlash_lookup(ctx, address);
+        if (entry) {
+            memcpy(buff, entry->data + blockOffset, length);
+        } else {
+            status = FLASH_read(ctx->flash, address + blockOffset, length, buff);
+            if (IS_ERROR(status)) return _DiskFlash_result(status);
+        }
+        offset += length;
+        buff += length;
+        remain -= length;
+    }
+    return RES_OK;
+}
+
+static DRESULT _DiskFlash_write(void* param, const BYTE* buff, DWORD sector, UINT count) {
+    PDiskFlashCtx_t ctx = (PDiskFlashCtx_t)param;
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return _DiskFlash_result(status);
+    if ((sector >= ctx->size / DISKFLASH_SECTOR_SIZE) || (count > ctx->size / DISKFLASH_SECTOR_SIZE - sector)) return RES_PARERR;
+    //Merge into the cached copy of each erase block in the range
+    unsigned int offset = sector * DISKFLASH_SECTOR_SIZE;
+    unsigned int remain = count * DISKFLASH_SECTOR_SIZE;
+    while (remain) {
+        unsigned int blockOffset = offset % ctx->blockSize;
+        unsigned int address = ctx->base + offset - blockOffset;
+        unsigned int length = ctx->blockSize - blockOffset;
+        if (length > remain) length = remain;
+        //No need to load the block if it is being completely replaced
+        bool load = (length != ctx->blockSize);
+        DiskFlashCacheEntry_t* entry;
+        bool cached = (_DiskFlash_lookup(ctx, address) != NULL);
+        status = _DiskFlash_fetch(ctx, address, load, &entry);
+        if (IS_ERROR(status)) return _DiskFlash_result(status);
+        _DiskFlash_merge(ctx, entry, blockOffset, length, buff, load || cached);
+        offset += length;
+        if (buff) buff += length;
+        remain -= length;
+    }
+    return RES_OK;
+}
+
+static DRESULT _DiskFlash_verify(void* param, const BYTE* buff, DWORD sector, UINT count) {
+    PDiskFlashCtx_t ctx = (PDiskFlashCtx_t)param;
+    //Make sure the flash is up to date, then compare each sector
+    HpsErr_t status = DiskFlash_flush(ctx);
+    if (IS_ERROR(status)) return _DiskFlash_result(status);
+    uint32_t check[DISKFLASH_SECTOR_SIZE / sizeof(uint32_t)];
+    while (count--) {
+        DRESULT res = _DiskFlash_read(param, (BYTE*)check, sector++, 1);
+        if (res != RES_OK) return res;
+        if (buff) {
+            if (memcmp(check, buff, DISKFLASH_SECTOR_SIZE)) return RES_ERROR;
+            buff += DISKFLASH_SECTOR_SIZE;
+        } else {
+            for (unsigned int idx = 0; idx < ARRAYSIZE(check); idx++) {
+                if (check[idx]) return RES_ERROR;
+            }
+        }
+    }
+    return RES_OK;
+}
+
+static DRESULT _DiskFlash_ioctl(void* param, BYTE cmd, void* buff) {
+    PDiskFlashCtx_t ctx = (PDiskFlashCtx_t)param;
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return _DiskFlash_result(status);
+    switch (cmd) {
+        case CTRL_SYNC:
+            return _DiskFlash_result(DiskFlash_flush(ctx));
+        case GET_SECTOR_COUNT:
+            *(DWORD*)buff = ctx->size / DISKFLASH_SECTOR_SIZE;
+            return RES_OK;
+        case GET_SECTOR_SIZE:
+            *(WORD*)buff = DISKFLASH_SECTOR_SIZE;
+            return RES_OK;
+        case GET_BLOCK_SIZE:
+            *(DWORD*)buff = ctx->blockSize / DISKFLASH_SECTOR_SIZE;
+            return RES_OK;
+        case CTRL_TRIM:
+            return RES_OK;
+    }
+    return RES_PARERR;
+}
+
+const DISKIO_DRIVER DiskIo_Flash = {
+    .initialize = &_DiskFlash_status,  // Driver is initialised by DiskFlash_initialise()
+    .status     = &_DiskFlash_status,
+    .read       = &_DiskFlash_read,
+    .write      = &_DiskFlash_write,
+    .verify     = &_DiskFlash_verify,
+    .ioctl      = &_DiskFlash_ioctl
+};
+
+/*
+ * FlashLog Disk Driver
+ */
+
+#ifdef FF_DISKIO_FLASHLOG
+
+static DSTATUS _DiskFlashLog_status(void* param) {
+    return FlashLog_isInitialised((PFlashLogCtx_t)param) ? 0 : STA_NOINIT;
+}
+
+static DRESULT _DiskFlashLog_read(void* param, BYTE* buff, DWORD sector, UINT count) {
+    return _DiskFlash_result(FlashLog_read((PFlashLogCtx_t)param, sector, count, buff));
+}
+
+static DRESULT _DiskFlashLog_write(void* param, const BYTE* buff, DWORD sector, UINT count) {
+    if (buff) return _DiskFlash_result(FlashLog_write((PFlashLogCtx_t)param, sector, count, buff));
+    //No buffer, so write zeros
+    static const uint8_t zeros[FLASHLOG_SECTOR_SIZE] = {0};
+    while (count--) {
+        HpsErr_t status = FlashLog_write((PFlashLogCtx_t)param, sector++, 1, zeros);
+        if (IS_ERROR(status)) return _DiskFlash_result(status);
+    }
+    return RES_OK;
+}
+
+static DRESULT _DiskFlashLog_ioctl(void* param, BYTE cmd, void* buff) {
+    PFlashLogCtx_t ctx = (PFlashLogCtx_t)param;
+    HpsErrExt_t count;
+    switch (cmd) {
+        case CTRL_SYNC:
+            return _DiskFlash_result(FlashLog_sync(ctx));
+        case GET_SECTOR_COUNT:
+            count = FlashLog_getSectorCount(ctx);
+            if (IS_ERROR_EXT(count)) return _DiskFlash_result(count);
+            *(DWORD*)buff = count;
+            return RES_OK;
+        case GET_SECTOR_SIZE:
+            *(WORD*)buff = FLASHLOG_SECTOR_SIZE;
+            return RES_OK;
+        case GET_BLOCK_SIZE:
+            *(DWORD*)buff = 1;  // Log handles erase blocks
+            return RES_OK;
+        case CTRL_TRIM:
+            return _DiskFlash_result(FlashLog_trim(ctx, ((DWORD*)buff)[0], ((DWORD*)buff)[1] - ((DWORD*)buff)[0] + 1));
+    }
+    return RES_PARERR;
+}
+
+const DISKIO_DRIVER DiskIo_FlashLog = {
+    .initialize = &_DiskFlashLog_status,  // Driver is initialised by FlashLog_initialise()
+    .status     = &_DiskFlashLog_status,
+    .read       = &_DiskFlashLog_read,
+    .write      = &_DiskFlashLog_write,
+    .verify     = NULL,
+    .ioctl      = &_DiskFlashLog_ioctl
+};
+
+#endif
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the flash disk
+// - flash is the flash driver to use.
+// - base is the address of the region in flash, which must be block aligned.
+// - blockCount is the number of erase blocks in the region.
+// - cacheBlocks is the number of erase blocks cached in RAM (at least 1).
+HpsErr_t DiskFlash_initialise(PFlashCtx_t flash, unsigned int base, unsigned int blockCount, unsigned int cacheBlocks, PDiskFlashCtx_t* pCtx) {
+    //Ensure user pointers valid
+    if (!flash) return ERR_NULLPTR;
+    if (!FLASH_isInitialised(flash)) return ERR_NOINIT;
+    if (!flash->blockSize || (flash->blockSize % DISKFLASH_SECTOR_SIZE)) return ERR_NOSUPPORT;
+    if (base % flash->blockSize) return ERR_ALIGNMENT;
+    if (!blockCount || !cacheBlocks) return ERR_TOOSMALL;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_DiskFlash_cleanup);
+    if (IS_ERROR(status)) return status;
+    PDiskFlashCtx_t ctx = *pCtx;
+    ctx->flash = flash;
+    ctx->base = base;
+    ctx->size = blockCount * flash->blockSize;
+    ctx->blockSize = flash->blockSize;
+    //Allocate the block cache
+    ctx->cache = calloc(cacheBlocks, sizeof(DiskFlashCacheEntry_t));
+    if (!ctx->cache) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    ctx->cacheBlocks = cacheBlocks;
+    for (unsigned int idx = 0; idx < cacheBlocks; idx++) {
+        ctx->cache[idx].address = DISKFLASH_NONE;
+        ctx->cache[idx].data = malloc(ctx->blockSize);
+        if (!ctx->cache[idx].data) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    }
+    //And initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+// - Returns true if driver previously initialised
+bool DiskFlash_isInitialised(PDiskFlashCtx_t ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Write all changed blocks back to flash
+HpsErr_t DiskFlash_flush(PDiskFlashCtx_t ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    for (unsigned int idx = 0; idx < ctx->cacheBlocks; idx++) {
+        status = _DiskFlash_writeBack(ctx, &ctx->cache[idx]);
+        if (IS_ERROR(status)) return status;
+    }
+    return ERR_SUCCESS;
+}
@@ -0,0 +1,99 @@
+/*
+ * FatFS Flash Disk Drivers
+ * ------------------------
+ *
+ * Disk drivers which allow a flash device with a generic
+ * flash driver (Util/driver_flash.h), such as the EPCQ or
+ * CFI flash, to be mounted as a FatFS volume alongside the
+ * SD card.
+ *
+ * DiskIo_Flash maps sectors directly onto a region of the
+ * flash. As flash must be erased a whole block at a time,
+ * writes are made to a RAM cache of erase blocks, which are
+ * written back when evicted or when FatFS syncs the volume
+ * (f_sync/f_close/f_unmount). A multi-sector write within
+ * one block then costs a single erase and program. Blocks
+ * are only erased if a write sets a bit which is clear in
+ * the flash, otherwise the new data is just programmed.
+ *
+ *    PDiskFlashCtx_t disk;
+ *    DiskFlash_initialise(flash, 0x800000, 64, 2, &disk);
+ *    disk_register(1, &DiskIo_Flash, disk);
+ *    f_mount(&fs, "1:", 1);
+ *
+ * DiskIo_FlashLog uses a wear-levelling FlashLog as the
+ * disk, with the FlashLog context as the param. It is only
+ * included if FF_DISKIO_FLASHLOG is globally defined, as
+ * the FlashLog driver must then be part of the project.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DISKIO_FLASH_H_
+#define DISKIO_FLASH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/driver_ctx.h"
+#include "Util/driver_flash.h"
+
+#include "diskio.h"
+
+//Sector size presented to FatFS
+#define DISKFLASH_SECTOR_SIZE 512
+
+//Cached erase block
+typedef struct {
+    unsigned int address;     // Address of block in flash, or UINT_MAX if unused
+    uint32_t lastUse;         // For least recently used replacement
+    bool dirty;               // Has changes not yet written to flash
+    bool needErase;           // Changes set bits which are clear in flash
+    unsigned int dirtyStart;  // Range of block which has changed
+    unsigned int dirtyEnd;
+    uint8_t* data;
+} DiskFlashCacheEntry_t;
+
+//Driver context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    PFlashCtx_t flash;
+    unsigned int base;         // Start of region in flash
+    unsigned int size;         // Size of region in bytes
+    unsigned int blockSize;
+    unsigned int cacheBlocks;
+    DiskFlashCacheEntry_t* cache;
+    uint32_t useCount;
+} DiskFlashCtx_t, *PDiskFlashCtx_t;
+
+//Disk drivers for disk_register()
+extern const DISKIO_DRIVER DiskIo_Flash;     // param is PDiskFlashCtx_t
+#ifdef FF_DISKIO_FLASHLOG
+extern const DISKIO_DRIVER DiskIo_FlashLog;  // param is PFlashLogCtx_t
+#endif
+
+//Initialise the flash disk
+// - flash is the flash driver to use.
+// - base is the address of the region in flash, which must be block aligned.
+// - blockCount is the number of erase blocks in the region.
+// - cacheBlocks is the number of erase blocks cached in RAM (at least 1).
+HpsErr_t DiskFlash_initialise(PFlashCtx_t flash, unsigned int base, unsigned int blockCount, unsigned int cacheBlocks, PDiskFlashCtx_t* pCtx);
+
+//Check if driver initialised
+// - Returns true if driver previously initialised
+bool DiskFlash_isInitialised(PDiskFlashCtx_t ctx);
+
+//Write all changed blocks back to flash
+HpsErr_t DiskFlash_flush(PDiskFlashCtx_t ctx);
+
+#endif /* DISKIO_FLASH_H_ */
@@ -0,0 +1,157 @@
+/*
+ * FatFS Host Image Disk Driver
+ * ----------------------------
+ *
+ * Disk driver which maps a disk image file into memory on
+ * a POSIX host.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#include "diskio_host.h"
+
+#ifdef FF_DISKIO_HOST
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+ * Internal Functions
+ */
+
+static void _DiskHost_cleanup(PDiskHostCtx_t ctx) {
+    if (ctx->base) {
+        msync(ctx->base, (size_t)ctx->sectorCount * DISKHOST_SECTOR_SIZE, MS_SYNC);
+        munmap(ctx->base, (size_t)ctx->sectorCount * DISKHOST_SECTOR_SIZE);
+    }
+    if (ctx->fd >= 0) {
+        close(ctx->fd);
+    }
+}
+
+//Check the sector range of a request
+static DRESULT _DiskHost_check(PDiskHostCtx_t ctx, DWORD sector, UINT count) {
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (status == ERR_NOINIT) return RES_NOTRDY;
+    if (IS_ERROR(status)) return RES_PARERR;
+    if ((sector >= ctx->sectorCount) || (count > ctx->sectorCount - sector)) return RES_PARERR;
+    return RES_OK;
+}
+
+/*
+ * Disk Driver
+ */
+
+static DSTATUS _DiskHost_status(void* param) {
+    return DiskHost_isInitialised((PDiskHostCtx_t)param) ? 0 : STA_NOINIT;
+}
+
+static DRESULT _DiskHost_read(void* param, BYTE* buff, DWORD sector, UINT count) {
+    PDiskHostCtx_t ctx = (PDiskHostCtx_t)param;
+    if (!buff) return RES_PARERR;
+    DRESULT res = _DiskHost_check(ctx, sector, count);
+    if (res != RES_OK) return res;
+    memcpy(buff, ctx->base + (size_t)sector * DISKHOST_SECTOR_SIZE, (size_t)count * DISKHOST_SECTOR_SIZE);
+    return RES_OK;
+}
+
+static DRESULT _DiskHost_write(void* param, const BYTE* buff, DWORD sector, UINT count) {
+    PDiskHostCtx_t ctx = (PDiskHostCtx_t)param;
+    DRESULT res = _DiskHost_check(ctx, sector, count);
+    if (res != RES_OK) return res;
+    if (buff) {
+        memcpy(ctx->base + (size_t)sector * DISKHOST_SECTOR_SIZE, buff, (size_t)count * DISKHOST_SECTOR_SIZE);
+    } else {
+        //No buffer, so write zeros
+        memset(ctx->base + (size_t)sector * DISKHOST_SECTOR_SIZE, 0, (size_t)count * DISKHOST_SECTOR_SIZE);
+    }
+    return RES_OK;
+}
+
+static DRESULT _DiskHost_ioctl(void* param, BYTE cmd, void* buff) {
+    PDiskHostCtx_t ctx = (PDiskHostCtx_t)param;
+    DRESULT res = _DiskHost_check(ctx, 0, 0);
+    if (res != RES_OK) return res;
+    switch (cmd) {
+        case CTRL_SYNC:
+            return msync(ctx->base, (size_t)ctx->sectorCount * DISKHOST_SECTOR_SIZE, MS_SYNC) ? RES_ERROR : RES_OK;
+        case CTRL_TRIM:
+            return RES_OK;
+        case GET_SECTOR_COUNT:
+            *(DWORD*)buff = ctx->sectorCount;
+            return RES_OK;
+        case GET_SECTOR_SIZE:
+            *(WORD*)buff = DISKHOST_SECTOR_SIZE;
+            return RES_OK;
+        case GET_BLOCK_SIZE:
+            *(DWORD*)buff = 1;
+            return RES_OK;
+    }
+    return RES_PARERR;
+}
+
+const DISKIO_DRIVER DiskIo_Host = {
+    .initialize = &_DiskHost_status,  // Driver is initialised by DiskHost_initialise()
+    .status     = &_DiskHost_status,
+    .read       = &_DiskHost_read,
+    .write      = &_DiskHost_write,
+    .verify     = NULL,
+    .ioctl      = &_DiskHost_ioctl
+};
+
+/*
+ * User Facing APIs
+ */
+
+//Open a disk image
+// - path is the image file, which is created if it does not exist.
+// - If sectorCount is non-zero, the image is extended to at least this many sectors.
+//   Otherwise the size of the existing file is used.
+// - Returns ERR_IOFAIL if the file cannot be opened or mapped.
+HpsErr_t DiskHost_initialise(const char* path, unsigned int sectorCount, PDiskHostCtx_t* pCtx) {
+    //Ensure user pointers valid
+    if (!path) return ERR_NULLPTR;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_DiskHost_cleanup);
+    if (IS_ERROR(status)) return status;
+    PDiskHostCtx_t ctx = *pCtx;
+    //Open the image, extending if required
+    ctx->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (ctx->fd < 0) return DriverContextInitFail(pCtx, ERR_IOFAIL);
+    struct stat info;
+    if (fstat(ctx->fd, &info)) return DriverContextInitFail(pCtx, ERR_IOFAIL);
+    off_t size = (off_t)sectorCount * DISKHOST_SECTOR_SIZE;
+    if (size > info.st_size) {
+        if (ftruncate(ctx->fd, size)) return DriverContextInitFail(pCtx, ERR_IOFAIL);
+    } else {
+        size = info.st_size;
+    }
+    if (size < DISKHOST_SECTOR_SIZE) return DriverContextInitFail(pCtx, ERR_TOOSMALL);
+    //And map it
+    ctx->sectorCount = size / DISKHOST_SECTOR_SIZE;
+    void* base = mmap(NULL, (size_t)ctx->sectorCount * DISKHOST_SECTOR_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, ctx->fd, 0);
+    if (base == MAP_FAILED) return DriverContextInitFail(pCtx, ERR_IOFAIL);
+    ctx->base = (uint8_t*)base;
+    //And initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+// - Returns true if driver previously initialised
+bool DiskHost_isInitialised(PDiskHostCtx_t ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+#endif
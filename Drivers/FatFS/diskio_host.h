@@ -0,0 +1,75 @@
+/*
+ * FatFS Host Image Disk Driver
+ * ----------------------------
+ *
+ * Disk driver which maps a disk image file into memory on
+ * a Linux (or other POSIX) host, so that the whole FatFS
+ * stack can be built natively for benchmarking and fuzzing
+ * on a build server rather than on the board.
+ *
+ * The driver is only built if FF_DISKIO_HOST is globally
+ * defined. FF_DISKIO_NO_SDMMC should also be defined so
+ * that the SD card driver is not needed, e.g.:
+ *
+ *    gcc -DFF_DISKIO_HOST -DFF_DISKIO_NO_SDMMC -I. -IFatFS \
+ *        FatFS/ff.c FatFS/ffsystem.c FatFS/ffunicode.c \
+ *        FatFS/diskio.c FatFS/diskio_host.c \
+ *        Util/driver_ctx.c Util/mem_fast.c test.c
+ *
+ *    PDiskHostCtx_t img;
+ *    DiskHost_initialise("disk.img", 65536, &img);
+ *    disk_register(0, &DiskIo_Host, img);
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DISKIO_HOST_H_
+#define DISKIO_HOST_H_
+
+#ifdef FF_DISKIO_HOST
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/driver_ctx.h"
+
+#include "diskio.h"
+
+//Sector size presented to FatFS
+#define DISKHOST_SECTOR_SIZE 512
+
+//Driver context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    int fd;
+    uint8_t* base;         // Mapped image
+    unsigned int sectorCount;
+} DiskHostCtx_t, *PDiskHostCtx_t;
+
+//Disk driver for disk_register()
+extern const DISKIO_DRIVER DiskIo_Host;  // param is PDiskHostCtx_t
+
+//Open a disk image
+// - path is the image file, which is created if it does not exist.
+// - If sectorCount is non-zero, the image is extended to at least this many sectors.
+//   Otherwise the size of the existing file is used.
+// - Returns ERR_IOFAIL if the file cannot be opened or mapped.
+HpsErr_t DiskHost_initialise(const char* path, unsigned int sectorCount, PDiskHostCtx_t* pCtx);
+
+//Check if driver initialised
+// - Returns true if driver previously initialised
+bool DiskHost_isInitialised(PDiskHostCtx_t ctx);
+
+#endif
+
+#endif /* DISKIO_HOST_H_ */
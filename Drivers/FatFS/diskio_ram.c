@@ -0,0 +1,121 @@
+/*
+ * FatFS RAM Disk Driver
+ * ---------------------
+ *
+ * Disk driver which allows a region of memory to be
+ * mounted as a FatFS volume.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#include "diskio_ram.h"
+
+#include <string.h>
+
+#include "Util/bit_helpers.h"
+
+/*
+ * Disk Driver
+ */
+
+//Check the sector range of a request
+static DRESULT _DiskRam_check(PDiskRamCtx_t ctx, DWORD sector, UINT count) {
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (status == ERR_NOINIT) return RES_NOTRDY;
+    if (IS_ERROR(status)) return RES_PARERR;
+    if ((sector >= ctx->sectorCount) || (count > ctx->sectorCount - sector)) return RES_PARERR;
+    return RES_OK;
+}
+
+static DSTATUS _DiskRam_status(void* param) {
+    return DiskRam_isInitialised((PDiskRamCtx_t)param) ? 0 : STA_NOINIT;
+}
+
+static DRESULT _DiskRam_read(void* param, BYTE* buff, DWORD sector, UINT count) {
+    PDiskRamCtx_t ctx = (PDiskRamCtx_t)param;
+    if (!buff) return RES_PARERR;
+    DRESULT res = _DiskRam_check(ctx, sector, count);
+    if (res != RES_OK) return res;
+    memcpy(buff, ctx->base + sector * DISKRAM_SECTOR_SIZE, count * DISKRAM_SECTOR_SIZE);
+    return RES_OK;
+}
+
+static DRESULT _DiskRam_write(void* param, const BYTE* buff, DWORD sector, UINT count) {
+    PDiskRamCtx_t ctx = (PDiskRamCtx_t)param;
+    DRESULT res = _DiskRam_check(ctx, sector, count);
+    if (res != RES_OK) return res;
+    if (buff) {
+        memcpy(ctx->base + sector * DISKRAM_SECTOR_SIZE, buff, count * DISKRAM_SECTOR_SIZE);
+    } else {
+        //No buffer, so write zeros
+        memset(ctx->base + sector * DISKRAM_SECTOR_SIZE, 0, count * DISKRAM_SECTOR_SIZE);
+    }
+    return RES_OK;
+}
+
+static DRESULT _DiskRam_ioctl(void* param, BYTE cmd, void* buff) {
+    PDiskRamCtx_t ctx = (PDiskRamCtx_t)param;
+    DRESULT res = _DiskRam_check(ctx, 0, 0);
+    if (res != RES_OK) return res;
+    switch (cmd) {
+        case CTRL_SYNC:
+        case CTRL_TRIM:
+            return RES_OK;
+        case GET_SECTOR_COUNT:
+            *(DWORD*)buff = ctx->sectorCount;
+            return RES_OK;
+        case GET_SECTOR_SIZE:
+            *(WORD*)buff = DISKRAM_SECTOR_SIZE;
+            return RES_OK;
+        case GET_BLOCK_SIZE:
+            *(DWORD*)buff = 1;
+            return RES_OK;
+    }
+    return RES_PARERR;
+}
+
+const DISKIO_DRIVER DiskIo_Ram = {
+    .initialize = &_DiskRam_status,  // Driver is initialised by DiskRam_initialise()
+    .status     = &_DiskRam_status,
+    .read       = &_DiskRam_read,
+    .write      = &_DiskRam_write,
+    .verify     = NULL,              // Nothing to verify against
+    .ioctl      = &_DiskRam_ioctl
+};
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the RAM disk
+// - base is the start of the memory region, which must be word aligned.
+// - size is the size of the region in bytes. Any partial sector at the end is unused.
+HpsErr_t DiskRam_initialise(void* base, unsigned int size, PDiskRamCtx_t* pCtx) {
+    //Ensure user pointers valid
+    if (!base) return ERR_NULLPTR;
+    if (!pointerIsAligned(base, sizeof(uint32_t))) return ERR_ALIGNMENT;
+    if (size < DISKRAM_SECTOR_SIZE) return ERR_TOOSMALL;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocate(pCtx);
+    if (IS_ERROR(status)) return status;
+    PDiskRamCtx_t ctx = *pCtx;
+    ctx->base = (uint8_t*)base;
+    ctx->sectorCount = size / DISKRAM_SECTOR_SIZE;
+    //And initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+// - Returns true if driver previously initialised
+bool DiskRam_isInitialised(PDiskRamCtx_t ctx) {
+    return DriverContextCheckInit(ctx);
+}
@@ -0,0 +1,65 @@
+/*
+ * FatFS RAM Disk Driver
+ * ---------------------
+ *
+ * Disk driver which allows a region of memory, such as part
+ * of the HPS DDR (LSC_BASE_DDR_RAM) or the FPGA SDRAM, to be
+ * mounted as a FatFS volume. This gives a fast scratch area
+ * for temporary files such as frames or audio clips without
+ * going through the SD card.
+ *
+ *    PDiskRamCtx_t ram;
+ *    DiskRam_initialise(LSC_BASE_FPGA_SDRAM, 0x1000000, &ram);
+ *    disk_register(2, &DiskIo_Ram, ram);
+ *    f_mkfs("2:", FM_FAT | FM_SFD, 0, work, sizeof(work));
+ *    f_mount(&fs, "2:", 1);
+ *
+ * The contents are lost on reset, so the volume must be
+ * formatted with f_mkfs() before it is first mounted.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DISKIO_RAM_H_
+#define DISKIO_RAM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/driver_ctx.h"
+
+#include "diskio.h"
+
+//Sector size presented to FatFS
+#define DISKRAM_SECTOR_SIZE 512
+
+//Driver context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    uint8_t* base;
+    unsigned int sectorCount;
+} DiskRamCtx_t, *PDiskRamCtx_t;
+
+//Disk driver for disk_register()
+extern const DISKIO_DRIVER DiskIo_Ram;  // param is PDiskRamCtx_t
+
+//Initialise the RAM disk
+// - base is the start of the memory region, which must be word aligned.
+// - size is the size of the region in bytes. Any partial sector at the end is unused.
+HpsErr_t DiskRam_initialise(void* base, unsigned int size, PDiskRamCtx_t* pCtx);
+
+//Check if driver initialised
+// - Returns true if driver previously initialised
+bool DiskRam_isInitialised(PDiskRamCtx_t ctx);
+
+#endif /* DISKIO_RAM_H_ */
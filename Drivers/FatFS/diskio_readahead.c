@@ -0,0 +1,291 @@
+/*
+ * FatFS Read-Ahead
+ * ----------------
+ *
+ * Read-ahead layer which sits between FatFS and another
+ * disk driver.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#include "diskio_readahead.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Util/mem_fast.h"
+
+#define DISKREADAHEAD_NONE 0xFFFFFFFFU
+
+/*
+ * Internal Functions
+ */
+
+//Convert driver status to disk result
+static DRESULT _DiskReadAhead_result(HpsErr_t status) {
+    switch (status) {
+        case ERR_SUCCESS:   return RES_OK;
+        case ERR_NOINIT:    return RES_NOTRDY;
+        case ERR_WRITEPROT: return RES_WRPRT;
+        case ERR_NULLPTR:
+        case ERR_BEYONDEND: return RES_PARERR;
+        default:            return RES_ERROR;
+    }
+}
+
+//Find the stream whose buffer holds a sector, or NULL if none
+static DiskReadAheadStream_t* _DiskReadAhead_findBuffered(PDiskReadAheadCtx_t ctx, DWORD sector) {
+    for (unsigned int idx = 0; idx < ctx->streamCount; idx++) {
+        DiskReadAheadStream_t* stream = &ctx->streams[idx];
+        if ((sector >= stream->start) && (sector - stream->start < stream->count)) return stream;
+    }
+    return NULL;
+}
+
+//Find the stream expecting a sector next, or NULL if none
+static DiskReadAheadStream_t* _DiskReadAhead_findNext(PDiskReadAheadCtx_t ctx, DWORD sector) {
+    for (unsigned int idx = 0; idx < ctx->streamCount; idx++) {
+        DiskReadAheadStream_t* stream = &ctx->streams[idx];
+        if (stream->depth && (stream->next == sector)) return stream;
+    }
+    return NULL;
+}
+
+//Record where a read not followed by any stream ended
+static void _DiskReadAhead_addRecent(PDiskReadAheadCtx_t ctx, DWORD next) {
+    ctx->recent[ctx->recentIdx] = next;
+    ctx->recentIdx = (ctx->recentIdx + 1) % DISKREADAHEAD_RECENT;
+}
+
+//Check if a sector follows on from a recent read
+static bool _DiskReadAhead_checkRecent(PDiskReadAheadCtx_t ctx, DWORD sector) {
+    for (unsigned int idx = 0; idx < DISKREADAHEAD_RECENT; idx++) {
+        if (ctx->recent[idx] == sector) {
+            ctx->recent[idx] = DISKREADAHEAD_NONE;
+            return true;
+        }
+    }
+    return false;
+}
+
+//Fill a stream buffer starting from a sector
+// - A stream which has used up its buffer in order reads further ahead next time.
+// - A new stream is only started if the read follows on from a recent one,
+//   so that scattered reads (e.g. of the FAT) don't displace file streams.
+//   Otherwise *pStream is NULL.
+static DRESULT _DiskReadAhead_fetch(PDiskReadAheadCtx_t ctx, DWORD sector, DiskReadAheadStream_t** pStream) {
+    DiskReadAheadStream_t* stream = _DiskReadAhead_findNext(ctx, sector);
+    *pStream = NULL;
+    if (stream) {
+        if (stream->count && (stream->next == stream->start + stream->count)) {
+            stream->depth *= 2;
+            if (stream->depth > ctx->bufferSectors) stream->depth = ctx->bufferSectors;
+        }
+    } else {
+        if (!_DiskReadAhead_checkRecent(ctx, sector)) return RES_OK;
+        //New stream replaces the least recently used
+        stream = &ctx->streams[0];
+        for (unsigned int idx = 1; idx < ctx->streamCount; idx++) {
+            if (ctx->streams[idx].lastUse < stream->lastUse) stream = &ctx->streams[idx];
+        }
+        stream->depth = DISKREADAHEAD_MIN_DEPTH;
+    }
+    //Don't read beyond the end of the disk
+    UINT count = stream->depth;
+    if (count > ctx->sectorCount - sector) count = ctx->sectorCount - sector;
+    stream->count = 0;
+    DRESULT res = ctx->drv->read(ctx->param, stream->data, sector, count);
+    if (res != RES_OK) return res;
+    stream->start = sector;
+    stream->count = count;
+    ctx->stats.fetches++;
+    ctx->stats.prefetched += count;
+    *pStream = stream;
+    return RES_OK;
+}
+
+static void _DiskReadAhead_cleanup(PDiskReadAheadCtx_t ctx) {
+    free(ctx->streams);
+    free(ctx->data);
+}
+
+/*
+ * Disk Driver
+ */
+
+static DSTATUS _DiskReadAhead_status(void* param) {
+    PDiskReadAheadCtx_t ctx = (PDiskReadAheadCtx_t)param;
+    if (!DiskReadAhead_isInitialised(ctx)) return STA_NOINIT;
+    return ctx->drv->status(ctx->param);
+}
+
+static DSTATUS _DiskReadAhead_initialize(void* param) {
+    PDiskReadAheadCtx_t ctx = (PDiskReadAheadCtx_t)param;
+    if (!DiskReadAhead_isInitialised(ctx)) return STA_NOINIT;
+    //Disk may have changed, so drop any buffered data
+    for (unsigned int idx = 0; idx < ctx->streamCount; idx++) {
+        ctx->streams[idx].count = 0;
+        ctx->streams[idx].depth = 0;
+    }
+    for (unsigned int idx = 0; idx < DISKREADAHEAD_RECENT; idx++) {
+        ctx->recent[idx] = DISKREADAHEAD_NONE;
+    }
+    ctx->sectorCount = 0;
+    DSTATUS stat = ctx->drv->initialize(ctx->param);
+    if (stat & STA_NOINIT) return stat;
+    //Stream buffers are a whole number of sectors
+    WORD sectorSize = DISKREADAHEAD_SECTOR_SIZE;
+    if (ctx->drv->ioctl(ctx->param, GET_SECTOR_SIZE, &sectorSize) != RES_OK) sectorSize = DISKREADAHEAD_SECTOR_SIZE;
+    if (sectorSize != DISKREADAHEAD_SECTOR_SIZE) return stat | STA_NOINIT;
+    if (ctx->drv->ioctl(ctx->param, GET_SECTOR_COUNT, &ctx->sectorCount) != RES_OK) return stat | STA_NOINIT;
+    return stat;
+}
+
+static DRESULT _DiskReadAhead_read(void* param, BYTE* buff, DWORD sector, UINT count) {
+    PDiskReadAheadCtx_t ctx = (PDiskReadAheadCtx_t)param;
+    if (!buff) return RES_PARERR;
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return _DiskReadAhead_result(status);
+    if (!ctx->sectorCount) return RES_NOTRDY;
+    if ((sector >= ctx->sectorCount) || (count > ctx->sectorCount - sector)) return RES_PARERR;
+    if (count >= ctx->bufferSectors) {
+        //Large reads gain nothing from the buffer. Keep following the stream.
+        DRESULT res = ctx->drv->read(ctx->param, buff, sector, count);
+        if (res != RES_OK) return res;
+        ctx->stats.direct += count;
+        DiskReadAheadStream_t* stream = _DiskReadAhead_findNext(ctx, sector);
+        if (stream) {
+            stream->next = sector + count;
+            stream->lastUse = ++ctx->useCount;
+        } else {
+            _DiskReadAhead_addRecent(ctx, sector + count);
+        }
+        return RES_OK;
+    }
+    while (count) {
+        DiskReadAheadStream_t* stream = _DiskReadAhead_findBuffered(ctx, sector);
+        if (!stream) {
+            DRESULT res = _DiskReadAhead_fetch(ctx, sector, &stream);
+            if (res != RES_OK) return res;
+        }
+        if (!stream) {
+            //Not sequential (yet), so read directly
+            DRESULT res = ctx->drv->read(ctx->param, buff, sector, count);
+            if (res != RES_OK) return res;
+            ctx->stats.direct += count;
+            _DiskReadAhead_addRecent(ctx, sector + count);
+            return RES_OK;
+        }
+        //Copy out as much as is buffered
+        UINT offset = sector - stream->start;
+        UINT length = stream->count - offset;
+        if (length > count) length = count;
+        MemFast_copy(buff, stream->data + offset * DISKREADAHEAD_SECTOR_SIZE, length * DISKREADAHEAD_SECTOR_SIZE);
+        ctx->stats.hits += length;
+        sector += length;
+        count -= length;
+        buff += length * DISKREADAHEAD_SECTOR_SIZE;
+        stream->next = sector;
+        stream->lastUse = ++ctx->useCount;
+    }
+    return RES_OK;
+}
+
+static DRESULT _DiskReadAhead_write(void* param, const BYTE* buff, DWORD sector, UINT count) {
+    PDiskReadAheadCtx_t ctx = (PDiskReadAheadCtx_t)param;
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return _DiskReadAhead_result(status);
+    if (!ctx->drv->write) return RES_WRPRT;
+    //Buffered copies of these sectors are now stale. Keep the part before them.
+    for (unsigned int idx = 0; idx < ctx->streamCount; idx++) {
+        DiskReadAheadStream_t* stream = &ctx->streams[idx];
+        if ((sector < stream->start + stream->count) && (stream->start < sector + count)) {
+            stream->count = (sector > stream->start) ? (sector - stream->start) : 0;
+        }
+    }
+    return ctx->drv->write(ctx->param, buff, sector, count);
+}
+
+static DRESULT _DiskReadAhead_verify(void* param, const BYTE* buff, DWORD sector, UINT count) {
+    PDiskReadAheadCtx_t ctx = (PDiskReadAheadCtx_t)param;
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return _DiskReadAhead_result(status);
+    if (!ctx->drv->verify) return RES_PARERR;
+    return ctx->drv->verify(ctx->param, buff, sector, count);
+}
+
+static DRESULT _DiskReadAhead_ioctl(void* param, BYTE cmd, void* buff) {
+    PDiskReadAheadCtx_t ctx = (PDiskReadAheadCtx_t)param;
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return _DiskReadAhead_result(status);
+    return ctx->drv->ioctl(ctx->param, cmd, buff);
+}
+
+const DISKIO_DRIVER DiskIo_ReadAhead = {
+    .initialize = &_DiskReadAhead_initialize,
+    .status     = &_DiskReadAhead_status,
+    .read       = &_DiskReadAhead_read,
+    .write      = &_DiskReadAhead_write,
+    .verify     = &_DiskReadAhead_verify,
+    .ioctl      = &_DiskReadAhead_ioctl
+};
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the read-ahead layer
+// - drv and param are the disk driver to read from, as would be passed to disk_register().
+// - streamCount is the number of sequential streams followed at once (e.g. open files).
+// - bufferSectors is the largest read-ahead per stream, at least DISKREADAHEAD_MIN_DEPTH.
+HpsErr_t DiskReadAhead_initialise(const DISKIO_DRIVER* drv, void* param, unsigned int streamCount, unsigned int bufferSectors, PDiskReadAheadCtx_t* pCtx) {
+    //Ensure user pointers valid
+    if (!drv) return ERR_NULLPTR;
+    if (!drv->initialize || !drv->status || !drv->read || !drv->ioctl) return ERR_NOSUPPORT;
+    if (!streamCount || (bufferSectors < DISKREADAHEAD_MIN_DEPTH)) return ERR_TOOSMALL;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_DiskReadAhead_cleanup);
+    if (IS_ERROR(status)) return status;
+    PDiskReadAheadCtx_t ctx = *pCtx;
+    ctx->drv = drv;
+    ctx->param = param;
+    //Allocate the stream buffers
+    ctx->data = malloc(streamCount * bufferSectors * DISKREADAHEAD_SECTOR_SIZE);
+    if (!ctx->data) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    ctx->streams = calloc(streamCount, sizeof(DiskReadAheadStream_t));
+    if (!ctx->streams) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    ctx->streamCount = streamCount;
+    ctx->bufferSectors = bufferSectors;
+    for (unsigned int idx = 0; idx < streamCount; idx++) {
+        ctx->streams[idx].data = ctx->data + idx * bufferSectors * DISKREADAHEAD_SECTOR_SIZE;
+    }
+    //And initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+// - Returns true if driver previously initialised
+bool DiskReadAhead_isInitialised(PDiskReadAheadCtx_t ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Get read-ahead statistics
+// - If reset is true, the statistics are cleared after reading.
+HpsErr_t DiskReadAhead_getStats(PDiskReadAheadCtx_t ctx, DiskReadAheadStats_t* stats, bool reset) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    if (!stats) return ERR_NULLPTR;
+    *stats = ctx->stats;
+    if (reset) memset(&ctx->stats, 0, sizeof(ctx->stats));
+    return ERR_SUCCESS;
+}
@@ -0,0 +1,124 @@
+/*
+ * FatFS Read-Ahead
+ * ----------------
+ *
+ * Read-ahead layer which sits between FatFS and another
+ * disk driver, such as the SD card. When streaming a
+ * file, f_read() reads from the disk every time the file
+ * crosses a sector, each of which is a separate command
+ * to the card.
+ *
+ * Sequential reads are detected by keeping a number of
+ * streams, each of which remembers the sector it expects
+ * to be read next. Each open file being read in order is
+ * then followed by its own stream. When a stream runs out
+ * of buffered data, the following sectors are fetched in
+ * a single multiple-block read, and later reads are served
+ * from memory. The read-ahead depth starts small, and is
+ * doubled each time a stream consumes all of its buffer,
+ * up to the size of the stream buffer.
+ *
+ * A new stream is started, in place of the least recently
+ * used, when a read follows on from one of the last few
+ * reads. Scattered reads, such as of the FAT, are passed
+ * straight to the disk so don't displace file streams.
+ * Stacking this on a DiskIo_Cache covers both cases.
+ *
+ * Reads at least as large as the stream buffer (e.g. an
+ * f_read() of many sectors directly into the user buffer)
+ * go straight to the disk. Writes drop overlapping data
+ * from the stream buffers.
+ *
+ *    PDiskReadAheadCtx_t readAhead;
+ *    DiskReadAhead_initialise(&DiskIo_SDMMC, NULL, 2, 64, &readAhead);
+ *    disk_register(0, &DiskIo_ReadAhead, readAhead);
+ *    f_mount(&fs, "0:", 1);
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DISKIO_READAHEAD_H_
+#define DISKIO_READAHEAD_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/driver_ctx.h"
+
+#include "diskio.h"
+
+//Sector size of the underlying disk
+#define DISKREADAHEAD_SECTOR_SIZE 512
+
+//Number of sectors first read ahead for a new stream
+#ifndef DISKREADAHEAD_MIN_DEPTH
+#define DISKREADAHEAD_MIN_DEPTH 8
+#endif
+
+//Number of recent reads checked for the start of a new stream
+#ifndef DISKREADAHEAD_RECENT
+#define DISKREADAHEAD_RECENT 4
+#endif
+
+//Sequential read stream
+typedef struct {
+    DWORD next;               // Sector expected to be read next
+    DWORD start;              // First sector in buffer
+    UINT count;               // Number of sectors in buffer
+    UINT depth;               // Number of sectors to read ahead
+    uint32_t lastUse;         // For least recently used replacement
+    uint8_t* data;
+} DiskReadAheadStream_t;
+
+//Read-ahead statistics
+typedef struct {
+    uint32_t hits;            // Sectors served from a stream buffer
+    uint32_t fetches;         // Reads issued to fill a stream buffer
+    uint32_t prefetched;      // Sectors read into stream buffers
+    uint32_t direct;          // Sectors read directly
+} DiskReadAheadStats_t;
+
+//Driver context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    const DISKIO_DRIVER* drv;  // Underlying disk
+    void* param;
+    DWORD sectorCount;         // Size of underlying disk
+    unsigned int streamCount;
+    unsigned int bufferSectors;
+    DiskReadAheadStream_t* streams;
+    uint8_t* data;
+    DWORD recent[DISKREADAHEAD_RECENT];  // Sectors following recent reads
+    unsigned int recentIdx;
+    uint32_t useCount;
+    DiskReadAheadStats_t stats;
+} DiskReadAheadCtx_t, *PDiskReadAheadCtx_t;
+
+//Disk driver for disk_register()
+extern const DISKIO_DRIVER DiskIo_ReadAhead;     // param is PDiskReadAheadCtx_t
+
+//Initialise the read-ahead layer
+// - drv and param are the disk driver to read from, as would be passed to disk_register().
+// - streamCount is the number of sequential streams followed at once (e.g. open files).
+// - bufferSectors is the largest read-ahead per stream, at least DISKREADAHEAD_MIN_DEPTH.
+HpsErr_t DiskReadAhead_initialise(const DISKIO_DRIVER* drv, void* param, unsigned int streamCount, unsigned int bufferSectors, PDiskReadAheadCtx_t* pCtx);
+
+//Check if driver initialised
+// - Returns true if driver previously initialised
+bool DiskReadAhead_isInitialised(PDiskReadAheadCtx_t ctx);
+
+//Get read-ahead statistics
+// - If reset is true, the statistics are cleared after reading.
+HpsErr_t DiskReadAhead_getStats(PDiskReadAheadCtx_t ctx, DiskReadAheadStats_t* stats, bool reset);
+
+#endif /* DISKIO_READAHEAD_H_ */
@@ -11,16 +11,24 @@
 #include "hwlib/cv/socal/hps.h"
 #endif
 #include "diskio.h"
+#include "diskio_socfpga.h"
 #include "ff.h"         /* Declarations of sector size */
 // Minimal Altera HWLib for SD-Card (hwlib/)
 #include "hwlib/alt_sdmmc.h"
+#include "hwlib/alt_cache.h"
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include "Util/mem_fast.h"
 #include "HPS_Watchdog/HPS_Watchdog.h"
+#include "HPS_IRQ/HPS_IRQ.h"
 
 
-#ifdef FF_DEBUG
+#if defined(FF_DEBUG) && defined(VERBOSE_BINARY_TRACE)
+    //Log to binary trace buffer if enabled, to avoid printf cost during transfers
+    #include "Util/trace.h"
+    #define printf(...) TracePrintf(VERBOSE_INFO, __VA_ARGS__)
+#elif defined(FF_DEBUG)
     //Include printf headers if debugging
     #include <stdio.h>
 #else
@@ -28,16 +36,19 @@
     #define printf(...) (0)
 #endif
 
-#ifdef FF_MULTI_PARTITION
-PARTITION VolToPart[] __attribute__((weak)) = {};
+// Widest bus to use if the card supports it. Falls back to 1-bit if 4-bit fails.
+#ifndef FF_SDMMC_BUS_WIDTH
+#define FF_SDMMC_BUS_WIDTH ALT_SDMMC_BUS_WIDTH_4
 #endif
 
-#ifndef FF_SDMMC_BUS_WIDTH
-    #ifdef __ARRIA10__
-    #define FF_SDMMC_BUS_WIDTH ALT_SDMMC_BUS_WIDTH_1
-    #else
-    #define FF_SDMMC_BUS_WIDTH ALT_SDMMC_BUS_WIDTH_4
-    #endif
+// Whether to switch cards which support it to 50MHz high speed mode
+#ifndef FF_SDMMC_HIGH_SPEED
+#define FF_SDMMC_HIGH_SPEED 1
+#endif
+
+// Size of aligned buffer used when the FatFS buffer is not suitably aligned
+#ifndef FF_SDMMC_BOUNCE_SIZE
+#define FF_SDMMC_BOUNCE_SIZE 4096
 #endif
 
 /*-----------------------------------------------------------------------*/
@@ -59,19 +70,175 @@ static uint32_t Sdmmc_Sector_Size;
 // Card Initialised
 static bool Sdmmc_Initialised = false;
 
+// Aligned buffer for transfers to/from non-aligned buffers. Sectors are
+// transferred in runs of up to FF_SDMMC_BOUNCE_SIZE through this buffer.
+static uint32_t Sdmmc_Bounce_Buff[FF_SDMMC_BOUNCE_SIZE/sizeof(uint32_t)] __attribute__((aligned(ALT_CACHE_LINE_SIZE)));
+
+// Asynchronous request queue. The request at the head is the one in progress.
+static DiskSdmmcRequest_t* Sdmmc_Queue[FF_SDMMC_QUEUE_LENGTH];
+static volatile unsigned int Sdmmc_Queue_Head = 0;
+static volatile unsigned int Sdmmc_Queue_Count = 0;
+
+// Whether a command for the request at the head of the queue is in progress
+static volatile bool Sdmmc_Queue_Running = false;
+
+// Whether FatFS is using the card, so queued requests must not be started
+static volatile bool Sdmmc_Sync_Active = false;
+
+// Whether the SD/MMC interrupt handler has been registered
+static bool Sdmmc_Async_Irq = false;
+
+// Convert a sector number to a card block number. Blocks are used rather than
+// byte addresses, which would overflow beyond 4GB.
+static inline uint32_t sdmmc_block (
+    DWORD sector    /* Sector number */
+)
+{
+    return (uint32_t)(((uint64_t)sector * Sdmmc_Sector_Size) / Sdmmc_Block_Size);
+}
+
+// Get the number of sectors which can be transferred in one command through the
+// bounce buffer, or in the background
+static inline UINT sdmmc_run_length (
+    UINT count,     /* Number of sectors remaining */
+    bool bounce     /* Whether the bounce buffer is used */
+)
+{
+    UINT maxCount = (bounce ? FF_SDMMC_BOUNCE_SIZE : ALT_SDMMC_DMA_MAX_TRANSFER_SIZE) / Sdmmc_Sector_Size;
+    return (count > maxCount) ? maxCount : count;
+}
+
+// Check whether a buffer can be read into directly by DMA. With the data cache
+// enabled, this requires whole cache lines, as any other data sharing the first
+// or last line could be lost when the line is invalidated after the read.
+static inline bool sdmmc_read_aligned (
+    const BYTE* buff    /* Data buffer */
+)
+{
+    if (((uint32_t)buff) & 3) return false;
+    return !alt_cache_l1_data_is_enabled() || !(((uint32_t)buff) & (ALT_CACHE_LINE_SIZE - 1));
+}
+
+/*-----------------------------------------------------------------------*/
+/* Asynchronous Request Queue                                            */
+/*-----------------------------------------------------------------------*/
+// These must be called with interrupts disabled, or from the IRQ handler.
+
+// Remove the request at the head of the queue and report its result
+static void sdmmc_async_complete (
+    HpsErr_t result     /* Result of the request */
+)
+{
+    DiskSdmmcRequest_t* req = Sdmmc_Queue[Sdmmc_Queue_Head];
+    Sdmmc_Queue_Head = (Sdmmc_Queue_Head + 1) % FF_SDMMC_QUEUE_LENGTH;
+    Sdmmc_Queue_Count--;
+    Sdmmc_Queue_Running = false;
+    req->status = result;
+    if (req->callback) {
+        req->callback(req->param, result);
+    }
+}
+
+// Start the next command of the request at the head of the queue if the card is free
+static void sdmmc_async_start (void)
+{
+    while (!Sdmmc_Queue_Running && Sdmmc_Queue_Count && !Sdmmc_Sync_Active) {
+        if (alt_sdmmc_transfer_is_ready() != ALT_E_TRUE) {
+            //Card still busy with a write, try again when next serviced
+            return;
+        }
+        DiskSdmmcRequest_t* req = Sdmmc_Queue[Sdmmc_Queue_Head];
+        uint32_t block = sdmmc_block(req->sector + req->done);
+        req->blocks = sdmmc_run_length(req->count - req->done, false);
+        ALT_STATUS_CODE sdmmcStat = alt_sdmmc_transfer_start(&Card_Info, block,
+                                                             (void*)(req->buff + req->done * Sdmmc_Sector_Size),
+                                                             req->blocks * Sdmmc_Sector_Size,
+                                                             req->write ? ALT_SDMMC_TMOD_WRITE : ALT_SDMMC_TMOD_READ);
+        if (sdmmcStat == ALT_E_SUCCESS) {
+            Sdmmc_Queue_Running = true;
+            return;
+        }
+        printf("FatFS: Async Sec %u (Blk %u) Start Err %d.\n", (UINT)(req->sector + req->done), (UINT)block, sdmmcStat);
+        sdmmc_async_complete(ERR_IOFAIL);
+    }
+}
+
+// Check whether the command in progress has finished, and start the next one
+static void sdmmc_async_service (void)
+{
+    if (Sdmmc_Queue_Running) {
+        ALT_STATUS_CODE sdmmcStat = alt_sdmmc_transfer_is_complete();
+        if (sdmmcStat == ALT_E_FALSE) {
+            return; //Still in progress
+        }
+        DiskSdmmcRequest_t* req = Sdmmc_Queue[Sdmmc_Queue_Head];
+        Sdmmc_Queue_Running = false;
+        if (sdmmcStat != ALT_E_TRUE) {
+            printf("FatFS: Async Sec %u-%u/%u Err %d.\n", (UINT)(req->done + 1), (UINT)(req->done + req->blocks), (UINT)req->count, sdmmcStat);
+            sdmmc_async_complete(ERR_IOFAIL);
+        } else {
+            req->done += req->blocks;
+            if (req->done >= req->count) {
+                sdmmc_async_complete(ERR_SUCCESS);
+            }
+        }
+    }
+    sdmmc_async_start();
+}
+
+// SD/MMC interrupt handler
+static void __irq sdmmc_irqHandler (
+    HPSIRQSource interruptID,
+    void* param,
+    bool* handled
+)
+{
+    if (Sdmmc_Queue_Running && !Sdmmc_Sync_Active) {
+        sdmmc_async_service();
+    } else {
+        //Command sent by a FatFS access, which polls for completion. Silence
+        //the interrupt until the next command.
+        alt_sdmmc_int_signal_disable();
+    }
+    *handled = true;
+}
+
+// Wait for queued requests to complete, and keep the card for a FatFS access
+static void sdmmc_sync_begin (void)
+{
+    while (true) {
+        HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+        sdmmc_async_service();
+        if (!Sdmmc_Queue_Count) {
+            Sdmmc_Sync_Active = true;
+            HPS_IRQ_globalEnable(IS_SUCCESS(irqStatus));
+            return;
+        }
+        HPS_IRQ_globalEnable(IS_SUCCESS(irqStatus));
+        HPS_ResetWatchdog();
+    }
+}
+
+// Release the card after a FatFS access, starting any requests queued meanwhile
+static void sdmmc_sync_end (void)
+{
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    Sdmmc_Sync_Active = false;
+    sdmmc_async_start();
+    HPS_IRQ_globalEnable(IS_SUCCESS(irqStatus));
+}
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Get Drive Status                                                      */
 /*-----------------------------------------------------------------------*/
 
-DSTATUS disk_status (
-	BYTE pdrv		/* Physical drive number to identify the drive */
+static DSTATUS sdmmc_status (
+	void* param		/* Unused */
 )
 {
 	DSTATUS stat = 0;
-    if (pdrv != 0) {
-        return STA_NOINIT; //No status if out of range.
-    }
-    
     if (!Sdmmc_Initialised) {
         return STA_NOINIT; //Not initialised yet.
     }
@@ -95,18 +262,49 @@ DSTATUS disk_status (
 /* Inidialize a Drive                                                    */
 /*-----------------------------------------------------------------------*/
 
-DSTATUS disk_initialize (
-	BYTE pdrv				/* Physical drive number to identify the drive */
+// Check the data bus works by reading the first sector. Errors such as data
+// CRC failures show the card can't keep up with the bus width or clock.
+static bool sdmmc_check_bus (void)
+{
+    return alt_sdmmc_block_read(&Card_Info, (void*)Sdmmc_Bounce_Buff, 0, Sdmmc_Sector_Size) == ALT_E_SUCCESS;
+}
+
+// Switch to the widest bus and fastest clock the card supports. If the data
+// bus then fails, high speed mode is dropped first, and then the bus width.
+static bool sdmmc_configure_bus (void)
+{
+    ALT_SDMMC_BUS_WIDTH_t width = ALT_SDMMC_BUS_WIDTH_1;
+    if ((FF_SDMMC_BUS_WIDTH >= ALT_SDMMC_BUS_WIDTH_4) && (Card_Info.scr_bus_widths & ALT_SDMMC_BUS_WIDTH_4)) {
+        width = ALT_SDMMC_BUS_WIDTH_4;
+    }
+    uint32_t speed = (Card_Info.xfer_speed < ALT_SDMMC_DEFAULT_SPEED_MAX) ? Card_Info.xfer_speed : ALT_SDMMC_DEFAULT_SPEED_MAX;
+    bool highSpeed = FF_SDMMC_HIGH_SPEED && Card_Info.high_speed;
+    while (true) {
+        HPS_ResetWatchdog();
+        if ((alt_sdmmc_card_bus_width_set(&Card_Info, width) == ALT_E_SUCCESS) &&
+            (alt_sdmmc_card_speed_set(&Card_Info, highSpeed ? ALT_SDMMC_HIGH_SPEED_MAX : speed) == ALT_E_SUCCESS) &&
+            sdmmc_check_bus()) {
+            return true;
+        }
+        if (highSpeed) {
+            printf("WARN: High speed mode failed. Using default speed.\n");
+            highSpeed = false;
+        } else if (width != ALT_SDMMC_BUS_WIDTH_1) {
+            printf("WARN: %d-bit bus failed. Using 1-bit bus.\n", width);
+            width = ALT_SDMMC_BUS_WIDTH_1;
+        } else {
+            return false;
+        }
+    }
+}
+
+static DSTATUS sdmmc_initialize_card (
+	void* param				/* Unused */
 )
 {
 	DSTATUS stat = 0;
     ALT_SDMMC_CARD_MISC_t card_misc_cfg;
     
-    if (pdrv != 0) {
-        printf("ERROR: Invalid Drive.\n");
-        return STA_NOINIT; //Don't try and initialise if out of range.
-    }
-    
     printf("INFO: System Initialization.\n");
 
     // Setting up SD/MMC
@@ -149,10 +347,6 @@ DSTATUS disk_initialize (
             goto error;
     }
     
-    if(alt_sdmmc_card_bus_width_set(&Card_Info, FF_SDMMC_BUS_WIDTH) != ALT_E_SUCCESS) {
-        goto error;
-    }
-
     if(alt_sdmmc_fifo_param_set((ALT_SDMMC_FIFO_NUM_ENTRIES >> 3) - 1,
                                 (ALT_SDMMC_FIFO_NUM_ENTRIES >> 3), 
                                 (ALT_SDMMC_MULT_TRANS_TXMSIZE1)
@@ -160,21 +354,28 @@ DSTATUS disk_initialize (
         goto error;
     }
 
-    if (alt_sdmmc_card_misc_get(&card_misc_cfg) != ALT_E_SUCCESS) {
-        goto error;
-    }
-
-    printf("INFO: Card width = %d.\n", card_misc_cfg.card_width);
-    printf("INFO: Card block size = %d.\n", (int)card_misc_cfg.block_size);
-    Sdmmc_Block_Size = card_misc_cfg.block_size;
     Sdmmc_Device_Size = ((uint64_t)Card_Info.blk_number_high << 32) + Card_Info.blk_number_low;
     Sdmmc_Device_Size *= Card_Info.max_r_blkln;
     Sdmmc_Sector_Size = (Card_Info.max_r_blkln > 512) ? 512 : Card_Info.max_r_blkln;
-    printf("INFO: Card size = %lld.\n", Sdmmc_Device_Size);
+    printf("INFO: Card size = %u MB.\n", (unsigned int)(Sdmmc_Device_Size >> 20));
 
     if(alt_sdmmc_dma_enable() != ALT_E_SUCCESS) {
         goto error;
     }
+
+    if (!sdmmc_configure_bus()) {
+        goto error;
+    }
+    HPS_ResetWatchdog();
+
+    if (alt_sdmmc_card_misc_get(&card_misc_cfg) != ALT_E_SUCCESS) {
+        goto error;
+    }
+
+    printf("INFO: Card width = %d.\n", card_misc_cfg.card_width);
+    printf("INFO: Card clock = %u kHz.\n", (unsigned int)(alt_sdmmc_card_speed_get() / 1000));
+    printf("INFO: Card block size = %d.\n", (int)card_misc_cfg.block_size);
+    Sdmmc_Block_Size = card_misc_cfg.block_size;
     
     if (alt_sdmmc_card_is_write_protected()) {
         printf("WARN: Card is write protected.\n");
@@ -199,17 +400,14 @@ error:
 /* Read Sector(s)                                                        */
 /*-----------------------------------------------------------------------*/
 
-DRESULT disk_read (
-	BYTE pdrv,		/* Physical drive number to identify the drive */
+static DRESULT sdmmc_read_blocks (
+	void* param,	/* Unused */
 	BYTE *buff,		/* Data buffer to store read data */
 	DWORD sector,	/* Start sector in LBA */
 	UINT count		/* Number of sectors to read */
 )
 {
     // Validate disk condition
-    if (pdrv != 0) {
-        return RES_PARERR; //Don't try if out of range.
-    }
     if (!Sdmmc_Initialised) {
         return RES_NOTRDY; //Not ready.
     }
@@ -218,43 +416,45 @@ DRESULT disk_read (
         return RES_PARERR;
     }
 
-    // 32-bit aligned data buffer for sector reads used if incoming buffer is not aligned.
-    uint32_t alignedBuff[Sdmmc_Sector_Size/sizeof(uint32_t)];
-
-    // Work through each sector to be read
+    // Work through the sectors to be read, as many as possible per command
     UINT remain = count;
     UINT start = sector;
     ALT_STATUS_CODE sdmmcStat;
-    printf("FatFS: Block Read %u Sectors. Start at %u (@ 0x%08x).\n", (UINT)count, (UINT)sector, (UINT)(sector * Sdmmc_Sector_Size));
-    while (remain--) {
-        //Convert current sector to byte address
-        unsigned int address = sector * Sdmmc_Sector_Size;
+    printf("FatFS: Block Read %u Sectors. Start at %u.\n", (UINT)count, (UINT)sector);
+    while (remain) {
+        //Convert current sector to card block number
+        uint32_t block = sdmmc_block(sector);
 
         //Ensure aligned data buffer.
-        const BYTE* readBuff;
-        if (((uint32_t)buff) & 3) {
-            //If the memory buffer is non-aligned to the 32bit boundary, so use our
-            //internal aligned buffer for the read.
-            readBuff = (BYTE*)alignedBuff;
+        BYTE* readBuff;
+        UINT blocks;
+        if (!sdmmc_read_aligned(buff)) {
+            //If the memory buffer is non-aligned to the 32bit boundary, or to a cache
+            //line when the cache is enabled, use our internal aligned buffer for the read.
+            readBuff = (BYTE*)Sdmmc_Bounce_Buff;
+            blocks = sdmmc_run_length(remain, true);
         } else {
-            //Otherwise we can save some time by using the already aligned buffer.
+            //Otherwise we can save some time by using the already aligned buffer,
+            //reading everything in one command as the DMA ring refills as it runs.
             readBuff = buff;
+            blocks = remain;
         }
 
-        sdmmcStat = alt_sdmmc_read(&Card_Info, (void*)readBuff, (void*)address, Sdmmc_Sector_Size);
+        sdmmcStat = alt_sdmmc_block_read(&Card_Info, (void*)readBuff, block, blocks * Sdmmc_Sector_Size);
         if (sdmmcStat != ALT_E_SUCCESS) {
-            printf("FatFS: Sec %u/%u (@ 0x%08x) Read Err %d.\n", (UINT)(sector - start + 1), (UINT)count, (UINT)address, sdmmcStat);
+            printf("FatFS: Sec %u-%u/%u (Blk %u) Read Err %d.\n", (UINT)(sector - start + 1), (UINT)(sector - start + blocks), (UINT)count, (UINT)block, sdmmcStat);
             return RES_ERROR;
         }
 
-        if (((uint32_t)buff) & 3) {
+        if (readBuff != buff) {
             //If it was a non-aligned read, copy from our internal buffer to the user
-            memcpy(buff, alignedBuff, Sdmmc_Sector_Size);
+            MemFast_copy(buff, readBuff, blocks * Sdmmc_Sector_Size);
         }
 
-        // Move on to the next sector
-        sector++;
-        buff += Sdmmc_Sector_Size;
+        // Move on to the next run of sectors
+        sector += blocks;
+        remain -= blocks;
+        buff += blocks * Sdmmc_Sector_Size;
         HPS_ResetWatchdog();
     }
     return RES_OK;
@@ -267,17 +467,14 @@ DRESULT disk_read (
 /*-----------------------------------------------------------------------*/
 // Special write case: if `buff == NULL`, will zero out each sector.
 
-DRESULT disk_write (
-	BYTE pdrv,			/* Physical drive number to identify the drive */
+static DRESULT sdmmc_write_blocks (
+	void* param,		/* Unused */
 	const BYTE *buff,	/* Data to be written */
 	DWORD sector,		/* Start sector in LBA */
 	UINT count			/* Number of sectors to write */
 )
 {
     // Validate disk condition
-    if (pdrv != 0) {
-        return RES_PARERR; //Don't try if out of range.
-    }
     if (!Sdmmc_Initialised) {
         return RES_NOTRDY; //Not ready.
     }
@@ -285,49 +482,53 @@ DRESULT disk_write (
         return RES_WRPRT; //Write protected. Error.
     }
 
-    // 32-bit aligned data buffer for sector writes used if incoming buffer is not aligned.
-    uint32_t alignedBuff[Sdmmc_Sector_Size/sizeof(uint32_t)];
     if (!buff) {
         // If no write buffer, we are going to write 0's, so zero out the aligned buffer
-        memset(alignedBuff, 0, Sdmmc_Sector_Size);
+        MemFast_set(Sdmmc_Bounce_Buff, 0, sizeof(Sdmmc_Bounce_Buff));
     }
     
-    // Work through each sector to be written
+    // Work through the sectors to be written, as many as possible per command
     UINT remain = count;
     UINT start = sector;
     ALT_STATUS_CODE sdmmcStat;
-    printf("FatFS: Block Write %u Sectors. Start at %u (@ 0x%08x).\n", (UINT)count, (UINT)sector, (UINT)(sector * Sdmmc_Sector_Size));
-    while (remain--) {
-        //Convert current sector to byte address
-        unsigned int address = sector * Sdmmc_Sector_Size;
+    printf("FatFS: Block Write %u Sectors. Start at %u.\n", (UINT)count, (UINT)sector);
+    while (remain) {
+        //Convert current sector to card block number
+        uint32_t block = sdmmc_block(sector);
 
         //Ensure aligned data buffer.
         const BYTE* writeBuff;
+        UINT blocks;
         if (!buff) {
             //If no write buffer, use aligned buffer (zero filled)
-            writeBuff = (BYTE*)alignedBuff;
+            writeBuff = (BYTE*)Sdmmc_Bounce_Buff;
+            blocks = sdmmc_run_length(remain, true);
         } else if (((uint32_t)buff) & 3) {
             //If the memory buffer is non-aligned to the 32bit boundary, copy it
             //into our internal correctly aligned buffer
-            memcpy(alignedBuff, buff, Sdmmc_Sector_Size);
+            blocks = sdmmc_run_length(remain, true);
+            MemFast_copy(Sdmmc_Bounce_Buff, buff, blocks * Sdmmc_Sector_Size);
             //Our aligned buffer is the one we want to write
-            writeBuff = (BYTE*)alignedBuff;
+            writeBuff = (BYTE*)Sdmmc_Bounce_Buff;
         } else {
-            //Otherwise we can save some time by using the already aligned buffer.
+            //Otherwise we can save some time by using the already aligned buffer,
+            //writing everything in one command as the DMA ring refills as it runs.
             writeBuff = buff;
+            blocks = remain;
         }
 
-        // Write the sector
-        sdmmcStat = alt_sdmmc_write(&Card_Info, (void*)address, (void*)writeBuff, Sdmmc_Sector_Size);
+        // Write the sectors
+        sdmmcStat = alt_sdmmc_block_write(&Card_Info, block, (void*)writeBuff, blocks * Sdmmc_Sector_Size);
         if (sdmmcStat != ALT_E_SUCCESS) {
-            printf("FatFS: Sec %u/%u (@ 0x%08x) Write Err %d.\n", (UINT)(sector - start + 1), (UINT)count, (UINT)address, sdmmcStat);
+            printf("FatFS: Sec %u-%u/%u (Blk %u) Write Err %d.\n", (UINT)(sector - start + 1), (UINT)(sector - start + blocks), (UINT)count, (UINT)block, sdmmcStat);
             return RES_ERROR;
         }
 
-        // Move on to the next sector
-        sector++;
+        // Move on to the next run of sectors
+        sector += blocks;
+        remain -= blocks;
         if (buff) {
-            buff += Sdmmc_Sector_Size;
+            buff += blocks * Sdmmc_Sector_Size;
         }
         HPS_ResetWatchdog();
     }
@@ -341,60 +542,57 @@ DRESULT disk_write (
 /*-----------------------------------------------------------------------*/
 // Special verify case: if `buff == NULL`, will check that each sector is zeros.
 
-DRESULT disk_verify (
-    BYTE pdrv,          /* Physical drive number to identify the drive */
+static DRESULT sdmmc_verify_blocks (
+    void* param,        /* Unused */
     const BYTE *buff,   /* Data buffer that was written */
     DWORD sector,       /* Start sector in LBA */
     UINT count          /* Number of sectors to verify */
 )
 {
     // Validate disk condition
-    if (pdrv != 0) {
-        return RES_PARERR; //Don't try if out of range.
-    }
     if (!Sdmmc_Initialised) {
         return RES_NOTRDY; //Not ready.
     }
 
-    // 32-bit aligned data buffer for sector reads used if incoming buffer is not aligned.
-    uint32_t alignedBuff[Sdmmc_Sector_Size/sizeof(uint32_t)];
-
-    // Work through each sector to be read
+    // Work through the sectors to be verified, reading as many as fit in the aligned buffer
     UINT remain = count;
     UINT start = sector;
     ALT_STATUS_CODE sdmmcStat;
-    printf("FatFS: Block Verify %u Sectors. Start at %u (@ 0x%08x).\n", (UINT)count, (UINT)sector, (UINT)(sector * Sdmmc_Sector_Size));
-    while (remain--) {
-        //Convert current sector to byte address
-        unsigned int address = sector * Sdmmc_Sector_Size;
+    printf("FatFS: Block Verify %u Sectors. Start at %u.\n", (UINT)count, (UINT)sector);
+    while (remain) {
+        //Convert current sector to card block number
+        uint32_t block = sdmmc_block(sector);
 
-        //Read the sector into the alignedBuff which we will compare against the input buff
-        const BYTE* verifyBuff = (BYTE*)alignedBuff;
+        //Read the sectors into the aligned buffer which we will compare against the input buff
+        const BYTE* verifyBuff = (BYTE*)Sdmmc_Bounce_Buff;
+        UINT blocks = sdmmc_run_length(remain, true);
+        UINT length = blocks * Sdmmc_Sector_Size;
 
-        sdmmcStat = alt_sdmmc_read(&Card_Info, (void*)verifyBuff, (void*)address, Sdmmc_Sector_Size);
+        sdmmcStat = alt_sdmmc_block_read(&Card_Info, (void*)verifyBuff, block, length);
         if (sdmmcStat != ALT_E_SUCCESS) {
-            printf("FatFS: Sec %u/%u (@ 0x%08x) Read Err %d.\n", (UINT)(sector - start + 1), (UINT)count, (UINT)address, sdmmcStat);
+            printf("FatFS: Sec %u-%u/%u (Blk %u) Read Err %d.\n", (UINT)(sector - start + 1), (UINT)(sector - start + blocks), (UINT)count, (UINT)block, sdmmcStat);
             return RES_ERROR;
         }
         if (!buff) {
             // No buffer, verify against being all zeros.
-            for (unsigned int idx = 0; idx < (Sdmmc_Sector_Size/sizeof(uint32_t)); idx++) {
-                if (alignedBuff[idx]) {
+            for (unsigned int idx = 0; idx < (length/sizeof(uint32_t)); idx++) {
+                if (Sdmmc_Bounce_Buff[idx]) {
                     goto verifyError;
                 }
             }
         } else {
-            if (memcmp(buff, verifyBuff, Sdmmc_Sector_Size)) {
+            if (MemFast_compare(buff, verifyBuff, length)) {
 verifyError:
-                printf("FatFS: Sec %u/%u (@ 0x%08x) Verify Err %d.\n", (UINT)(sector - start + 1), (UINT)count, (UINT)address, sdmmcStat);
+                printf("FatFS: Sec %u-%u/%u (Blk %u) Verify Err %d.\n", (UINT)(sector - start + 1), (UINT)(sector - start + blocks), (UINT)count, (UINT)block, sdmmcStat);
                 return RES_ERROR;
             }
         }
 
-        // Move on to the next sector
-        sector++;
+        // Move on to the next run of sectors
+        sector += blocks;
+        remain -= blocks;
         if (buff) {
-            buff += Sdmmc_Sector_Size;
+            buff += length;
         }
         HPS_ResetWatchdog();
     }
@@ -407,17 +605,13 @@ verifyError:
 /*-----------------------------------------------------------------------*/
 // assumes (FF_USE_TRIM == 0)
 
-DRESULT disk_ioctl (
-	BYTE pdrv,		/* Physical drive number (0..) */
+static DRESULT sdmmc_ioctl (
+	void* param,	/* Unused */
 	BYTE cmd,		/* Control code */
 	void *buff		/* Buffer to send/receive control data */
 )
 {
 	
-    if (pdrv != 0) {
-        return RES_PARERR; //Don't try if out of range.
-    }
-    
     if (!Sdmmc_Initialised) {
         return RES_NOTRDY; //Not ready.
     }
@@ -426,10 +620,11 @@ DRESULT disk_ioctl (
         case CTRL_SYNC:
             return RES_OK;
         case GET_SECTOR_COUNT:
-            *((DWORD*)buff) = Sdmmc_Device_Size / Sdmmc_Sector_Size;
+            //Clipped to the 32-bit sector numbers used by FatFS R0.13a (2TB)
+            *((DWORD*)buff) = ((Sdmmc_Device_Size / Sdmmc_Sector_Size) > 0xFFFFFFFF) ? 0xFFFFFFFF : (DWORD)(Sdmmc_Device_Size / Sdmmc_Sector_Size);
             return RES_OK;
         case GET_SECTOR_SIZE:
-            *(DWORD*)buff = Sdmmc_Sector_Size;
+            *(WORD*)buff = Sdmmc_Sector_Size;
             return RES_OK;
         case GET_BLOCK_SIZE:
             *(DWORD*)buff = Sdmmc_Block_Size;
@@ -438,3 +633,157 @@ DRESULT disk_ioctl (
     return RES_PARERR; //Invalid parameter
 }
 
+
+/*-----------------------------------------------------------------------*/
+/* Disk Driver                                                           */
+/*-----------------------------------------------------------------------*/
+// FatFS accesses wait for any asynchronous requests, and hold them off
+// until complete.
+
+static DSTATUS sdmmc_initialize (
+    void* param
+)
+{
+    sdmmc_sync_begin();
+    DSTATUS stat = sdmmc_initialize_card(param);
+    sdmmc_sync_end();
+    return stat;
+}
+
+static DRESULT sdmmc_read (
+    void* param,
+    BYTE *buff,
+    DWORD sector,
+    UINT count
+)
+{
+    sdmmc_sync_begin();
+    DRESULT res = sdmmc_read_blocks(param, buff, sector, count);
+    sdmmc_sync_end();
+    return res;
+}
+
+static DRESULT sdmmc_write (
+    void* param,
+    const BYTE *buff,
+    DWORD sector,
+    UINT count
+)
+{
+    sdmmc_sync_begin();
+    DRESULT res = sdmmc_write_blocks(param, buff, sector, count);
+    sdmmc_sync_end();
+    return res;
+}
+
+static DRESULT sdmmc_verify (
+    void* param,
+    const BYTE *buff,
+    DWORD sector,
+    UINT count
+)
+{
+    sdmmc_sync_begin();
+    DRESULT res = sdmmc_verify_blocks(param, buff, sector, count);
+    sdmmc_sync_end();
+    return res;
+}
+
+
+const DISKIO_DRIVER DiskIo_SDMMC = {
+    .initialize = &sdmmc_initialize,
+    .status     = &sdmmc_status,
+    .read       = &sdmmc_read,
+    .write      = &sdmmc_write,
+    .verify     = &sdmmc_verify,
+    .ioctl      = &sdmmc_ioctl
+};
+
+
+/*-----------------------------------------------------------------------*/
+/* Asynchronous Transfers                                                */
+/*-----------------------------------------------------------------------*/
+
+//Enable or disable interrupt driven completion
+// - Requires the HPS_IRQ driver to have been initialised.
+// - Disabling waits for any queued requests to complete.
+HpsErr_t DiskSdmmc_enableAsync(bool enable) {
+    HpsErr_t status;
+    if (enable == Sdmmc_Async_Irq) return ERR_SUCCESS;
+    if (enable) {
+        status = HPS_IRQ_registerHandler(IRQ_SDMMC, &sdmmc_irqHandler, NULL);
+        if (IS_ERROR(status)) return status;
+        Sdmmc_Async_Irq = true;
+    } else {
+        while (Sdmmc_Queue_Count) {
+            DiskSdmmc_service();
+            HPS_ResetWatchdog();
+        }
+        status = HPS_IRQ_unregisterHandler(IRQ_SDMMC);
+        if (IS_ERROR(status)) return status;
+        Sdmmc_Async_Irq = false;
+    }
+    return ERR_SUCCESS;
+}
+
+//Submit a transfer request
+// - Reads (write=false) count sectors from the card into buff, or writes them from buff.
+// - Returns ERR_BUSY if the queue is full, or ERR_ALIGNMENT if buff is not word aligned,
+//   or for reads with the data cache enabled, not cache line aligned.
+HpsErr_t DiskSdmmc_submit(DiskSdmmcRequest_t* req, bool write, BYTE* buff, DWORD sector, UINT count, DiskSdmmcCallback_t callback, void* param) {
+    if (!req || !buff) return ERR_NULLPTR;
+    if (!Sdmmc_Initialised) return ERR_NOINIT;
+    if (write ? (((uint32_t)buff) & 3) : !sdmmc_read_aligned(buff)) return ERR_ALIGNMENT;
+    if (((uint64_t)sector + count) * Sdmmc_Sector_Size > Sdmmc_Device_Size) return ERR_BEYONDEND;
+    if (write && alt_sdmmc_card_is_write_protected()) return ERR_WRITEPROT;
+    req->write = write;
+    req->buff = buff;
+    req->sector = sector;
+    req->count = count;
+    req->callback = callback;
+    req->param = param;
+    req->done = 0;
+    req->blocks = 0;
+    if (!count) {
+        req->status = ERR_SUCCESS;
+        return ERR_SUCCESS;
+    }
+    req->status = ERR_BUSY;
+    //Add to the tail of the queue, and start it if the card is free
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    if (Sdmmc_Queue_Count >= FF_SDMMC_QUEUE_LENGTH) {
+        HPS_IRQ_globalEnable(IS_SUCCESS(irqStatus));
+        return ERR_BUSY;
+    }
+    Sdmmc_Queue[(Sdmmc_Queue_Head + Sdmmc_Queue_Count) % FF_SDMMC_QUEUE_LENGTH] = req;
+    Sdmmc_Queue_Count++;
+    sdmmc_async_service();
+    HPS_IRQ_globalEnable(IS_SUCCESS(irqStatus));
+    return ERR_SUCCESS;
+}
+
+//Progress queued requests
+// - Only needed if not using interrupts, or to restart the queue after a write.
+void DiskSdmmc_service(void) {
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    sdmmc_async_service();
+    HPS_IRQ_globalEnable(IS_SUCCESS(irqStatus));
+}
+
+//Check the status of a request
+// - Returns ERR_BUSY if still queued or in progress, otherwise its result.
+HpsErr_t DiskSdmmc_requestStatus(DiskSdmmcRequest_t* req) {
+    if (!req) return ERR_NULLPTR;
+    if (IS_BUSY(req->status)) DiskSdmmc_service();
+    return req->status;
+}
+
+//Wait for a request to complete
+// - Returns the result of the request.
+HpsErr_t DiskSdmmc_wait(DiskSdmmcRequest_t* req) {
+    HpsErr_t status;
+    while (IS_BUSY(status = DiskSdmmc_requestStatus(req))) {
+        HPS_ResetWatchdog();
+    }
+    return status;
+}
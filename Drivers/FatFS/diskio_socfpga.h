@@ -0,0 +1,108 @@
+/*
+ * FatFS SD/MMC Asynchronous Transfers
+ * -----------------------------------
+ *
+ * Sector reads and writes to the SD card which run in the
+ * background, for use alongside the DiskIo_SDMMC driver.
+ * Whereas disk_read()/disk_write() wait for every command
+ * to complete, a request submitted here returns at once,
+ * and completes while the processor does other work, such
+ * as decoding the previous block of a stream.
+ *
+ * Requests are queued, and each is started as soon as the
+ * one before has completed. If DiskSdmmc_enableAsync() has
+ * been called, completion is signalled by the SD/MMC
+ * interrupt, and the optional callback is run from the
+ * interrupt handler. Otherwise requests are progressed by
+ * calls to DiskSdmmc_service(), DiskSdmmc_requestStatus()
+ * or DiskSdmmc_wait().
+ *
+ * After a write the card is busy for a while programming
+ * the data. If the card is still busy when the interrupt
+ * completes a write, the next request is started by the
+ * next call to one of the above instead.
+ *
+ * Buffers must be word aligned, and must not be touched
+ * until the request completes. If the data cache is on,
+ * read buffers must also be cache line (32 byte) aligned,
+ * as the cache is invalidated over the whole buffer once
+ * the data arrives. The card must already have
+ * been initialised by mounting the volume. FatFS accesses
+ * through DiskIo_SDMMC wait for queued requests first.
+ *
+ *    DiskSdmmcRequest_t req;
+ *    DiskSdmmc_enableAsync(true);
+ *    DiskSdmmc_submit(&req, false, frame, sector, 64, NULL, NULL);
+ *    ... other work ...
+ *    DiskSdmmc_wait(&req);
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DISKIO_SOCFPGA_H_
+#define DISKIO_SOCFPGA_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+#include "diskio.h"
+
+//Maximum number of requests queued at once
+#ifndef FF_SDMMC_QUEUE_LENGTH
+#define FF_SDMMC_QUEUE_LENGTH 8
+#endif
+
+//Request completion callback
+// - Called from the interrupt handler if asynchronous mode is enabled.
+// - result is ERR_SUCCESS, or the error which ended the request.
+typedef void (*DiskSdmmcCallback_t)(void* param, HpsErr_t result);
+
+//Transfer request
+// - Storage is owned by the caller, and must remain valid until complete.
+typedef struct {
+    bool write;
+    BYTE* buff;
+    DWORD sector;
+    UINT count;
+    DiskSdmmcCallback_t callback;
+    void* param;
+    //Progress
+    volatile HpsErr_t status;  // ERR_BUSY until complete
+    UINT done;                 // Sectors transferred by completed commands
+    UINT blocks;               // Sectors in the current command
+} DiskSdmmcRequest_t;
+
+//Enable or disable interrupt driven completion
+// - Requires the HPS_IRQ driver to have been initialised.
+// - Disabling waits for any queued requests to complete.
+HpsErr_t DiskSdmmc_enableAsync(bool enable);
+
+//Submit a transfer request
+// - Reads (write=false) count sectors from the card into buff, or writes them from buff.
+// - Returns ERR_BUSY if the queue is full, or ERR_ALIGNMENT if buff is not word aligned,
+//   or for reads with the data cache enabled, not cache line aligned.
+HpsErr_t DiskSdmmc_submit(DiskSdmmcRequest_t* req, bool write, BYTE* buff, DWORD sector, UINT count, DiskSdmmcCallback_t callback, void* param);
+
+//Progress queued requests
+// - Only needed if not using interrupts, or to restart the queue after a write.
+void DiskSdmmc_service(void);
+
+//Check the status of a request
+// - Returns ERR_BUSY if still queued or in progress, otherwise its result.
+HpsErr_t DiskSdmmc_requestStatus(DiskSdmmcRequest_t* req);
+
+//Wait for a request to complete
+// - Returns the result of the request.
+HpsErr_t DiskSdmmc_wait(DiskSdmmcRequest_t* req);
+
+#endif /* DISKIO_SOCFPGA_H_ */
@@ -21,6 +21,9 @@
 
 #include "ff.h"			/* Declarations of FatFs API */
 #include "diskio.h"		/* Declarations of device I/O functions */
+#if FF_USE_MEMFAST
+#include "Util/mem_fast.h"	/* Word-wide memory functions */
+#endif
 
 
 /*--------------------------------------------------------------------------
@@ -437,6 +440,62 @@ static BYTE CurrVol;				/* Current drive */
 static FILESEM Files[FF_FS_LOCK];	/* Open object lock semaphores */
 #endif
 
+#if FF_USE_LINKMAP
+#if FF_FS_REENTRANT
+#define LINKMAP_POOLS	FF_VOLUMES	/* A pool for each volume, guarded by the volume lock */
+#else
+#define LINKMAP_POOLS	1
+#endif
+#if FF_LINKMAP_BUDGET / LINKMAP_POOLS < 64
+#error Wrong setting of FF_LINKMAP_BUDGET
+#endif
+typedef struct {
+	DWORD	map[FF_LINKMAP_BUDGET / LINKMAP_POOLS / 4];	/* Cluster link maps */
+	UINT	used;			/* Number of bytes used in the pool */
+	DWORD	use;			/* Use counter for LRU replacement */
+} LINKPOOL;
+static LINKPOOL LinkMap[LINKMAP_POOLS];	/* Pools of cluster link maps shared by the files on a volume */
+#endif
+
+#if FF_USE_DIRHASH
+#if FF_FS_REENTRANT
+#define DIRHASH_POOLS	FF_VOLUMES	/* A pool for each volume, guarded by the volume lock */
+#else
+#define DIRHASH_POOLS	1
+#endif
+#if FF_DIRHASH_BUDGET / DIRHASH_POOLS < 256
+#error Wrong setting of FF_DIRHASH_BUDGET
+#endif
+typedef struct {
+	DWORD	key[FF_DIRHASH_BUDGET / DIRHASH_POOLS / 4];	/* Directory name indexes */
+	UINT	used;			/* Number of bytes used in the pool */
+	DWORD	use;			/* Use counter for LRU replacement */
+} DIRHASHPOOL;
+static DIRHASHPOOL DirHash[DIRHASH_POOLS];	/* Pools of name indexes shared by the directories on a volume */
+#endif
+
+#if FF_USE_FREEMAP && !FF_FS_READONLY
+#if FF_FS_REENTRANT
+#define FREEMAP_POOLS	FF_VOLUMES	/* A pool for each volume, guarded by the volume lock */
+#else
+#define FREEMAP_POOLS	1
+#endif
+#if FF_FREEMAP_BUDGET / FREEMAP_POOLS < 64
+#error Wrong setting of FF_FREEMAP_BUDGET
+#endif
+typedef struct {
+	DWORD	map[FF_FREEMAP_BUDGET / FREEMAP_POOLS / 4];	/* A bit for each cluster from #2 (1:In use) */
+	FATFS*	fs;			/* Volume and its mount ID */
+	WORD	id;
+	BYTE	stat;		/* 0:Not built, 1:Valid, 2:Volume too large for the pool */
+} FREEMAPPOOL;
+static FREEMAPPOOL FreeMap[FREEMAP_POOLS];	/* Pools of free cluster maps */
+#endif
+
+#if FF_USE_STREAM && !FF_USE_EXPAND
+#error FF_USE_STREAM needs FF_USE_EXPAND to be enabled
+#endif
+
 
 
 /*--------------------------------*/
@@ -641,6 +700,14 @@ void st_qword (BYTE* ptr, QWORD val)	/* Store an 8-byte word in little-endian */
 /* String functions                                                      */
 /*-----------------------------------------------------------------------*/
 
+#if FF_USE_MEMFAST
+/* Copy, fill and compare memory blocks a word at a time */
+#define mem_cpy(dst, src, cnt)	MemFast_copy(dst, src, cnt)
+#define mem_mov(dst, src, cnt)	MemFast_move(dst, src, cnt)	/* Blocks may overlap */
+#define mem_set(dst, val, cnt)	MemFast_set(dst, val, cnt)
+#define mem_cmp(dst, src, cnt)	MemFast_compare(dst, src, cnt)	/* ZR:same, NZ:different */
+
+#else
 /* Copy memory to memory */
 static
 void mem_cpy (void* dst, const void* src, UINT cnt)
@@ -656,6 +723,24 @@ void mem_cpy (void* dst, const void* src, UINT cnt)
 }
 
 
+#if FF_USE_LINKMAP || FF_USE_DIRHASH
+/* Move memory to memory, where the blocks may overlap */
+static
+void mem_mov (void* dst, const void* src, UINT cnt)
+{
+	BYTE *d = (BYTE*)dst;
+	const BYTE *s = (const BYTE*)src;
+
+	if (d <= s) {
+		while (cnt--) *d++ = *s++;
+	} else {
+		d += cnt; s += cnt;
+		while (cnt--) *--d = *--s;
+	}
+}
+#endif
+
+
 /* Fill memory block */
 static
 void mem_set (void* dst, int val, UINT cnt)
@@ -681,6 +766,7 @@ int mem_cmp (const void* dst, const void* src, UINT cnt)	/* ZR:same, NZ:differen
 
 	return r;
 }
+#endif
 
 
 /* Check if chr is contained in the string */
@@ -1211,6 +1297,243 @@ DWORD get_fat (		/* 0xFFFFFFFF:Disk error, 1:Internal error, 2..0x7FFFFFFF:Clust
 
 
 
+#if FF_USE_LINKMAP || FF_USE_DIRHASH || (FF_USE_FREEMAP && !FF_FS_READONLY)
+/* Get the pool number of a volume (the logical drive if each has its own) */
+static
+UINT pool_vol (
+	FATFS* fs		/* Volume */
+)
+{
+#if FF_FS_REENTRANT
+	UINT vol = 0;
+
+	while (vol < FF_VOLUMES - 1 && FatFs[vol] != fs) vol++;
+	return vol;
+#else
+	(void)fs;
+	return 0;
+#endif
+}
+#endif
+
+
+
+#if FF_USE_FREEMAP && !FF_FS_READONLY
+/*-----------------------------------------------------------------------*/
+/* FAT access - Map of free clusters                                     */
+/*-----------------------------------------------------------------------*/
+/* The map holds a bit for each cluster, set while it is in use, read from
+/  the FAT or allocation bitmap once and then kept in sync by put_fat() and
+/  change_bitmap(). Free clusters are found a word at a time. */
+
+#if defined(__GNUC__) || defined(__clang__)
+#define FMAP_CTZ(w)	((UINT)__builtin_ctz(w))	/* Number of trailing zeros (w != 0) */
+#else
+static
+UINT FMAP_CTZ (DWORD w)
+{
+	UINT n = 0;
+
+	while (!(w & 1)) { w >>= 1; n++; }
+	return n;
+}
+#endif
+
+
+/* Get the map of a volume, if it has been built */
+static
+DWORD* fmap_cur (
+	FATFS* fs		/* Volume */
+)
+{
+	FREEMAPPOOL *pool = &FreeMap[pool_vol(fs)];
+
+	return (pool->stat == 1 && pool->fs == fs && pool->id == fs->id) ? pool->map : 0;
+}
+
+
+/* Set or clear the bits of a block of clusters */
+static
+void fmap_set (
+	FATFS* fs,		/* Volume */
+	DWORD clst,		/* First cluster */
+	DWORD ncl,		/* Number of clusters */
+	int bv			/* 1:In use, 0:Free */
+)
+{
+	DWORD *map = fmap_cur(fs), bm;
+
+	if (!map) return;
+	for (clst -= 2; ncl; clst++, ncl--) {
+		bm = (DWORD)1 << (clst % 32);
+		if (bv) {
+			map[clst / 32] |= bm;
+		} else {
+			map[clst / 32] &= ~bm;
+		}
+	}
+}
+
+
+/* Drop the map of a volume, when it may be out of sync with the disk */
+static
+void fmap_drop (
+	FATFS* fs		/* Volume */
+)
+{
+	if (fmap_cur(fs)) FreeMap[pool_vol(fs)].stat = 0;
+}
+
+
+/* Find the next bit with a value */
+static
+DWORD fmap_next (	/* Bit found, or end */
+	const DWORD* map,
+	DWORD pos,		/* Bit to search from */
+	DWORD end,		/* Bit to search up to */
+	int bv			/* Value to find */
+)
+{
+	DWORD w, inv = bv ? 0 : 0xFFFFFFFF;
+
+	while (pos < end) {
+		w = ((map[pos / 32] ^ inv) & 0xFFFFFFFF) >> (pos % 32);	/* Bits with the value are 1 */
+		if (w) {
+			pos += FMAP_CTZ(w);
+			return pos < end ? pos : end;
+		}
+		pos = (pos | 31) + 1;	/* Next word */
+	}
+	return end;
+}
+
+
+/* Find a run of free bits */
+static
+DWORD fmap_run (	/* First bit of the run, or end */
+	const DWORD* map,
+	DWORD pos,		/* Bit to search from */
+	DWORD end,		/* Bit to search up to */
+	DWORD ncl		/* Length of the run */
+)
+{
+	DWORD e;
+
+	for (;;) {
+		pos = fmap_next(map, pos, end, 0);			/* Next free bit */
+		if (pos >= end || end - pos < ncl) return end;
+		e = fmap_next(map, pos, pos + ncl, 1);		/* Next bit in use, within the run */
+		if (e - pos >= ncl) return pos;
+		pos = e;
+	}
+}
+
+
+/* Find a contiguous free cluster block, as find_bitmap() */
+static
+DWORD fmap_find (	/* 0:Not found, 2..:Cluster block found */
+	const DWORD* map,
+	FATFS* fs,		/* Volume */
+	DWORD clst,		/* Cluster number to scan from */
+	DWORD ncl		/* Number of contiguous clusters to find (1..) */
+)
+{
+	DWORD n = fs->n_fatent - 2, s = clst - 2, e, pos;
+
+	if (s >= n) s = 0;
+	pos = fmap_run(map, s, n, ncl);				/* Search from the cluster to the end */
+	if (pos >= n) {
+		e = (s + ncl - 1 < n) ? s + ncl - 1 : n;
+		pos = fmap_run(map, 0, e, ncl);			/* Then from the top (with wrap-around) */
+		if (pos >= e) return 0;
+	}
+	return pos + 2;
+}
+
+
+/* Get the map of a volume, building it on first use */
+static
+DWORD* fmap_get (	/* 0:No map (too large, or disk error) */
+	FATFS* fs		/* Volume */
+)
+{
+	FREEMAPPOOL *pool = &FreeMap[pool_vol(fs)];
+	DWORD *map = pool->map, ncl = fs->n_fatent - 2, clst, sect, stat, nfree = 0;
+	UINT i;
+	FFOBJID obj;
+
+
+	if (pool->fs == fs && pool->id == fs->id && pool->stat != 0) {
+		return (pool->stat == 1) ? map : 0;
+	}
+	pool->fs = fs; pool->id = fs->id;
+	if ((ncl + 31) / 32 > sizeof pool->map / sizeof (DWORD)) {	/* Too large for the pool? */
+		pool->stat = 2;
+		return 0;
+	}
+	pool->stat = 0;
+	mem_set(map, 0, (ncl + 31) / 32 * sizeof (DWORD));
+
+#if FF_FS_EXFAT
+	if (fs->fs_type == FS_EXFAT) {	/* exFAT: Copy the allocation bitmap */
+		sect = fs->database;		/* Assuming bitmap starts at cluster 2 */
+		for (clst = 0; clst < ncl; clst += 32) {
+			i = clst / 8 % SS(fs);	/* Offset in the sector */
+			if (i == 0 && move_window(fs, sect++) != FR_OK) return 0;
+			map[clst / 32] = ld_dword(fs->win + i);
+		}
+		if (ncl % 32) map[ncl / 32] &= ((DWORD)1 << (ncl % 32)) - 1;	/* Bits past the last cluster */
+		for (clst = 0; clst < ncl; clst++) {
+			if (!(map[clst / 32] & ((DWORD)1 << (clst % 32)))) nfree++;
+		}
+	} else
+#endif
+	if (fs->fs_type == FS_FAT12) {	/* FAT12: Get bit field FAT entries */
+		obj.fs = fs;
+		for (clst = 0; clst < ncl; clst++) {
+			stat = get_fat(&obj, clst + 2);
+			if (stat == 0xFFFFFFFF || stat == 1) return 0;
+			if (stat == 0) {
+				nfree++;
+			} else {
+				map[clst / 32] |= (DWORD)1 << (clst % 32);
+			}
+		}
+	} else {						/* FAT16/32: Scan WORD/DWORD FAT entries */
+		sect = fs->fatbase;			/* Top of the FAT */
+		i = 0;						/* Offset in the sector */
+		for (clst = 0; clst < fs->n_fatent; clst++) {
+			if (i == 0 && move_window(fs, sect++) != FR_OK) return 0;
+			if (fs->fs_type == FS_FAT16) {
+				stat = ld_word(fs->win + i);
+				i += 2;
+			} else {
+				stat = ld_dword(fs->win + i) & 0x0FFFFFFF;
+				i += 4;
+			}
+			i %= SS(fs);
+			if (clst < 2) continue;	/* Reserved entries */
+			if (stat == 0) {
+				nfree++;
+			} else {
+				map[(clst - 2) / 32] |= (DWORD)1 << ((clst - 2) % 32);
+			}
+		}
+	}
+
+	pool->stat = 1;
+	if (fs->free_clst != nfree) {	/* The free cluster count is now exact */
+		fs->free_clst = nfree;
+		fs->fsi_flag |= 1;
+	}
+	return map;
+}
+
+#endif	/* FF_USE_FREEMAP && !FF_FS_READONLY */
+
+
+
+
 #if !FF_FS_READONLY
 /*-----------------------------------------------------------------------*/
 /* FAT access - Change value of a FAT entry                              */
@@ -1264,6 +1587,11 @@ FRESULT put_fat (	/* FR_OK(0):succeeded, !=0:error */
 			fs->wflag = 1;
 			break;
 		}
+#if FF_USE_FREEMAP
+		if (res == FR_OK && (!FF_FS_EXFAT || fs->fs_type != FS_EXFAT)) {	/* Track allocation on FAT (exFAT uses the bitmap) */
+			fmap_set(fs, clst, 1, val != 0);
+		}
+#endif
 	}
 	return res;
 }
@@ -1336,15 +1664,28 @@ FRESULT change_bitmap (
 	DWORD sect;
 
 
+#if FF_USE_FREEMAP
+	fmap_set(fs, clst, ncl, bv);	/* Dropped below if the change fails */
+#endif
 	clst -= 2;	/* The first bit corresponds to cluster #2 */
 	sect = fs->database + clst / 8 / SS(fs);	/* Sector address (assuming bitmap is located top of the cluster heap) */
 	i = clst / 8 % SS(fs);						/* Byte offset in the sector */
 	bm = 1 << (clst % 8);						/* Bit mask in the byte */
 	for (;;) {
-		if (move_window(fs, sect++) != FR_OK) return FR_DISK_ERR;
+		if (move_window(fs, sect++) != FR_OK) {
+#if FF_USE_FREEMAP
+			fmap_drop(fs);
+#endif
+			return FR_DISK_ERR;
+		}
 		do {
 			do {
-				if (bv == (int)((fs->win[i] & bm) != 0)) return FR_INT_ERR;	/* Is the bit expected value? */
+				if (bv == (int)((fs->win[i] & bm) != 0)) {	/* Is the bit expected value? */
+#if FF_USE_FREEMAP
+					fmap_drop(fs);
+#endif
+					return FR_INT_ERR;
+				}
 				fs->win[i] ^= bm;	/* Flip the bit */
 				fs->wflag = 1;
 				if (--ncl == 0) return FR_OK;	/* All bits processed? */
@@ -1406,6 +1747,295 @@ FRESULT fill_last_frag (
 
 
 
+#if FF_USE_LINKMAP
+/*-----------------------------------------------------------------------*/
+/* FAT handling - Cache of cluster link maps                             */
+/*-----------------------------------------------------------------------*/
+/* A link map lists the fragments at the top of a file's cluster chain, as
+/  pairs of the cluster index in the file and the cluster#, so the cluster
+/  at any index it covers is found by a binary search. A map is extended by
+/  the seeks which follow the chain past its end, so it costs no more disk
+/  reads than following the chain. Maps are packed in a pool, with the map
+/  in use moved to the end so it can grow, and the least recently used
+/  evicted to make space. At re-entrant configuration each volume has its
+/  own pool, so that the volume lock also guards its maps. */
+
+typedef struct {
+	FATFS*	fs;			/* Volume and its mount ID */
+	WORD	id;
+	DWORD	sclust;		/* Top of the chain */
+	DWORD	nclust;		/* Number of clusters covered */
+	DWORD	nfrag;		/* Number of fragments (index/cluster# pairs follow) */
+	DWORD	use;		/* Last use for LRU replacement */
+} LINKMAP;
+
+#define LINKMAP_SIZE(nfrag)	(sizeof (LINKMAP) + (nfrag) * 2 * sizeof (DWORD))
+#define LINKMAP_END(pool)	((LINKMAP*)((BYTE*)(pool)->map + (pool)->used))
+#define LINKMAP_NEXT(map)	((LINKMAP*)((BYTE*)(map) + LINKMAP_SIZE((map)->nfrag)))
+
+
+/* Get the pool of a volume */
+static
+LINKPOOL* lmap_pool (
+	FATFS* fs		/* Volume */
+)
+{
+	return &LinkMap[pool_vol(fs)];
+}
+
+
+/* Reverse a memory block */
+static
+void lmap_reverse (BYTE* p, UINT cnt)
+{
+	BYTE *q = p + cnt, b;
+
+	while (p < --q) {
+		b = *p; *p++ = *q; *q = b;
+	}
+}
+
+
+/* Remove a map from the pool */
+static
+void lmap_remove (LINKPOOL* pool, LINKMAP* map)
+{
+	UINT sz = LINKMAP_SIZE(map->nfrag);
+
+	mem_mov(map, (BYTE*)map + sz, (UINT)((BYTE*)LINKMAP_END(pool) - ((BYTE*)map + sz)));
+	pool->used -= sz;
+}
+
+
+/* Evict the least recently used map */
+static
+int lmap_evict (	/* 0:Nothing to evict */
+	LINKPOOL* pool,	/* Pool */
+	LINKMAP* keep	/* Map which must be kept (at the end of the pool) */
+)
+{
+	LINKMAP *map, *lru = 0;
+
+
+	for (map = (LINKMAP*)pool->map; map < LINKMAP_END(pool); map = LINKMAP_NEXT(map)) {
+		if (map != keep && (!lru || map->use < lru->use)) lru = map;
+	}
+	if (!lru) return 0;
+	lmap_remove(pool, lru);
+	return 1;
+}
+
+
+#if !FF_FS_READONLY
+/* Remove the maps of a chain as it is shortened or deleted */
+static
+void lmap_invalidate (
+	FATFS* fs,		/* Volume */
+	DWORD sclust	/* Top of the chain */
+)
+{
+	LINKPOOL *pool = lmap_pool(fs);
+	LINKMAP *map = (LINKMAP*)pool->map;
+
+	while (map < LINKMAP_END(pool)) {
+		if (map->fs == fs && map->sclust == sclust) {
+			lmap_remove(pool, map);
+		} else {
+			map = LINKMAP_NEXT(map);
+		}
+	}
+}
+#endif
+
+
+/* Get the map of an object, extended to cover a cluster index if possible */
+static
+LINKMAP* lmap_get (	/* 0:Map not usable (following the chain is as fast) */
+	FFOBJID* obj,	/* Object with a FAT chain */
+	DWORD icl,		/* Index of the cluster following the chain would start from */
+	DWORD ncl		/* Index of the cluster to be found */
+)
+{
+	FATFS *fs = obj->fs;
+	LINKPOOL *pool = lmap_pool(fs);
+	LINKMAP *map;
+	DWORD cl, pcl, *tbl;
+	UINT sz;
+
+
+	for (map = (LINKMAP*)pool->map; map < LINKMAP_END(pool); map = LINKMAP_NEXT(map)) {	/* Find existing map */
+		if (map->fs == fs && map->id == obj->id && map->sclust == obj->sclust) break;
+	}
+	if (map < LINKMAP_END(pool)) {
+		if (map->nclust - 1 < icl) return 0;	/* Map ends before the current cluster */
+		sz = LINKMAP_SIZE(map->nfrag);			/* Move the map to the end of the pool */
+		lmap_reverse((BYTE*)map, sz);
+		lmap_reverse((BYTE*)map + sz, (UINT)((BYTE*)LINKMAP_END(pool) - ((BYTE*)map + sz)));
+		lmap_reverse((BYTE*)map, (UINT)((BYTE*)LINKMAP_END(pool) - (BYTE*)map));
+		map = (LINKMAP*)((BYTE*)LINKMAP_END(pool) - sz);
+	} else {
+		if (icl != 0) return 0;		/* Build a map only when following the chain from the top */
+		while (pool->used + LINKMAP_SIZE(1) > sizeof pool->map) lmap_evict(pool, 0);
+		map = LINKMAP_END(pool);
+		map->fs = fs; map->id = obj->id; map->sclust = obj->sclust;
+		map->nclust = map->nfrag = 0;
+		pool->used += LINKMAP_SIZE(0);
+	}
+	map->use = ++pool->use;
+
+	/* Follow the chain from the end of the map to the cluster to be found */
+	tbl = (DWORD*)(map + 1) + (map->nfrag - 1) * 2;	/* Last fragment */
+	pcl = map->nfrag ? tbl[1] + map->nclust - 1 - tbl[0] : 0;
+	while (map->nclust <= ncl) {
+		cl = map->nfrag ? get_fat(obj, pcl) : obj->sclust;
+		if (cl == 0xFFFFFFFF || cl < 2 || cl >= fs->n_fatent) break;	/* Error or end of chain */
+		if (map->nclust >= fs->n_fatent) break;		/* Chain loops (broken FAT) */
+		if (!map->nfrag || cl != pcl + 1) {			/* Start a new fragment */
+			while (pool->used + 2 * sizeof (DWORD) > sizeof pool->map) {
+				sz = LINKMAP_SIZE(map->nfrag);
+				if (!lmap_evict(pool, map)) break;
+				map = (LINKMAP*)((BYTE*)LINKMAP_END(pool) - sz);
+			}
+			if (pool->used + 2 * sizeof (DWORD) > sizeof pool->map) break;	/* Pool full, map the top of the chain only */
+			tbl = (DWORD*)(map + 1) + map->nfrag * 2;
+			tbl[0] = map->nclust; tbl[1] = cl;
+			map->nfrag++;
+			pool->used += 2 * sizeof (DWORD);
+		}
+		map->nclust++;
+		pcl = cl;
+	}
+	return map->nclust ? map : 0;
+}
+
+
+/* Get the cluster# at an index in the chain */
+static
+DWORD lmap_clust (
+	LINKMAP* map,	/* Link map */
+	DWORD idx		/* Cluster index from top of the chain (< nclust) */
+)
+{
+	DWORD *tbl = (DWORD*)(map + 1);
+	DWORD lo = 0, hi = map->nfrag - 1, mid;
+
+	while (lo < hi) {	/* Find the last fragment which starts at or before idx */
+		mid = (lo + hi + 1) / 2;
+		if (tbl[mid * 2] <= idx) {
+			lo = mid;
+		} else {
+			hi = mid - 1;
+		}
+	}
+	return tbl[lo * 2 + 1] + idx - tbl[lo * 2];
+}
+
+#endif	/* FF_USE_LINKMAP */
+
+
+
+#if FF_USE_DIRHASH
+/*-----------------------------------------------------------------------*/
+/* Directory handling - Pool of directory name indexes                   */
+/*-----------------------------------------------------------------------*/
+/* A name index lists a hash of each name in a directory with the index of
+/  its first entry, sorted by hash, so the entries which may hold a name are
+/  found by a binary search. Indexes are packed in a pool, and the least
+/  recently used evicted to make space. At re-entrant configuration each
+/  volume has its own pool, so that the volume lock also guards its indexes. */
+
+typedef struct {
+	FATFS*	fs;			/* Volume and its mount ID */
+	WORD	id;
+	WORD	full;		/* 1:Directory too large to index */
+	DWORD	sclust;		/* Directory start cluster (0:FAT12/16 root directory) */
+	DWORD	nkey;		/* Number of keys (hash << 16 | entry index, ascending) that follow */
+	DWORD	use;		/* Last use for LRU replacement */
+} DIRHASH;
+
+#define DIRHASH_SIZE(nkey)	(sizeof (DIRHASH) + (nkey) * sizeof (DWORD))
+#define DIRHASH_END(pool)	((DIRHASH*)((BYTE*)(pool)->key + (pool)->used))
+#define DIRHASH_NEXT(idx)	((DIRHASH*)((BYTE*)(idx) + DIRHASH_SIZE((idx)->nkey)))
+
+
+/* Get the pool of a volume */
+static
+DIRHASHPOOL* dhash_pool (
+	FATFS* fs		/* Volume */
+)
+{
+	return &DirHash[pool_vol(fs)];
+}
+
+
+/* Get the start cluster which identifies a directory */
+static
+DWORD dhash_clust (
+	DIR* dp			/* Directory object */
+)
+{
+	FATFS *fs = dp->obj.fs;
+
+	return (dp->obj.sclust == 0 && fs->fs_type >= FS_FAT32) ? fs->dirbase : dp->obj.sclust;	/* The root directory may be given either way */
+}
+
+
+/* Remove an index from the pool */
+static
+void dhash_remove (DIRHASHPOOL* pool, DIRHASH* idx)
+{
+	UINT sz = DIRHASH_SIZE(idx->nkey);
+
+	mem_mov(idx, (BYTE*)idx + sz, (UINT)((BYTE*)DIRHASH_END(pool) - ((BYTE*)idx + sz)));
+	pool->used -= sz;
+}
+
+
+/* Evict the least recently used index */
+static
+int dhash_evict (	/* 0:Nothing to evict */
+	DIRHASHPOOL* pool,	/* Pool */
+	DIRHASH* keep	/* Index which must be kept (at the end of the pool) */
+)
+{
+	DIRHASH *idx, *lru = 0;
+
+
+	for (idx = (DIRHASH*)pool->key; idx < DIRHASH_END(pool); idx = DIRHASH_NEXT(idx)) {
+		if (idx != keep && (!lru || idx->use < lru->use)) lru = idx;
+	}
+	if (!lru) return 0;
+	dhash_remove(pool, lru);
+	return 1;
+}
+
+
+#if !FF_FS_READONLY
+/* Remove the index of a directory as it is modified or deleted */
+static
+void dhash_invalidate (
+	FATFS* fs,		/* Volume */
+	DWORD sclust	/* Directory start cluster */
+)
+{
+	DIRHASHPOOL *pool = dhash_pool(fs);
+	DIRHASH *idx = (DIRHASH*)pool->key;
+
+	while (idx < DIRHASH_END(pool)) {
+		if (idx->fs == fs && idx->sclust == sclust) {
+			dhash_remove(pool, idx);
+		} else {
+			idx = DIRHASH_NEXT(idx);
+		}
+	}
+}
+#endif
+
+#endif	/* FF_USE_DIRHASH */
+
+
+
+
 #if !FF_FS_READONLY
 /*-----------------------------------------------------------------------*/
 /* FAT handling - Remove a cluster chain                                 */
@@ -1429,6 +2059,15 @@ FRESULT remove_chain (	/* FR_OK(0):succeeded, !=0:error */
 
 	if (clst < 2 || clst >= fs->n_fatent) return FR_INT_ERR;	/* Check if in valid range */
 
+#if FF_USE_LINKMAP
+	lmap_invalidate(fs, obj->sclust);	/* Link maps of the chain are no longer valid */
+	lmap_invalidate(fs, clst);
+#endif
+#if FF_USE_DIRHASH
+	dhash_invalidate(fs, obj->sclust);	/* Nor is the index of a directory being removed */
+	dhash_invalidate(fs, clst);
+#endif
+
 	/* Mark the previous cluster 'EOC' on the FAT if it exists */
 	if (pclst != 0 && (!FF_FS_EXFAT || fs->fs_type != FS_EXFAT || obj->stat != 2)) {
 		res = put_fat(fs, pclst, 0xFFFFFFFF);
@@ -1514,6 +2153,9 @@ DWORD create_chain (	/* 0:No free cluster, 1:Internal error, 0xFFFFFFFF:Disk err
 	DWORD cs, ncl, scl;
 	FRESULT res;
 	FATFS *fs = obj->fs;
+#if FF_USE_FREEMAP
+	DWORD *map;
+#endif
 
 
 	if (clst == 0) {	/* Create a new chain */
@@ -1528,10 +2170,18 @@ DWORD create_chain (	/* 0:No free cluster, 1:Internal error, 0xFFFFFFFF:Disk err
 		scl = clst;							/* Cluster to start to find */
 	}
 	if (fs->free_clst == 0) return 0;		/* No free cluster */
+#if FF_USE_FREEMAP
+	map = fmap_get(fs);						/* Map of free clusters (built on first use) */
+	if (map && fs->free_clst == 0) return 0;
+#endif
 
 #if FF_FS_EXFAT
 	if (fs->fs_type == FS_EXFAT) {	/* On the exFAT volume */
+#if FF_USE_FREEMAP
+		ncl = map ? fmap_find(map, fs, scl, 1) : find_bitmap(fs, scl, 1);	/* Find a free cluster */
+#else
 		ncl = find_bitmap(fs, scl, 1);				/* Find a free cluster */
+#endif
 		if (ncl == 0 || ncl == 0xFFFFFFFF) return ncl;	/* No free cluster or hard error? */
 		res = change_bitmap(fs, ncl, 1, 1);			/* Mark the cluster 'in use' */
 		if (res == FR_INT_ERR) return 1;
@@ -1557,6 +2207,22 @@ DWORD create_chain (	/* 0:No free cluster, 1:Internal error, 0xFFFFFFFF:Disk err
 #endif
 	{	/* On the FAT/FAT32 volume */
 		ncl = 0;
+#if FF_USE_FREEMAP
+		if (map) {								/* Find a free cluster in the map */
+			if (scl == clst) {					/* Stretching an existing chain? */
+				ncl = (scl + 1 < fs->n_fatent) ? scl + 1 : 2;	/* Take the next cluster if it is free */
+				if (map[(ncl - 2) / 32] & ((DWORD)1 << ((ncl - 2) % 32))) {
+					cs = fs->last_clst;			/* Start at suggested cluster if it is valid */
+					if (cs >= 2 && cs < fs->n_fatent) scl = cs;
+					ncl = 0;
+				}
+			}
+			if (ncl == 0) {
+				ncl = fmap_find(map, fs, scl + 1, 1);
+				if (ncl == 0) return 0;			/* No free cluster found? */
+			}
+		} else
+#endif
 		if (scl == clst) {						/* Stretching an existing chain? */
 			ncl = scl + 1;						/* Test if next cluster is free */
 			if (ncl >= fs->n_fatent) ncl = 2;
@@ -1801,6 +2467,9 @@ FRESULT dir_alloc (	/* FR_OK(0):succeeded, !=0:error */
 	FATFS *fs = dp->obj.fs;
 
 
+#if FF_USE_DIRHASH
+	dhash_invalidate(fs, dhash_clust(dp));	/* The name index of the directory is no longer valid */
+#endif
 	res = dir_sdi(dp, 0);
 	if (res == FR_OK) {
 		n = 0;
@@ -2423,9 +3092,33 @@ FRESULT dir_read (
 /* Directory handling - Find an object in the directory                  */
 /*-----------------------------------------------------------------------*/
 
+#if FF_FS_EXFAT
 static
-FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
-	DIR* dp			/* Pointer to the directory object with the file name */
+int xdir_cmp_name (	/* 1:matched, 0:not matched */
+	FATFS* fs,		/* Filesystem object with the entry block in dirbuf and the name in lfnbuf */
+	WORD hash		/* Hash value of the name to find */
+)
+{
+	BYTE nc;
+	UINT di, ni;
+
+#if FF_MAX_LFN < 255
+	if (fs->dirbuf[XDIR_NumName] > FF_MAX_LFN) return 0;			/* Skip comparison if inaccessible object name */
+#endif
+	if (ld_word(fs->dirbuf + XDIR_NameHash) != hash) return 0;	/* Skip comparison if hash mismatched */
+	for (nc = fs->dirbuf[XDIR_NumName], di = SZDIRE * 2, ni = 0; nc; nc--, di += 2, ni++) {	/* Compare the name */
+		if ((di % SZDIRE) == 0) di += 2;
+		if (ff_wtoupper(ld_word(fs->dirbuf + di)) != ff_wtoupper(fs->lfnbuf[ni])) break;
+	}
+	return (int)(nc == 0 && !fs->lfnbuf[ni]);	/* Name matched? */
+}
+#endif
+
+
+static
+FRESULT dir_scan (	/* FR_OK(0):succeeded, !=0:error */
+	DIR* dp,		/* Pointer to the directory object with the file name (FAT/FAT32) */
+	int one			/* 0:Scan to the end of the directory, 1:Stop at the first SFN entry */
 )
 {
 	FRESULT res;
@@ -2435,29 +3128,6 @@ FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
 	BYTE a, ord, sum;
 #endif
 
-	res = dir_sdi(dp, 0);			/* Rewind directory object */
-	if (res != FR_OK) return res;
-#if FF_FS_EXFAT
-	if (fs->fs_type == FS_EXFAT) {	/* On the exFAT volume */
-		BYTE nc;
-		UINT di, ni;
-		WORD hash = xname_sum(fs->lfnbuf);		/* Hash value of the name to find */
-
-		while ((res = dir_read_file(dp)) == FR_OK) {	/* Read an item */
-#if FF_MAX_LFN < 255
-			if (fs->dirbuf[XDIR_NumName] > FF_MAX_LFN) continue;			/* Skip comparison if inaccessible object name */
-#endif
-			if (ld_word(fs->dirbuf + XDIR_NameHash) != hash) continue;	/* Skip comparison if hash mismatched */
-			for (nc = fs->dirbuf[XDIR_NumName], di = SZDIRE * 2, ni = 0; nc; nc--, di += 2, ni++) {	/* Compare the name */
-				if ((di % SZDIRE) == 0) di += 2;
-				if (ff_wtoupper(ld_word(fs->dirbuf + di)) != ff_wtoupper(fs->lfnbuf[ni])) break;
-			}
-			if (nc == 0 && !fs->lfnbuf[ni]) break;	/* Name matched? */
-		}
-		return res;
-	}
-#endif
-	/* On the FAT/FAT32 volume */
 #if FF_USE_LFN
 	ord = sum = 0xFF; dp->blk_ofs = 0xFFFFFFFF;	/* Reset LFN sequence */
 #endif
@@ -2485,11 +3155,13 @@ FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
 				if (ord == 0 && sum == sum_sfn(dp->dir)) break;	/* LFN matched? */
 				if (!(dp->fn[NSFLAG] & NS_LOSS) && !mem_cmp(dp->dir, dp->fn, 11)) break;	/* SFN matched? */
 				ord = 0xFF; dp->blk_ofs = 0xFFFFFFFF;	/* Reset LFN sequence */
+				if (one) { res = FR_NO_FILE; break; }	/* Not in this entry block */
 			}
 		}
 #else		/* Non LFN configuration */
 		dp->obj.attr = dp->dir[DIR_Attr] & AM_MASK;
 		if (!(dp->dir[DIR_Attr] & AM_VOL) && !mem_cmp(dp->dir, dp->fn, 11)) break;	/* Is it a valid entry? */
+		if (one && c != DDEM && !(dp->dir[DIR_Attr] & AM_VOL)) { res = FR_NO_FILE; break; }	/* Not in this entry */
 #endif
 		res = dir_next(dp, 0);	/* Next entry */
 	} while (res == FR_OK);
@@ -2499,6 +3171,296 @@ FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
 
 
 
+#if FF_USE_DIRHASH
+/*-----------------------------------------------------------------------*/
+/* Directory handling - Build and search directory name indexes          */
+/*-----------------------------------------------------------------------*/
+/* Each character is hashed with its position and the results combined, so
+/  that the LFN entries can be hashed in the order they are stored. On FAT,
+/  a name with a valid LFN has keys for both the LFN and the SFN. On exFAT,
+/  the name hash of the entry block is used. */
+
+static
+WORD dhash_chr (	/* Hash of a character at a position in the name */
+	UINT pos,
+	WCHAR wc
+)
+{
+	return (WORD)((((DWORD)wc << 8 ^ pos) * 0x9E3779B1) >> 16);
+}
+
+
+static
+WORD dhash_sfn (	/* Hash of an SFN */
+	const BYTE* dir	/* Pointer to the SFN entry or name */
+)
+{
+	UINT i;
+	WORD h = 0;
+
+	for (i = 0; i < 11; i++) h ^= dhash_chr(i, dir[i]);
+	return h;
+}
+
+
+#if FF_USE_LFN
+static
+WORD dhash_lfn (	/* Hash of the part of an LFN held in an LFN entry */
+	const BYTE* dir	/* Pointer to the LFN entry */
+)
+{
+	UINT i, s = ((dir[LDIR_Ord] & ~LLEF) - 1) * 13;	/* Position of the first character */
+	WCHAR wc;
+	WORD h = 0;
+
+	for (i = 0; i < 13; i++) {
+		wc = ld_word(dir + LfnOfs[i]);
+		if (wc == 0) break;		/* End of the name */
+		h ^= dhash_chr(s + i, ff_wtoupper(wc));
+	}
+	return h;
+}
+#endif
+
+
+/* Add a key to the index being built at the end of the pool */
+static
+DIRHASH* dhash_add (	/* Returns the index, which may have been moved */
+	DIRHASHPOOL* pool,	/* Pool */
+	DIRHASH* idx,	/* Index being built */
+	WORD hash,		/* Hash of the name */
+	DWORD ent		/* Index of the first entry of the name */
+)
+{
+	UINT sz;
+
+
+	if (idx->full) return idx;
+	while (ent > 0xFFFF || pool->used + sizeof (DWORD) > sizeof pool->key) {	/* Make space for the key */
+		sz = DIRHASH_SIZE(idx->nkey);
+		if (ent > 0xFFFF || !dhash_evict(pool, idx)) {	/* Too large, keep an empty index so the directory is scanned */
+			pool->used -= idx->nkey * sizeof (DWORD);
+			idx->nkey = 0; idx->full = 1;
+			return idx;
+		}
+		idx = (DIRHASH*)((BYTE*)DIRHASH_END(pool) - sz);
+	}
+	((DWORD*)(idx + 1))[idx->nkey++] = (DWORD)hash << 16 | ent;
+	pool->used += sizeof (DWORD);
+	return idx;
+}
+
+
+/* Build the name index of a directory */
+static
+FRESULT dhash_build (	/* FR_OK(0):succeeded, !=0:error */
+	DIR* dp,		/* Directory object */
+	DIRHASHPOOL* pool,	/* Pool */
+	DIRHASH** pidx	/* Returns the index, at the end of the pool */
+)
+{
+	FRESULT res;
+	FATFS *fs = dp->obj.fs;
+	DIRHASH *idx;
+	DWORD *key, k;
+	UINT i, j, gap;
+	BYTE c;
+#if FF_USE_LFN
+	BYTE a, ord = 0xFF, sum = 0xFF;
+	DWORD ofs = 0;
+	WORD lh = 0;
+#endif
+
+
+	while (pool->used + DIRHASH_SIZE(0) > sizeof pool->key) dhash_evict(pool, 0);
+	idx = DIRHASH_END(pool);
+	idx->fs = fs; idx->id = fs->id; idx->sclust = dhash_clust(dp);
+	idx->nkey = 0; idx->full = 0;
+	idx->use = ++pool->use;
+	pool->used += DIRHASH_SIZE(0);
+
+	res = dir_sdi(dp, 0);
+#if FF_FS_EXFAT
+	if (fs->fs_type == FS_EXFAT) {	/* On the exFAT volume */
+		while (res == FR_OK && (res = dir_read_file(dp)) == FR_OK) {
+			idx = dhash_add(pool, idx, ld_word(fs->dirbuf + XDIR_NameHash), dp->blk_ofs / SZDIRE);
+		}
+	} else
+#endif
+	{								/* On the FAT/FAT32 volume, index the entries dir_scan() can match */
+		while (res == FR_OK) {
+			res = move_window(fs, dp->sect);
+			if (res != FR_OK) break;
+			c = dp->dir[DIR_Name];
+			if (c == 0) { res = FR_NO_FILE; break; }	/* Reached to end of table */
+#if FF_USE_LFN
+			a = dp->dir[DIR_Attr] & AM_MASK;
+			if (c == DDEM || ((a & AM_VOL) && a != AM_LFN)) {	/* An entry without valid data */
+				ord = 0xFF;
+			} else if (a == AM_LFN) {	/* An LFN entry is found */
+				if (c & LLEF) {			/* Is it start of LFN sequence? */
+					sum = dp->dir[LDIR_Chksum];
+					c &= (BYTE)~LLEF; ord = c;
+					ofs = dp->dptr; lh = 0;
+				}
+				if (c == ord && sum == dp->dir[LDIR_Chksum]) {
+					lh ^= dhash_lfn(dp->dir); ord--;
+				} else {
+					ord = 0xFF;
+				}
+			} else {					/* An SFN entry is found */
+				if (ord == 0 && sum == sum_sfn(dp->dir)) {	/* With a valid LFN */
+					idx = dhash_add(pool, idx, lh, ofs / SZDIRE);
+					idx = dhash_add(pool, idx, dhash_sfn(dp->dir), ofs / SZDIRE);
+				} else {
+					idx = dhash_add(pool, idx, dhash_sfn(dp->dir), dp->dptr / SZDIRE);
+				}
+				ord = 0xFF;
+			}
+#else
+			if (c != DDEM && !(dp->dir[DIR_Attr] & AM_VOL)) {
+				idx = dhash_add(pool, idx, dhash_sfn(dp->dir), dp->dptr / SZDIRE);
+			}
+#endif
+			res = dir_next(dp, 0);	/* Next entry */
+		}
+	}
+	if (res != FR_NO_FILE) {		/* Error before the end of the directory */
+		dhash_remove(pool, idx);
+		return res;
+	}
+
+	key = (DWORD*)(idx + 1);		/* Sort the keys (Shell sort) */
+	for (gap = idx->nkey / 2; gap; gap /= 2) {
+		for (i = gap; i < idx->nkey; i++) {
+			k = key[i];
+			for (j = i; j >= gap && key[j - gap] > k; j -= gap) key[j] = key[j - gap];
+			key[j] = k;
+		}
+	}
+	*pidx = idx;
+	return FR_OK;
+}
+
+
+/* Find an object with the name index of the directory */
+static
+FRESULT dhash_find (	/* FR_OK:found, FR_NO_FILE:not in the directory, FR_NOT_ENOUGH_CORE:no index, others:error */
+	DIR* dp			/* Pointer to the directory object with the file name */
+)
+{
+	FRESULT res;
+	FATFS *fs = dp->obj.fs;
+	DIRHASHPOOL *pool = dhash_pool(fs);
+	DIRHASH *idx;
+	DWORD sclust = dhash_clust(dp), *key, *k[2], *e[2], ent;
+	WORD hash[2];
+	UINT i, n = 0, lo, hi, mid;
+
+
+	for (idx = (DIRHASH*)pool->key; idx < DIRHASH_END(pool); idx = DIRHASH_NEXT(idx)) {	/* Find existing index */
+		if (idx->fs == fs && idx->id == fs->id && idx->sclust == sclust) break;
+	}
+	if (idx < DIRHASH_END(pool)) {
+		idx->use = ++pool->use;
+	} else {
+		if (dhash_build(dp, pool, &idx) != FR_OK) return FR_NOT_ENOUGH_CORE;	/* Leave any error to the scan */
+	}
+	if (idx->full) return FR_NOT_ENOUGH_CORE;
+
+	/* Hashes of the name to find */
+#if FF_FS_EXFAT
+	if (fs->fs_type == FS_EXFAT) {
+		hash[n++] = xname_sum(fs->lfnbuf);
+	} else
+#endif
+	{
+#if FF_USE_LFN
+		if (!(dp->fn[NSFLAG] & NS_NOLFN)) {
+			for (hash[n] = 0, i = 0; fs->lfnbuf[i]; i++) hash[n] ^= dhash_chr(i, ff_wtoupper(fs->lfnbuf[i]));
+			n++;
+		}
+		if (!(dp->fn[NSFLAG] & NS_LOSS)) hash[n++] = dhash_sfn(dp->fn);
+#else
+		hash[n++] = dhash_sfn(dp->fn);
+#endif
+	}
+
+	/* Find the keys with each hash */
+	key = (DWORD*)(idx + 1);
+	for (i = 0; i < n; i++) {
+		lo = 0; hi = idx->nkey;
+		while (lo < hi) {
+			mid = (lo + hi) / 2;
+			if ((key[mid] >> 16) < hash[i]) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+		for (k[i] = e[i] = key + lo; e[i] < key + idx->nkey && (*e[i] >> 16) == hash[i]; e[i]++) ;
+	}
+
+	/* Check the entries in the order they are in the directory */
+	for (;;) {
+		ent = 0x10000;
+		for (i = 0; i < n; i++) {
+			if (k[i] < e[i] && (*k[i] & 0xFFFF) < ent) ent = *k[i] & 0xFFFF;
+		}
+		if (ent == 0x10000) break;
+		for (i = 0; i < n; i++) {
+			if (k[i] < e[i] && (*k[i] & 0xFFFF) == ent) k[i]++;
+		}
+		res = dir_sdi(dp, ent * SZDIRE);
+		if (res != FR_OK) return res;
+#if FF_FS_EXFAT
+		if (fs->fs_type == FS_EXFAT) {
+			res = dir_read_file(dp);
+			if (res == FR_OK && !xdir_cmp_name(fs, hash[0])) res = FR_NO_FILE;
+		} else
+#endif
+		{
+			res = dir_scan(dp, 1);
+		}
+		if (res != FR_NO_FILE) return res;
+	}
+	return FR_NO_FILE;
+}
+
+#endif	/* FF_USE_DIRHASH */
+
+
+
+static
+FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
+	DIR* dp			/* Pointer to the directory object with the file name */
+)
+{
+	FRESULT res;
+
+
+#if FF_USE_DIRHASH
+	res = dhash_find(dp);			/* Search the name index */
+	if (res != FR_NOT_ENOUGH_CORE) return res;
+#endif
+	res = dir_sdi(dp, 0);			/* Rewind directory object */
+	if (res != FR_OK) return res;
+#if FF_FS_EXFAT
+	if (dp->obj.fs->fs_type == FS_EXFAT) {	/* On the exFAT volume */
+		FATFS *fs = dp->obj.fs;
+		WORD hash = xname_sum(fs->lfnbuf);		/* Hash value of the name to find */
+
+		while ((res = dir_read_file(dp)) == FR_OK) {	/* Read an item */
+			if (xdir_cmp_name(fs, hash)) break;	/* Name matched? */
+		}
+		return res;
+	}
+#endif
+	return dir_scan(dp, 0);			/* On the FAT/FAT32 volume */
+}
+
+
+
 
 #if !FF_FS_READONLY
 /*-----------------------------------------------------------------------*/
@@ -2621,7 +3583,12 @@ FRESULT dir_remove (	/* FR_OK:Succeeded, FR_DISK_ERR:A disk error */
 	FATFS *fs = dp->obj.fs;
 #if FF_USE_LFN		/* LFN configuration */
 	DWORD last = dp->dptr;
+#endif
 
+#if FF_USE_DIRHASH
+	dhash_invalidate(fs, dhash_clust(dp));	/* The name index of the directory is no longer valid */
+#endif
+#if FF_USE_LFN		/* LFN configuration */
 	res = (dp->blk_ofs == 0xFFFFFFFF) ? FR_OK : dir_sdi(dp, dp->blk_ofs);	/* Goto top of the entry block if LFN is exist */
 	if (res == FR_OK) {
 		do {
@@ -3678,6 +4645,9 @@ FRESULT f_open (
 			}
 #if FF_USE_FASTSEEK
 			fp->cltbl = 0;			/* Disable fast seek mode */
+#endif
+#if FF_USE_STREAM
+			fp->xclst = 0;			/* No reserved block */
 #endif
 			fp->obj.fs = fs;	 	/* Validate the file object */
 			fp->obj.id = fs->id;
@@ -3824,6 +4794,49 @@ FRESULT f_read (
 
 
 #if !FF_FS_READONLY
+#if FF_USE_STREAM
+/*-----------------------------------------------------------------------*/
+/* Free the Unwritten Part of a Reserved Block                           */
+/*-----------------------------------------------------------------------*/
+
+static
+FRESULT release_extent (
+	FIL* fp		/* Pointer to the file object */
+)
+{
+	FRESULT res = FR_OK;
+	FATFS *fs = fp->obj.fs;
+	DWORD bcs, ucl;
+#if FF_FS_EXFAT
+	FSIZE_t fsz = fp->obj.objsize;
+#endif
+
+
+	bcs = (DWORD)fs->csize * SS(fs);	/* Cluster size */
+	ucl = (DWORD)(fp->obj.objsize / bcs) + ((fp->obj.objsize & (bcs - 1)) ? 1 : 0);	/* Number of clusters written */
+	if (ucl < fp->xclst) {
+#if FF_FS_EXFAT
+		fp->obj.objsize = (FSIZE_t)fp->xclst * bcs;	/* Contiguous chain is followed up to the file size */
+#endif
+		if (ucl == 0) {		/* Nothing written, remove the entire block */
+			res = remove_chain(&fp->obj, fp->obj.sclust, 0);
+			fp->obj.sclust = 0;
+		} else {			/* Remove the clusters following the written part */
+			res = remove_chain(&fp->obj, fp->obj.sclust + ucl, fp->obj.sclust + ucl - 1);
+		}
+#if FF_FS_EXFAT
+		fp->obj.objsize = fsz;
+#endif
+		fp->flag |= FA_MODIFIED;
+	}
+	fp->xclst = 0;
+	return res;
+}
+
+#endif /* FF_USE_STREAM */
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Write File                                                            */
 /*-----------------------------------------------------------------------*/
@@ -3867,6 +4880,11 @@ FRESULT f_write (
 					if (fp->cltbl) {
 						clst = clmt_clust(fp, fp->fptr);	/* Get cluster# from the CLMT */
 					} else
+#endif
+#if FF_USE_STREAM
+					if (fp->fptr / ((DWORD)fs->csize * SS(fs)) < fp->xclst) {
+						clst = fp->clust + 1;	/* Next cluster in the reserved block */
+					} else
 #endif
 					{
 						clst = create_chain(&fp->obj, fp->clust);	/* Follow or stretch cluster chain on the FAT */
@@ -3891,6 +4909,15 @@ FRESULT f_write (
 			sect += csect;
 			cc = btw / SS(fs);				/* When remaining bytes >= sector size, */
 			if (cc > 0) {					/* Write maximum contiguous sectors directly */
+#if FF_USE_STREAM
+				clst = (DWORD)(fp->fptr / SS(fs) / fs->csize);	/* Cluster index in the file */
+				if (clst < fp->xclst) {		/* In the reserved block? */
+					if (cc > (fp->xclst - clst) * fs->csize - csect) {	/* Clip at end of the block */
+						cc = (fp->xclst - clst) * fs->csize - csect;
+					}
+					fp->clust += (csect + cc - 1) / fs->csize;	/* Cluster of the last sector written */
+				} else
+#endif
 				if (csect + cc > fs->csize) {	/* Clip at cluster boundary */
 					cc = fs->csize - csect;
 				}
@@ -4038,6 +5065,16 @@ FRESULT f_close (
 	FATFS *fs;
 
 #if !FF_FS_READONLY
+#if FF_USE_STREAM
+	if (fp->xclst) {					/* Free the unwritten part of a reserved block */
+		res = validate(&fp->obj, &fs);
+		if (res == FR_OK) res = release_extent(fp);
+		if (res != FR_OK) LEAVE_FF(fs, res);
+#if FF_FS_REENTRANT
+		unlock_fs(fs, FR_OK);
+#endif
+	}
+#endif
 	res = f_sync(fp);					/* Flush cached data */
 	if (res == FR_OK)
 #endif
@@ -4320,6 +5357,24 @@ FRESULT f_lseek (
 #endif
 				fp->clust = clst;
 			}
+#if FF_USE_LINKMAP
+			if (clst != 0 && (ofs - 1) / bcs > 1
+#if FF_FS_EXFAT
+				&& fp->obj.stat != 2	/* Contiguous file needs no map */
+#endif
+				) {										/* Jump over clusters with the link map */
+				FSIZE_t pos = fp->fptr + ofs;
+				DWORD ncl = (DWORD)((pos - 1) / bcs);	/* Index of target cluster */
+				LINKMAP *map = lmap_get(&fp->obj, (DWORD)(fp->fptr / bcs), ncl);
+				if (map) {
+					if (ncl >= map->nclust) ncl = map->nclust - 1;
+					clst = lmap_clust(map, ncl);
+					fp->fptr = (FSIZE_t)ncl * bcs;
+					ofs = pos - fp->fptr;
+					fp->clust = clst;
+				}
+			}
+#endif
 			if (clst != 0) {
 				while (ofs > bcs) {						/* Cluster following loop */
 					ofs -= bcs; fp->fptr += bcs;
@@ -4329,6 +5384,11 @@ FRESULT f_lseek (
 							fp->obj.objsize = fp->fptr;
 							fp->flag |= FA_MODIFIED;
 						}
+#if FF_USE_STREAM
+						if (fp->fptr / bcs < fp->xclst) {
+							clst++;						/* Next cluster in the reserved block */
+						} else
+#endif
 						clst = create_chain(&fp->obj, clst);	/* Follow chain with forceed stretch */
 						if (clst == 0) {				/* Clip file size in case of disk full */
 							ofs = 0; break;
@@ -4614,6 +5674,9 @@ FRESULT f_getfree (
 	res = find_volume(&path, &fs, 0);
 	if (res == FR_OK) {
 		*fatfs = fs;				/* Return ptr to the fs object */
+#if FF_USE_FREEMAP
+		if (fs->free_clst > fs->n_fatent - 2) fmap_get(fs);	/* Build the free cluster map, which counts free clusters */
+#endif
 		/* If free_clst is valid, return it without full FAT scan */
 		if (fs->free_clst <= fs->n_fatent - 2) {
 			*nclst = fs->free_clst;
@@ -4698,6 +5761,12 @@ FRESULT f_truncate (
 	res = validate(&fp->obj, &fs);	/* Check validity of the file object */
 	if (res != FR_OK || (res = (FRESULT)fp->err) != FR_OK) LEAVE_FF(fs, res);
 	if (!(fp->flag & FA_WRITE)) LEAVE_FF(fs, FR_DENIED);	/* Check access mode */
+#if FF_USE_STREAM
+	if (fp->xclst) {					/* Free the unwritten part of a reserved block */
+		res = release_extent(fp);
+		if (res != FR_OK) ABORT(fs, res);
+	}
+#endif
 
 	if (fp->fptr < fp->obj.objsize) {	/* Process when fptr is not on the eof */
 		if (fp->fptr == 0) {	/* When set file size to zero, remove entire cluster chain */
@@ -5346,6 +6415,9 @@ FRESULT f_expand (
 	FRESULT res;
 	FATFS *fs;
 	DWORD n, clst, stcl, scl, ncl, tcl, lclst;
+#if FF_USE_FREEMAP
+	DWORD *map;
+#endif
 
 
 	res = validate(&fp->obj, &fs);		/* Check validity of the file object */
@@ -5358,10 +6430,17 @@ FRESULT f_expand (
 	tcl = (DWORD)(fsz / n) + ((fsz & (n - 1)) ? 1 : 0);	/* Number of clusters required */
 	stcl = fs->last_clst; lclst = 0;
 	if (stcl < 2 || stcl >= fs->n_fatent) stcl = 2;
+#if FF_USE_FREEMAP
+	map = fmap_get(fs);					/* Map of free clusters (built on first use) */
+#endif
 
 #if FF_FS_EXFAT
 	if (fs->fs_type == FS_EXFAT) {
+#if FF_USE_FREEMAP
+		scl = map ? fmap_find(map, fs, stcl, tcl) : find_bitmap(fs, stcl, tcl);	/* Find a contiguous cluster block */
+#else
 		scl = find_bitmap(fs, stcl, tcl);			/* Find a contiguous cluster block */
+#endif
 		if (scl == 0) res = FR_DENIED;				/* No contiguous cluster block was found */
 		if (scl == 0xFFFFFFFF) res = FR_DISK_ERR;
 		if (res == FR_OK) {	/* A contiguous free area is found */
@@ -5376,6 +6455,12 @@ FRESULT f_expand (
 #endif
 	{
 		scl = clst = stcl; ncl = 0;
+#if FF_USE_FREEMAP
+		if (map) {	/* Find a contiguous cluster block in the map */
+			scl = fmap_find(map, fs, stcl, tcl);
+			if (scl == 0) res = FR_DENIED;
+		} else
+#endif
 		for (;;) {	/* Find a contiguous cluster block */
 			n = get_fat(&fp->obj, clst);
 			if (++clst >= fs->n_fatent) clst = 2;
@@ -5418,6 +6503,37 @@ FRESULT f_expand (
 	LEAVE_FF(fs, res);
 }
 
+
+
+
+#if FF_USE_STREAM
+/*-----------------------------------------------------------------------*/
+/* Reserve a Contiguous Block for Streaming Writes                       */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_reserve (
+	FIL* fp,		/* Pointer to the file object */
+	FSIZE_t fsz		/* Size of the block to be reserved */
+)
+{
+	FRESULT res;
+	FATFS *fs;
+	DWORD bcs;
+
+
+	res = f_expand(fp, fsz, 1);			/* Allocate a contiguous cluster block */
+	if (res != FR_OK) return res;
+	res = validate(&fp->obj, &fs);
+	if (res == FR_OK) {
+		bcs = (DWORD)fs->csize * SS(fs);	/* Cluster size */
+		fp->xclst = (DWORD)(fsz / bcs) + ((fsz & (bcs - 1)) ? 1 : 0);	/* Number of clusters reserved */
+		fp->obj.objsize = 0;			/* File grows into the block as it is written */
+	}
+
+	LEAVE_FF(fs, res);
+}
+
+#endif /* FF_USE_STREAM */
 #endif /* FF_USE_EXPAND && !FF_FS_READONLY */
 
 
@@ -5898,8 +7014,7 @@ FRESULT f_mkfs (
 				if (disk_write(pdrv, buf, sect, (UINT)n) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);
 				mem_set(buf, 0, ss);
 				sect += n; nsect -= n;
-				//Reset Watchdog
-				*((volatile unsigned int *) 0xFFD0200C) = 0x76;
+				FF_RESET_WATCHDOG();
 			} while (nsect);
 		}
 
@@ -5909,7 +7024,7 @@ FRESULT f_mkfs (
 			n = (nsect > sz_buf) ? sz_buf : nsect;
 			if (disk_write(pdrv, buf, sect, (UINT)n) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);
 			sect += n; nsect -= n;
-            *((volatile unsigned int *) 0xFFD0200C) = 0x76;
+			FF_RESET_WATCHDOG();
 		} while (nsect);
 	}
 
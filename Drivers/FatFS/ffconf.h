@@ -46,10 +46,78 @@
 /* This option switches fast seek function. (0:Disable or 1:Enable) */
 
 
-#define FF_USE_EXPAND	0
+#define FF_USE_LINKMAP	1
+#define FF_LINKMAP_BUDGET	32768
+/* This option switches automatic cluster link maps. (0:Disable or 1:Enable)
+/  When enabled, f_lseek() records the fragments of a file's cluster chain as it
+/  follows the chain, so later seeks within the recorded part jump straight to
+/  the cluster rather than reading the FAT. Maps of all files share a pool of
+/  FF_LINKMAP_BUDGET bytes, least recently used first out. A map takes 24 bytes
+/  plus 8 bytes per fragment. Unlike fast seek, no table needs to be given by
+/  the application. When FF_FS_REENTRANT is enabled, the budget is split evenly
+/  between the FF_VOLUMES volumes, so the default gives each of 4 volumes 8kB.
+/
+/  A file written in one go is usually a single fragment, and such maps are
+/  small. A file written in turn with others is fragmented at almost every
+/  cluster, and its map takes 8 bytes per cluster (e.g. 12kB for a 3MB file
+/  with 2kB clusters). When the pool is full, a map covers only the start of
+/  its file and seeks beyond it read the FAT as before. For such files, size
+/  the budget from the total clusters of the files seeked at once, times
+/  FF_VOLUMES if re-entrant, or reduce FF_VOLUMES to the drives actually used. */
+
+
+#define FF_USE_DIRHASH	1
+#define FF_DIRHASH_BUDGET	16384
+/* This option switches directory name indexes. (0:Disable or 1:Enable)
+/  When enabled, the first lookup of a name in a directory records a 16-bit hash
+/  of every name in it, sorted with the entry position. Later lookups search the
+/  index, and only read the entries whose hash matches, so opening a file in a
+/  large directory costs one sector read rather than a scan. An index is dropped
+/  when its directory is modified, and rebuilt by the next lookup. Indexes share
+/  a pool of FF_DIRHASH_BUDGET bytes, least recently used first out. An index
+/  takes 20 bytes plus 4 bytes per short name and 8 bytes per long name. A
+/  directory too large for the pool is scanned as before. When FF_FS_REENTRANT
+/  is enabled, the budget is split evenly between the FF_VOLUMES volumes. */
+
+
+#define FF_USE_FREEMAP	0
+#define FF_FREEMAP_BUDGET	65536
+/* This option switches the free cluster map. (0:Disable or 1:Enable)
+/  When enabled, the first cluster allocation or f_getfree() on a volume reads
+/  the whole FAT (or the exFAT allocation bitmap) once into a bitmap in RAM,
+/  with a bit for each cluster. Finding free clusters then searches the bitmap
+/  a word at a time rather than reading the FAT, and the free cluster count is
+/  always known, so f_getfree() returns at once. Maps are held in a static pool
+/  of FF_FREEMAP_BUDGET bytes. The pool holds the map of one volume at a time,
+/  or when FF_FS_REENTRANT is enabled, is split evenly between the FF_VOLUMES
+/  volumes. A volume too large for its share is handled as before.
+/
+/  Size the budget from the largest card to be used. Its map takes
+/  (card size / cluster size) / 8 bytes, e.g.:
+/
+/     8GB FAT32 (4kB clusters)     256kB    32GB FAT32 (32kB clusters)  128kB
+/    64GB exFAT (128kB clusters)    64kB   128GB exFAT (128kB clusters) 128kB
+/
+/  then multiply by FF_VOLUMES if FF_FS_REENTRANT is enabled. The default
+/  budget covers only small volumes (e.g. 4GB with 32kB clusters per volume
+/  when split 4 ways), so raise it when enabling the map for an SD card. */
+
+
+#define FF_USE_EXPAND	1
 /* This option switches f_expand function. (0:Disable or 1:Enable) */
 
 
+#define FF_USE_STREAM	1
+/* This option switches f_reserve() function for streaming writes. (0:Disable or
+/  1:Enable) f_reserve() allocates a contiguous block like f_expand(), but leaves
+/  the file size at zero so the file grows into the block as it is written.
+/  f_write() then moves between clusters of the block without following or
+/  stretching the FAT chain, and writes spanning many clusters are issued as a
+/  single multiple sector disk_write(). The directory entry is only updated by
+/  f_sync() and f_close(), and f_close() frees the part of the block which was
+/  not written. FF_USE_EXPAND needs to be 1 to enable this option. */
+
+
 #define FF_USE_CHMOD	0
 /* This option switches attribute manipulation functions, f_chmod() and f_utime().
 /  (0:Disable or 1:Enable) Also FF_FS_READONLY needs to be 0 to enable this option. */
@@ -97,7 +165,7 @@
 */
 
 
-#define FF_USE_LFN		1
+#define FF_USE_LFN		2
 #define FF_MAX_LFN		255
 /* The FF_USE_LFN switches the support for LFN (long file name).
 /
@@ -162,7 +230,7 @@
 / Drive/Volume Configurations
 /---------------------------------------------------------------------------*/
 
-#define FF_VOLUMES		1 //DO NOT CHANGE!
+#define FF_VOLUMES		4 //Drive 0 is the SD card. See disk_register() in diskio.h
 /* Number of volumes (logical drives) to be used. (1-10) */
 
 
@@ -224,7 +292,15 @@
 /  buffer in the filesystem object (FATFS) is used for the file data transfer. */
 
 
-#define FF_FS_EXFAT		0
+#define FF_USE_MEMFAST	1
+/* This option switches the memory copy, fill and compare functions used by the
+/  module. (0:Byte loops or 1:Util/mem_fast.c) When enabled, sector buffers and
+/  directory entries are moved a word at a time, in plain C or using LDM/STM or
+/  NEON as set by MEMFAST_IMPL (see Util/mem_fast.h). Util/mem_fast.c needs to
+/  be built. */
+
+
+#define FF_FS_EXFAT		1
 /* This option switches support for exFAT filesystem. (0:Disable or 1:Enable)
 /  When enable exFAT, also LFN needs to be enabled.
 /  Note that enabling exFAT discards ANSI C (C89) compatibility. */
@@ -256,9 +332,10 @@
 /      lock control is independent of re-entrancy. */
 
 
-#define FF_FS_REENTRANT	0
-#define FF_FS_TIMEOUT	1000
-#define FF_SYNC_t		HANDLE
+#define FF_FS_REENTRANT	1
+#define FF_FS_TIMEOUT	0
+#define FF_SYNC_t		struct ff_mutex*
+#define FF_MUTEX_WFE	1
 /* The option FF_FS_REENTRANT switches the re-entrancy (thread safe) of the FatFs
 /  module itself. Note that regardless of this option, file access to different
 /  volume is always re-entrant and volume control functions, f_mount(), f_mkfs()
@@ -274,10 +351,29 @@
 /  The FF_FS_TIMEOUT defines timeout period in unit of time tick.
 /  The FF_SYNC_t defines O/S dependent sync object type. e.g. HANDLE, ID, OS_EVENT*,
 /  SemaphoreHandle_t and etc. A header file for O/S definitions needs to be
-/  included somewhere in the scope of ff.h. */
+/  included somewhere in the scope of ff.h.
+/
+/  ffsystem.c provides a spinlock mutex for each volume, built on LDREX/STREX so
+/  it can be shared by the main loop, interrupt handlers and both cores. Using
+/  both cores needs the caches enabled on each (see ffsystem.c). Here
+/  FF_FS_TIMEOUT is the number of failed attempts to take the lock before the
+/  function fails with FR_TIMEOUT (0: wait forever). A call which interrupted
+/  the holder of the lock on the same core fails with FR_TIMEOUT at once. When
+/  FF_MUTEX_WFE is 1, a waiting core sleeps with WFE until the lock is released.
+/  This needs FF_USE_LFN to be 2 or 3, and a larger stack. */
 
 /* #include <windows.h>	// O/S definitions  */
 
 
+#ifndef FF_DISKIO_HOST
+#define FF_RESET_WATCHDOG()	(*((volatile unsigned int *) 0xFFD0200C) = 0x76)
+#else
+#define FF_RESET_WATCHDOG()
+#endif
+/* The FF_RESET_WATCHDOG() is called by f_mkfs() while initialising large areas
+/  of the volume, to stop the HPS watchdog timing out. It does nothing in a host
+/  build (FF_DISKIO_HOST). */
+
+
 
 /*--- End of configuration options ---*/
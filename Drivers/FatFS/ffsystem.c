@@ -39,6 +39,124 @@ void ff_memfree (
 
 #if FF_FS_REENTRANT	/* Mutal exclusion */
 
+/*------------------------------------------------------------------------*/
+/* Spinlock Mutexes                                                       */
+/*------------------------------------------------------------------------*/
+/* Each volume has a mutex, taken with LDREX/STREX so that it can be shared
+/  by the main loop and interrupt handlers (e.g. deferred work), and between
+/  the two Cortex-A9 cores. A waiter sleeps with WFE until the holder
+/  releases the mutex with SEV (FF_MUTEX_WFE).
+/  To use FatFS from both cores, each core must call __enable_caches() (see
+/  Util/startup_arm.h) first, e.g. by defining STARTUP_ENABLE_CACHES. This maps
+/  RAM as shareable, enables the SCU and sets ACTLR.SMP, so the cores see the
+/  same mutex and volume data and the exclusive monitor guards the mutex
+/  between them. With the MMU off, only use FatFS from one core.
+/  The core holding the mutex is recorded. If the mutex is held by the same
+/  core, the caller must have interrupted the holder, so waiting would never
+/  end and it fails at once instead. Interrupts are masked while the mutex
+/  and its holder are updated so that this check cannot be fooled.
+/  On a host build (FF_DISKIO_HOST) GCC atomics are used and the holder is
+/  not checked.
+*/
+
+struct ff_mutex {
+	volatile UINT lock;		/* 0:Free, 1:Held */
+	volatile UINT core;		/* Core holding the mutex + 1 (0:Not recorded) */
+};
+
+static struct ff_mutex Mutex[FF_VOLUMES];
+
+#ifdef FF_DISKIO_HOST
+
+#define ff_mutex_core()		0			/* Holder not checked */
+#define ff_irq_mask()		0
+#define ff_irq_restore(m)	((void)(m))
+#define ff_mutex_acquire(mtx)	(!__atomic_exchange_n(&(mtx)->lock, 1, __ATOMIC_ACQUIRE))
+#define ff_mutex_release(mtx)	__atomic_store_n(&(mtx)->lock, 0, __ATOMIC_RELEASE)
+#define ff_mutex_wait()
+
+#else
+
+#include "Util/lowlevel.h"
+
+#define ff_mutex_core()		((__GET_SYSREG(SYSREG_COPROC, MPIDR) & SYSREG_MPIDR_MASK_CPUID) + 1)
+#define ff_irq_mask()		__disable_irq()
+#define ff_irq_restore(m)	{ if (!(m)) __enable_irq(); }
+#if FF_MUTEX_WFE
+#define ff_mutex_wait()		__wfe()
+#else
+#define ff_mutex_wait()
+#endif
+
+static
+int ff_mutex_acquire (	/* 1:Acquired, 0:Held by another context */
+	struct ff_mutex* mtx
+)
+{
+	if (__ldrex(&mtx->lock)) {	/* Held, drop the exclusive access */
+		__clrex();
+		return 0;
+	}
+	if (__strex(1, &mtx->lock)) return 0;	/* Lost the exclusive access */
+	__dmb(0xF);					/* Accesses to the volume follow the acquire */
+	return 1;
+}
+
+static
+void ff_mutex_release (
+	struct ff_mutex* mtx
+)
+{
+	__dmb(0xF);					/* Accesses to the volume complete before release */
+	mtx->lock = 0;
+	__dsb(0xF);
+	__sev();					/* Wake any core waiting in WFE */
+}
+
+#endif
+
+static
+int ff_mutex_take (	/* 1:Got the mutex, 0:Timeout or held by an interrupted context */
+	struct ff_mutex* mtx
+)
+{
+	UINT core = ff_mutex_core();
+#if FF_FS_TIMEOUT
+	UINT tries = 0;
+#endif
+	int mask, got, self;
+
+	for (;;) {
+		mask = ff_irq_mask();
+		got = ff_mutex_acquire(mtx);
+		if (got) mtx->core = core;
+		self = !got && core && mtx->core == core;
+		ff_irq_restore(mask);
+		if (got) return 1;
+		if (self) return 0;		/* Waiting for the context this one interrupted */
+#if FF_FS_TIMEOUT
+		if (++tries >= FF_FS_TIMEOUT) return 0;	/* Timeout */
+#endif
+		ff_mutex_wait();
+	}
+}
+
+
+static
+void ff_mutex_give (
+	struct ff_mutex* mtx
+)
+{
+	int mask;
+
+	mask = ff_irq_mask();
+	mtx->core = 0;
+	ff_mutex_release(mtx);
+	ff_irq_restore(mask);
+}
+
+
+
 /*------------------------------------------------------------------------*/
 /* Create a Synchronization Object                                        */
 /*------------------------------------------------------------------------*/
@@ -47,35 +165,16 @@ void ff_memfree (
 /  When a 0 is returned, the f_mount() function fails with FR_INT_ERR.
 */
 
-//const osMutexDef_t Mutex[FF_VOLUMES];	/* CMSIS-RTOS */
-
-
 int ff_cre_syncobj (	/* 1:Function succeeded, 0:Could not create the sync object */
 	BYTE vol,			/* Corresponding volume (logical drive number) */
 	FF_SYNC_t *sobj		/* Pointer to return the created sync object */
 )
 {
-	/* Win32 */
-	*sobj = CreateMutex(NULL, FALSE, NULL);
-	return (int)(*sobj != INVALID_HANDLE_VALUE);
-
-	/* uITRON */
-//	T_CSEM csem = {TA_TPRI,1,1};
-//	*sobj = acre_sem(&csem);
-//	return (int)(*sobj > 0);
-
-	/* uC/OS-II */
-//	OS_ERR err;
-//	*sobj = OSMutexCreate(0, &err);
-//	return (int)(err == OS_NO_ERR);
-
-	/* FreeRTOS */
-//	*sobj = xSemaphoreCreateMutex();
-//	return (int)(*sobj != NULL);
-
-	/* CMSIS-RTOS */
-//	*sobj = osMutexCreate(Mutex + vol);
-//	return (int)(*sobj != NULL);
+	if (vol >= FF_VOLUMES) return 0;
+	Mutex[vol].core = 0;
+	Mutex[vol].lock = 0;
+	*sobj = &Mutex[vol];
+	return 1;
 }
 
 
@@ -91,23 +190,8 @@ int ff_del_syncobj (	/* 1:Function succeeded, 0:Could not delete due to an error
 	FF_SYNC_t sobj		/* Sync object tied to the logical drive to be deleted */
 )
 {
-	/* Win32 */
-	return (int)CloseHandle(sobj);
-
-	/* uITRON */
-//	return (int)(del_sem(sobj) == E_OK);
-
-	/* uC/OS-II */
-//	OS_ERR err;
-//	OSMutexDel(sobj, OS_DEL_ALWAYS, &err);
-//	return (int)(err == OS_NO_ERR);
-
-	/* FreeRTOS */
-//  vSemaphoreDelete(sobj);
-//	return 1;
-
-	/* CMSIS-RTOS */
-//	return (int)(osMutexDelete(sobj) == osOK);
+	(void)sobj;			/* Mutexes are static, nothing to free */
+	return 1;
 }
 
 
@@ -122,22 +206,7 @@ int ff_req_grant (	/* 1:Got a grant to access the volume, 0:Could not get a gran
 	FF_SYNC_t sobj	/* Sync object to wait */
 )
 {
-	/* Win32 */
-	return (int)(WaitForSingleObject(sobj, FF_FS_TIMEOUT) == WAIT_OBJECT_0);
-
-	/* uITRON */
-//	return (int)(wai_sem(sobj) == E_OK);
-
-	/* uC/OS-II */
-//	OS_ERR err;
-//	OSMutexPend(sobj, FF_FS_TIMEOUT, &err));
-//	return (int)(err == OS_NO_ERR);
-
-	/* FreeRTOS */
-//	return (int)(xSemaphoreTake(sobj, FF_FS_TIMEOUT) == pdTRUE);
-
-	/* CMSIS-RTOS */
-//	return (int)(osMutexWait(sobj, FF_FS_TIMEOUT) == osOK);
+	return ff_mutex_take(sobj);
 }
 
 
@@ -151,21 +220,7 @@ void ff_rel_grant (
 	FF_SYNC_t sobj	/* Sync object to be signaled */
 )
 {
-	/* Win32 */
-	ReleaseMutex(sobj);
-
-	/* uITRON */
-//	sig_sem(sobj);
-
-	/* uC/OS-II */
-//	OSMutexPost(sobj);
-
-	/* FreeRTOS */
-//	xSemaphoreGive(sobj);
-
-	/* CMSIS-RTOS */
-//	osMutexRelease(sobj);
+	ff_mutex_give(sobj);
 }
 
 #endif
-
@@ -0,0 +1,841 @@
+/*
+ * Cache Management API
+ * --------------------
+ *
+ * Implementation of the HWLib cache management API (alt_cache.h)
+ * for the Cortex-A9 L1 caches and the L2C-310 (PL310) L2 cache
+ * controller.
+ *
+ * Range operations work on the L1 data cache by address (MVA),
+ * and on the L2 cache by physical address, which is the same as
+ * the virtual address with the flat memory mapping assumed by the
+ * API. Whole cache operations use set/way for the L1, and the
+ * background way operations of the L2.
+ *
+ * Enabling the L1 data cache only has an effect once the MMU is
+ * enabled, as without it all data accesses are non-cacheable.
+ *
+ * Supports both Cyclone V devices (default) or Arria 10 devices
+ * (-D __ARRIA10__).
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#include "alt_cache.h"
+#include "hwlib.h"
+
+#if defined (soc_a10)
+#include "a10/socal/hps.h"
+#include "a10/socal/socal.h"
+#else
+#include "cv/socal/hps.h"
+#include "cv/socal/socal.h"
+#endif
+
+#include "Util/lowlevel.h"
+
+#if ALT_CACHE_SUPPORT_NON_FLAT_VIRTUAL_MEMORY
+#error Only a flat virtual memory mapping is supported by this implementation
+#endif
+
+/******************************************************************************
+ * L2C-310 Registers
+ ******************************************************************************/
+
+#if defined (soc_a10)
+#define ALT_CACHE_L2_BASE               ALT_L2_REGS_L2TYPE_OFST
+#else
+#define ALT_CACHE_L2_BASE               ALT_MPUL2_OFST
+#endif
+
+#define ALT_CACHE_L2_REG(ofst)          ((void *)(ALT_CACHE_L2_BASE + (ofst)))
+
+#define ALT_CACHE_L2_CONTROL            ALT_CACHE_L2_REG(0x100)
+#define ALT_CACHE_L2_AUX_CONTROL        ALT_CACHE_L2_REG(0x104)
+#define ALT_CACHE_L2_TAG_RAM_CONTROL    ALT_CACHE_L2_REG(0x108)
+#define ALT_CACHE_L2_DATA_RAM_CONTROL   ALT_CACHE_L2_REG(0x10C)
+#define ALT_CACHE_L2_INT_MASK           ALT_CACHE_L2_REG(0x214)
+#define ALT_CACHE_L2_INT_MASK_STATUS    ALT_CACHE_L2_REG(0x218)
+#define ALT_CACHE_L2_INT_RAW_STATUS     ALT_CACHE_L2_REG(0x21C)
+#define ALT_CACHE_L2_INT_CLEAR          ALT_CACHE_L2_REG(0x220)
+#define ALT_CACHE_L2_CACHE_SYNC         ALT_CACHE_L2_REG(0x730)
+#define ALT_CACHE_L2_INV_PA             ALT_CACHE_L2_REG(0x770)
+#define ALT_CACHE_L2_INV_WAY            ALT_CACHE_L2_REG(0x77C)
+#define ALT_CACHE_L2_CLEAN_PA           ALT_CACHE_L2_REG(0x7B0)
+#define ALT_CACHE_L2_CLEAN_WAY          ALT_CACHE_L2_REG(0x7BC)
+#define ALT_CACHE_L2_CLEAN_INV_PA       ALT_CACHE_L2_REG(0x7F0)
+#define ALT_CACHE_L2_CLEAN_INV_WAY      ALT_CACHE_L2_REG(0x7FC)
+#define ALT_CACHE_L2_PREFETCH_CONTROL   ALT_CACHE_L2_REG(0xF60)
+
+#define ALT_CACHE_L2_CONTROL_EN                 (1UL << 0)
+
+#define ALT_CACHE_L2_AUX_CONTROL_ASSOC_16WAY    (1UL << 16)
+#define ALT_CACHE_L2_AUX_CONTROL_PARITY_EN      (1UL << 21)
+#define ALT_CACHE_L2_AUX_CONTROL_SHARED_OVERRIDE (1UL << 22)
+#define ALT_CACHE_L2_AUX_CONTROL_DATA_PREFETCH  (1UL << 28)
+#define ALT_CACHE_L2_AUX_CONTROL_INSTR_PREFETCH (1UL << 29)
+#define ALT_CACHE_L2_AUX_CONTROL_EARLY_BRESP    (1UL << 30)
+
+#define ALT_CACHE_L2_PREFETCH_DATA              (1UL << 28)
+#define ALT_CACHE_L2_PREFETCH_INSTR             (1UL << 29)
+
+/*  RAM latencies (cycles - 1) of {setup, read, write}: tag {1,1,1}, data {1,2,1}*/
+#define ALT_CACHE_L2_TAG_RAM_LATENCY            0x000
+#define ALT_CACHE_L2_DATA_RAM_LATENCY           0x010
+
+/*  Polling limit for the background way operations and cache sync*/
+#define ALT_CACHE_L2_TMO                        0x100000
+
+/*  Range operations longer than the L2 cache are done on the whole cache instead*/
+#define ALT_CACHE_L2_SIZE                       (512 * 1024)
+
+/*  The range operations are written for a fixed line size*/
+#define ALT_CACHE_LINE_MASK                     (ALT_CACHE_LINE_SIZE - 1)
+
+/******************************************************************************
+ * Internal Helpers
+ ******************************************************************************/
+
+static inline void alt_cache_dsb(void)
+{
+    __dsb(0xF);
+}
+
+static inline void alt_cache_isb(void)
+{
+    __isb(0xF);
+}
+
+static inline uint32_t alt_cache_sctlr_get(void)
+{
+    return __GET_SYSREG(SYSREG_COPROC, SCTLR);
+}
+
+static inline void alt_cache_sctlr_set(uint32_t sctlr)
+{
+    __SET_SYSREG(SYSREG_COPROC, SCTLR, sctlr);
+    alt_cache_isb();
+}
+
+static inline uint32_t alt_cache_actlr_get(void)
+{
+    return __GET_SYSREG(SYSREG_COPROC, ACTLR);
+}
+
+static inline void alt_cache_actlr_set(uint32_t actlr)
+{
+    __SET_SYSREG(SYSREG_COPROC, ACTLR, actlr);
+    alt_cache_isb();
+}
+
+/*
+// Check a memory segment is made of whole cache lines.
+*/
+static inline bool alt_cache_range_is_valid(void * address, size_t length)
+{
+    return ((((uintptr_t)address | length) & ALT_CACHE_LINE_MASK) == 0)
+        && ((uintptr_t)address + length >= (uintptr_t)address);
+}
+
+/*
+// L1 data cache maintenance by set/way over the whole cache.
+*/
+typedef enum ALT_CACHE_L1_OP_e
+{
+    ALT_CACHE_L1_OP_INVALIDATE,
+    ALT_CACHE_L1_OP_CLEAN,
+    ALT_CACHE_L1_OP_PURGE
+} ALT_CACHE_L1_OP_t;
+
+static void alt_cache_l1_data_setway(ALT_CACHE_L1_OP_t op)
+{
+    uint32_t ccsidr;
+    uint32_t line_shift;
+    uint32_t way_shift;
+    uint32_t ways;
+    uint32_t sets;
+    uint32_t way;
+    uint32_t set;
+
+    /*  Select the L1 data cache, and read its geometry*/
+    __SET_SYSREG(SYSREG_COPROC, CSSELR, 0);
+    alt_cache_isb();
+    ccsidr = __GET_SYSREG(SYSREG_COPROC, CCSIDR);
+    line_shift = (ccsidr & 0x7) + 4;
+    ways = ((ccsidr >> 3) & 0x3FF) + 1;
+    sets = ((ccsidr >> 13) & 0x7FFF) + 1;
+    /*  Way number is held in the top bits*/
+    way_shift = 32;
+    while ((1UL << (32 - way_shift)) < ways)
+    {
+        way_shift--;
+    }
+
+    for (way = 0; way < ways; way++)
+    {
+        for (set = 0; set < sets; set++)
+        {
+            uint32_t setway = ((way_shift < 32) ? (way << way_shift) : 0) | (set << line_shift);
+            switch (op)
+            {
+            case ALT_CACHE_L1_OP_INVALIDATE:
+                __SET_SYSREG(SYSREG_COPROC, DCISW, setway);
+                break;
+            case ALT_CACHE_L1_OP_CLEAN:
+                __SET_SYSREG(SYSREG_COPROC, DCCSW, setway);
+                break;
+            default:
+                __SET_SYSREG(SYSREG_COPROC, DCCISW, setway);
+                break;
+            }
+        }
+    }
+    alt_cache_dsb();
+}
+
+/*
+// L2 maintenance by physical address. Each operation completes before the next
+// is accepted, so only a cache sync is needed at the end.
+*/
+static void alt_cache_l2_range(void * reg, uintptr_t address, size_t length)
+{
+    uintptr_t end = address + length;
+    while (address < end)
+    {
+        alt_write_word(reg, address);
+        address += ALT_CACHE_LINE_SIZE;
+    }
+}
+
+/*
+// L2 background maintenance of all ways.
+*/
+static ALT_STATUS_CODE alt_cache_l2_way_op(void * reg)
+{
+    uint32_t way_mask;
+    uint32_t timeout = ALT_CACHE_L2_TMO;
+
+    way_mask = (alt_read_word(ALT_CACHE_L2_AUX_CONTROL) & ALT_CACHE_L2_AUX_CONTROL_ASSOC_16WAY) ? 0xFFFF : 0xFF;
+    alt_write_word(reg, way_mask);
+    while ((alt_read_word(reg) & way_mask) && --timeout)
+        ;
+    if (timeout == 0)
+    {
+        return ALT_E_TMO;
+    }
+    return alt_cache_l2_sync();
+}
+
+/******************************************************************************
+ * System Level Cache Management
+ ******************************************************************************/
+
+ALT_STATUS_CODE alt_cache_system_enable(void)
+{
+    ALT_STATUS_CODE status;
+
+    status = alt_cache_l2_init();
+    if (status == ALT_E_SUCCESS)
+    {
+        status = alt_cache_l2_prefetch_enable();
+    }
+    if (status == ALT_E_SUCCESS)
+    {
+        status = alt_cache_l2_parity_enable();
+    }
+    if (status == ALT_E_SUCCESS)
+    {
+        status = alt_cache_l2_enable();
+    }
+    if (status == ALT_E_SUCCESS)
+    {
+        status = alt_cache_l1_enable_all();
+    }
+    return status;
+}
+
+ALT_STATUS_CODE alt_cache_system_disable(void)
+{
+    ALT_STATUS_CODE status;
+
+    /*  L1 is written back into the L2, then the L2 to memory*/
+    status = alt_cache_l1_disable_all();
+    if (status == ALT_E_SUCCESS)
+    {
+        status = alt_cache_l2_disable();
+    }
+    if (status == ALT_E_SUCCESS)
+    {
+        status = alt_cache_l2_uninit();
+    }
+    return status;
+}
+
+/*
+// Caches which are disabled hold no data, as disabling a cache cleans and
+// invalidates it, so maintenance of them is skipped.
+*/
+
+ALT_STATUS_CODE alt_cache_system_invalidate(void * vaddress, size_t length)
+{
+    ALT_STATUS_CODE status = ALT_E_SUCCESS;
+
+    if (!alt_cache_range_is_valid(vaddress, length))
+    {
+        return ALT_E_BAD_ARG;
+    }
+    if (alt_cache_l2_is_enabled())
+    {
+        status = alt_cache_l2_invalidate(vaddress, length);
+    }
+    if ((status == ALT_E_SUCCESS) && alt_cache_l1_data_is_enabled())
+    {
+        status = alt_cache_l1_data_invalidate(vaddress, length);
+    }
+    return status;
+}
+
+ALT_STATUS_CODE alt_cache_system_clean(void * vaddress, size_t length)
+{
+    ALT_STATUS_CODE status = ALT_E_SUCCESS;
+
+    if (!alt_cache_range_is_valid(vaddress, length))
+    {
+        return ALT_E_BAD_ARG;
+    }
+    if (alt_cache_l1_data_is_enabled())
+    {
+        status = alt_cache_l1_data_clean(vaddress, length);
+    }
+    if ((status == ALT_E_SUCCESS) && alt_cache_l2_is_enabled())
+    {
+        status = alt_cache_l2_clean(vaddress, length);
+    }
+    return status;
+}
+
+ALT_STATUS_CODE alt_cache_system_purge(void * vaddress, size_t length)
+{
+    ALT_STATUS_CODE status = ALT_E_SUCCESS;
+    bool l1_enabled = alt_cache_l1_data_is_enabled();
+
+    if (!alt_cache_range_is_valid(vaddress, length))
+    {
+        return ALT_E_BAD_ARG;
+    }
+    if (l1_enabled)
+    {
+        status = alt_cache_l1_data_clean(vaddress, length);
+    }
+    if ((status == ALT_E_SUCCESS) && alt_cache_l2_is_enabled())
+    {
+        status = alt_cache_l2_purge(vaddress, length);
+    }
+    if ((status == ALT_E_SUCCESS) && l1_enabled)
+    {
+        status = alt_cache_l1_data_invalidate(vaddress, length);
+    }
+    return status;
+}
+
+/******************************************************************************
+ * L1 Cache Management
+ ******************************************************************************/
+
+ALT_STATUS_CODE alt_cache_l1_enable_all(void)
+{
+    alt_cache_l1_disable_all();
+
+    alt_cache_l1_parity_enable();
+    alt_cache_l1_instruction_enable();
+    alt_cache_l1_data_enable();
+    alt_cache_l1_branch_enable();
+    alt_cache_l1_prefetch_enable();
+
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l1_disable_all(void)
+{
+    alt_cache_l1_prefetch_disable();
+    alt_cache_l1_branch_disable();
+    alt_cache_l1_data_disable();
+    alt_cache_l1_instruction_disable();
+    alt_cache_l1_parity_disable();
+
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l1_instruction_enable(void)
+{
+    if (!alt_cache_l1_instruction_is_enabled())
+    {
+        alt_cache_l1_instruction_invalidate();
+        alt_cache_sctlr_set(alt_cache_sctlr_get() | (1UL << SYSREG_SCTLR_BIT_I));
+    }
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l1_instruction_disable(void)
+{
+    alt_cache_sctlr_set(alt_cache_sctlr_get() & ~(1UL << SYSREG_SCTLR_BIT_I));
+    return ALT_E_SUCCESS;
+}
+
+bool alt_cache_l1_instruction_is_enabled(void)
+{
+    return (alt_cache_sctlr_get() & (1UL << SYSREG_SCTLR_BIT_I)) != 0;
+}
+
+ALT_STATUS_CODE alt_cache_l1_instruction_invalidate(void)
+{
+    __SET_SYSREG(SYSREG_COPROC, ICIALLU, 0);
+    __SET_SYSREG(SYSREG_COPROC, BPIALL, 0);
+    alt_cache_dsb();
+    alt_cache_isb();
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l1_data_enable(void)
+{
+    if (!alt_cache_l1_data_is_enabled())
+    {
+        alt_cache_l1_data_invalidate_all();
+        alt_cache_sctlr_set(alt_cache_sctlr_get() | (1UL << SYSREG_SCTLR_BIT_C));
+    }
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l1_data_disable(void)
+{
+    if (alt_cache_l1_data_is_enabled())
+    {
+        /*  Stop new lines being allocated before writing back the cache*/
+        alt_cache_sctlr_set(alt_cache_sctlr_get() & ~(1UL << SYSREG_SCTLR_BIT_C));
+        alt_cache_l1_data_purge_all();
+    }
+    return ALT_E_SUCCESS;
+}
+
+bool alt_cache_l1_data_is_enabled(void)
+{
+    return (alt_cache_sctlr_get() & (1UL << SYSREG_SCTLR_BIT_C)) != 0;
+}
+
+ALT_STATUS_CODE alt_cache_l1_data_invalidate(void * vaddress, size_t length)
+{
+    uintptr_t address = (uintptr_t)vaddress;
+    uintptr_t end = address + length;
+
+    if (!alt_cache_range_is_valid(vaddress, length))
+    {
+        return ALT_E_BAD_ARG;
+    }
+    while (address < end)
+    {
+        __SET_SYSREG(SYSREG_COPROC, DCIMVAC, address);
+        address += ALT_CACHE_LINE_SIZE;
+    }
+    alt_cache_dsb();
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l1_data_invalidate_all(void)
+{
+    alt_cache_l1_data_setway(ALT_CACHE_L1_OP_INVALIDATE);
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l1_data_clean(void * vaddress, size_t length)
+{
+    uintptr_t address = (uintptr_t)vaddress;
+    uintptr_t end = address + length;
+
+    if (!alt_cache_range_is_valid(vaddress, length))
+    {
+        return ALT_E_BAD_ARG;
+    }
+    while (address < end)
+    {
+        __SET_SYSREG(SYSREG_COPROC, DCCMVAC, address);
+        address += ALT_CACHE_LINE_SIZE;
+    }
+    alt_cache_dsb();
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l1_data_clean_all(void)
+{
+    alt_cache_l1_data_setway(ALT_CACHE_L1_OP_CLEAN);
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l1_data_purge(void * vaddress, size_t length)
+{
+    uintptr_t address = (uintptr_t)vaddress;
+    uintptr_t end = address + length;
+
+    if (!alt_cache_range_is_valid(vaddress, length))
+    {
+        return ALT_E_BAD_ARG;
+    }
+    while (address < end)
+    {
+        __SET_SYSREG(SYSREG_COPROC, DCCIMVAC, address);
+        address += ALT_CACHE_LINE_SIZE;
+    }
+    alt_cache_dsb();
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l1_data_purge_all(void)
+{
+    alt_cache_l1_data_setway(ALT_CACHE_L1_OP_PURGE);
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l1_parity_enable(void)
+{
+    uint32_t sctlr;
+
+    if (alt_cache_l1_parity_is_enabled())
+    {
+        return ALT_E_SUCCESS;
+    }
+
+    /*  Caches must be disabled while parity is changed, then invalidated*/
+    sctlr = alt_cache_sctlr_get();
+    if (sctlr & (1UL << SYSREG_SCTLR_BIT_C))
+    {
+        alt_cache_l1_data_disable();
+    }
+    alt_cache_sctlr_set(alt_cache_sctlr_get() & ~((1UL << SYSREG_SCTLR_BIT_I) | (1UL << SYSREG_SCTLR_BIT_Z)));
+
+    alt_cache_actlr_set(alt_cache_actlr_get() | (1UL << SYSREG_ACTLR_BIT_PARITY));
+
+    alt_cache_l1_instruction_invalidate();
+    alt_cache_l1_data_invalidate_all();
+    alt_cache_sctlr_set(sctlr);
+
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l1_parity_disable(void)
+{
+    alt_cache_actlr_set(alt_cache_actlr_get() & ~(1UL << SYSREG_ACTLR_BIT_PARITY));
+    return ALT_E_SUCCESS;
+}
+
+bool alt_cache_l1_parity_is_enabled(void)
+{
+    return (alt_cache_actlr_get() & (1UL << SYSREG_ACTLR_BIT_PARITY)) != 0;
+}
+
+ALT_STATUS_CODE alt_cache_l1_branch_enable(void)
+{
+    alt_cache_l1_branch_invalidate();
+    alt_cache_sctlr_set(alt_cache_sctlr_get() | (1UL << SYSREG_SCTLR_BIT_Z));
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l1_branch_disable(void)
+{
+    alt_cache_sctlr_set(alt_cache_sctlr_get() & ~(1UL << SYSREG_SCTLR_BIT_Z));
+    return ALT_E_SUCCESS;
+}
+
+bool alt_cache_l1_branch_is_enabled(void)
+{
+    return (alt_cache_sctlr_get() & (1UL << SYSREG_SCTLR_BIT_Z)) != 0;
+}
+
+ALT_STATUS_CODE alt_cache_l1_branch_invalidate(void)
+{
+    __SET_SYSREG(SYSREG_COPROC, BPIALL, 0);
+    alt_cache_dsb();
+    alt_cache_isb();
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l1_prefetch_enable(void)
+{
+    alt_cache_actlr_set(alt_cache_actlr_get() | (1UL << SYSREG_ACTLR_BIT_L1PE));
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l1_prefetch_disable(void)
+{
+    alt_cache_actlr_set(alt_cache_actlr_get() & ~(1UL << SYSREG_ACTLR_BIT_L1PE));
+    return ALT_E_SUCCESS;
+}
+
+bool alt_cache_l1_prefetch_is_enabled(void)
+{
+    return (alt_cache_actlr_get() & (1UL << SYSREG_ACTLR_BIT_L1PE)) != 0;
+}
+
+/******************************************************************************
+ * L2 Cache Management
+ ******************************************************************************/
+
+ALT_STATUS_CODE alt_cache_l2_init(void)
+{
+    if (alt_cache_l2_is_enabled())
+    {
+        return ALT_E_ERROR;
+    }
+
+    /*  RAM latencies and auxiliary control can only be changed while disabled.
+        Shared attribute override keeps normal memory cacheable when marked
+        shareable, and early write responses speed up buffered writes.*/
+    alt_write_word(ALT_CACHE_L2_TAG_RAM_CONTROL, ALT_CACHE_L2_TAG_RAM_LATENCY);
+    alt_write_word(ALT_CACHE_L2_DATA_RAM_CONTROL, ALT_CACHE_L2_DATA_RAM_LATENCY);
+    alt_setbits_word(ALT_CACHE_L2_AUX_CONTROL,   ALT_CACHE_L2_AUX_CONTROL_SHARED_OVERRIDE
+                                               | ALT_CACHE_L2_AUX_CONTROL_EARLY_BRESP);
+
+    /*  Start with no interrupts*/
+    alt_write_word(ALT_CACHE_L2_INT_MASK, 0);
+    alt_write_word(ALT_CACHE_L2_INT_CLEAR, 0x1FF);
+
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l2_uninit(void)
+{
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l2_prefetch_enable(void)
+{
+    alt_setbits_word(ALT_CACHE_L2_PREFETCH_CONTROL, ALT_CACHE_L2_PREFETCH_DATA | ALT_CACHE_L2_PREFETCH_INSTR);
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l2_prefetch_disable(void)
+{
+    alt_clrbits_word(ALT_CACHE_L2_PREFETCH_CONTROL, ALT_CACHE_L2_PREFETCH_DATA | ALT_CACHE_L2_PREFETCH_INSTR);
+    return ALT_E_SUCCESS;
+}
+
+bool alt_cache_l2_prefetch_is_enabled(void)
+{
+    return (alt_read_word(ALT_CACHE_L2_PREFETCH_CONTROL) & (ALT_CACHE_L2_PREFETCH_DATA | ALT_CACHE_L2_PREFETCH_INSTR))
+        == (ALT_CACHE_L2_PREFETCH_DATA | ALT_CACHE_L2_PREFETCH_INSTR);
+}
+
+ALT_STATUS_CODE alt_cache_l2_parity_enable(void)
+{
+    ALT_STATUS_CODE status = ALT_E_SUCCESS;
+    bool enabled = alt_cache_l2_is_enabled();
+
+    if (alt_cache_l2_parity_is_enabled())
+    {
+        return ALT_E_SUCCESS;
+    }
+    if (enabled)
+    {
+        status = alt_cache_l2_disable();
+    }
+    if (status == ALT_E_SUCCESS)
+    {
+        alt_setbits_word(ALT_CACHE_L2_AUX_CONTROL, ALT_CACHE_L2_AUX_CONTROL_PARITY_EN);
+        if (enabled)
+        {
+            status = alt_cache_l2_enable();
+        }
+    }
+    return status;
+}
+
+ALT_STATUS_CODE alt_cache_l2_parity_disable(void)
+{
+    ALT_STATUS_CODE status = ALT_E_SUCCESS;
+    bool enabled = alt_cache_l2_is_enabled();
+
+    if (!alt_cache_l2_parity_is_enabled())
+    {
+        return ALT_E_SUCCESS;
+    }
+    if (enabled)
+    {
+        status = alt_cache_l2_disable();
+    }
+    if (status == ALT_E_SUCCESS)
+    {
+        alt_clrbits_word(ALT_CACHE_L2_AUX_CONTROL, ALT_CACHE_L2_AUX_CONTROL_PARITY_EN);
+        if (enabled)
+        {
+            status = alt_cache_l2_enable();
+        }
+    }
+    return status;
+}
+
+bool alt_cache_l2_parity_is_enabled(void)
+{
+    return (alt_read_word(ALT_CACHE_L2_AUX_CONTROL) & ALT_CACHE_L2_AUX_CONTROL_PARITY_EN) != 0;
+}
+
+ALT_STATUS_CODE alt_cache_l2_enable(void)
+{
+    ALT_STATUS_CODE status;
+
+    if (alt_cache_l2_is_enabled())
+    {
+        return ALT_E_SUCCESS;
+    }
+    status = alt_cache_l2_invalidate_all();
+    if (status == ALT_E_SUCCESS)
+    {
+        alt_write_word(ALT_CACHE_L2_CONTROL, ALT_CACHE_L2_CONTROL_EN);
+        alt_cache_dsb();
+    }
+    return status;
+}
+
+ALT_STATUS_CODE alt_cache_l2_disable(void)
+{
+    ALT_STATUS_CODE status;
+
+    if (!alt_cache_l2_is_enabled())
+    {
+        return ALT_E_SUCCESS;
+    }
+    status = alt_cache_l2_purge_all();
+    if (status == ALT_E_SUCCESS)
+    {
+        alt_write_word(ALT_CACHE_L2_CONTROL, 0);
+        alt_cache_dsb();
+    }
+    return status;
+}
+
+bool alt_cache_l2_is_enabled(void)
+{
+    return (alt_read_word(ALT_CACHE_L2_CONTROL) & ALT_CACHE_L2_CONTROL_EN) != 0;
+}
+
+ALT_STATUS_CODE alt_cache_l2_sync(void)
+{
+    uint32_t timeout = ALT_CACHE_L2_TMO;
+
+    alt_cache_dsb();
+    alt_write_word(ALT_CACHE_L2_CACHE_SYNC, 0);
+    while ((alt_read_word(ALT_CACHE_L2_CACHE_SYNC) & 0x1) && --timeout)
+        ;
+    return timeout ? ALT_E_SUCCESS : ALT_E_TMO;
+}
+
+ALT_STATUS_CODE alt_cache_l2_invalidate(void * paddress, size_t length)
+{
+    if (!alt_cache_range_is_valid(paddress, length))
+    {
+        return ALT_E_BAD_ARG;
+    }
+    /*  Unlike clean, there is no whole cache equivalent which keeps other data*/
+    alt_cache_l2_range(ALT_CACHE_L2_INV_PA, (uintptr_t)paddress, length);
+    return alt_cache_l2_sync();
+}
+
+ALT_STATUS_CODE alt_cache_l2_invalidate_all(void)
+{
+    return alt_cache_l2_way_op(ALT_CACHE_L2_INV_WAY);
+}
+
+ALT_STATUS_CODE alt_cache_l2_clean(void * paddress, size_t length)
+{
+    if (!alt_cache_range_is_valid(paddress, length))
+    {
+        return ALT_E_BAD_ARG;
+    }
+    if (length > ALT_CACHE_L2_SIZE)
+    {
+        return alt_cache_l2_clean_all();
+    }
+    alt_cache_l2_range(ALT_CACHE_L2_CLEAN_PA, (uintptr_t)paddress, length);
+    return alt_cache_l2_sync();
+}
+
+ALT_STATUS_CODE alt_cache_l2_clean_all(void)
+{
+    ALT_STATUS_CODE status;
+    uint32_t int_mask = alt_read_word(ALT_CACHE_L2_INT_MASK);
+
+    alt_write_word(ALT_CACHE_L2_INT_MASK, 0);
+    status = alt_cache_l2_way_op(ALT_CACHE_L2_CLEAN_WAY);
+    alt_write_word(ALT_CACHE_L2_INT_MASK, int_mask);
+    return status;
+}
+
+ALT_STATUS_CODE alt_cache_l2_purge(void * paddress, size_t length)
+{
+    if (!alt_cache_range_is_valid(paddress, length))
+    {
+        return ALT_E_BAD_ARG;
+    }
+    if (length > ALT_CACHE_L2_SIZE)
+    {
+        return alt_cache_l2_purge_all();
+    }
+    alt_cache_l2_range(ALT_CACHE_L2_CLEAN_INV_PA, (uintptr_t)paddress, length);
+    return alt_cache_l2_sync();
+}
+
+ALT_STATUS_CODE alt_cache_l2_purge_all(void)
+{
+    ALT_STATUS_CODE status;
+    uint32_t int_mask = alt_read_word(ALT_CACHE_L2_INT_MASK);
+
+    alt_write_word(ALT_CACHE_L2_INT_MASK, 0);
+    status = alt_cache_l2_way_op(ALT_CACHE_L2_CLEAN_INV_WAY);
+    alt_write_word(ALT_CACHE_L2_INT_MASK, int_mask);
+    return status;
+}
+
+ALT_STATUS_CODE alt_cache_l2_int_enable(uint32_t interrupt)
+{
+    if (interrupt & ~0x1FFUL)
+    {
+        return ALT_E_BAD_ARG;
+    }
+    alt_setbits_word(ALT_CACHE_L2_INT_MASK, interrupt);
+    return ALT_E_SUCCESS;
+}
+
+ALT_STATUS_CODE alt_cache_l2_int_disable(uint32_t interrupt)
+{
+    if (interrupt & ~0x1FFUL)
+    {
+        return ALT_E_BAD_ARG;
+    }
+    alt_clrbits_word(ALT_CACHE_L2_INT_MASK, interrupt);
+    return ALT_E_SUCCESS;
+}
+
+uint32_t alt_cache_l2_int_status_get(void)
+{
+    return alt_read_word(ALT_CACHE_L2_INT_MASK_STATUS);
+}
+
+uint32_t alt_cache_l2_int_raw_status_get(void)
+{
+    return alt_read_word(ALT_CACHE_L2_INT_RAW_STATUS);
+}
+
+ALT_STATUS_CODE alt_cache_l2_int_status_clear(uint32_t interrupt)
+{
+    if (interrupt & ~0x1FFUL)
+    {
+        return ALT_E_BAD_ARG;
+    }
+    alt_write_word(ALT_CACHE_L2_INT_CLEAR, interrupt);
+    return ALT_E_SUCCESS;
+}
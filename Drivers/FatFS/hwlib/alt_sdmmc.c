@@ -75,9 +75,6 @@
 /*  Timeout for waiting event*/
 #define  ALT_SDMMC_TMO_WAITER          1000000
 
-#define ALT_SDMMC_DMA_SEGMENT_SIZE      512
-#define ALT_SDMMC_DMA_DESC_COUNT        128
-
 #define ALT_SDMMC_FSM_IDLE              0
 #define ALT_SDMMC_DMA_FSM_IDLE          0
 
@@ -142,12 +139,6 @@
 #define ALT_SDMMC_SD_MODE_UHS_SDR104      (1 << ALT_SDMMC_UHS_SDR104_BUS_SPEED)
 #define ALT_SDMMC_SD_MODE_UHS_DDR50       (1 << ALT_SDMMC_UHS_DDR50_BUS_SPEED)
 
-typedef enum ALT_SDMMC_TMOD_e
-{
-    ALT_SDMMC_TMOD_READ          = 0,
-    ALT_SDMMC_TMOD_WRITE         = 1
-} ALT_SDMMC_TMOD_t;
-
 #ifdef LOGGER
 uint32_t log_buffer[1000] = { 0 };
 uint32_t log_index = 0;
@@ -748,11 +739,27 @@ static ALT_SDMMC_CMD_CONFIG_t cmd_clock_cfg =
 };
 
 static uint32_t                    rca_number; /*!< Relative card address.  */
-static ALT_SDMMC_DMA_BUF_DESC_t    dma_descriptors[ALT_SDMMC_DMA_DESC_COUNT] __attribute__ ((aligned (ALT_CACHE_LINE_SIZE)));
-                                        /*!< Array of DMA descriptors.  */
-static ALT_SDMMC_DMA_BUF_DESC_t    *dma_cur_descr __attribute__ ((aligned (ALT_CACHE_LINE_SIZE)));
+/*
+// Each descriptor is padded to a whole cache line, so cache maintenance of one
+// never disturbs another being written back by the DMA. The controller skips
+// the padding between descriptors in the ring.
+*/
+typedef union
+{
+    ALT_SDMMC_DMA_BUF_DESC_t desc;
+    uint8_t                  line[ALT_CACHE_LINE_SIZE];
+} ALT_SDMMC_DMA_DESC_LINE_t;
+#define ALT_SDMMC_DMA_DESC_SKIP ((ALT_CACHE_LINE_SIZE - sizeof(ALT_SDMMC_DMA_BUF_DESC_t)) / sizeof(uint32_t))
+
+static ALT_SDMMC_DMA_DESC_LINE_t   dma_descriptors[ALT_SDMMC_DMA_DESC_COUNT] __attribute__ ((aligned (ALT_CACHE_LINE_SIZE)));
+                                        /*!< Ring of DMA descriptors.  */
+static ALT_SDMMC_DMA_BUF_DESC_t    *dma_cur_descr;
                                         /*!< Current descriptor.  */
-#define ALT_SDMMC_DMA_BUF_DESC_CACHE_SIZE (((ALT_SDMMC_DMA_DESC_COUNT*sizeof(ALT_SDMMC_DMA_BUF_DESC_t)) + ALT_CACHE_LINE_SIZE - 1) & ~(ALT_CACHE_LINE_SIZE-1))
+static uint32_t                    dma_desc_used;
+                                        /*!< Descriptors filled since the ring was cleared.  */
+static uint32_t                    dma_read_start;
+                                        /*!< Cache lines of the DMA read in progress.  */
+static uint32_t                    dma_read_length;
 
 /*
 // Reset SD/MMC module by reset manager without deassert
@@ -793,62 +800,78 @@ static ALT_STATUS_CODE alt_sdmmc_rstmgr_strobe(void)
 }
 
 /*
-// Initialize descriptor chain for dma
+// Initialize descriptor ring for dma
 */
 static ALT_STATUS_CODE alt_sdmmc_desc_chain_init()
 {
     uint32_t count;
-    ALT_SDMMC_DMA_BUF_DESC_t * dma_desc = dma_descriptors;
 
-    /*  Initialising descriptor chain*/
+    /*  Initialising dual-buffer descriptor ring*/
     for (count = 0; count < ALT_SDMMC_DMA_DESC_COUNT; count++)
     {
-        dma_desc[count].des0.fld.own  = 0;
-        dma_desc[count].des0.fld.ch   = 1;
-        dma_desc[count].des0.fld.er   = 0;
-        dma_desc[count].des1.fld.bs1  = 0;
-        dma_desc[count].des2.fld.bap1 = 0;
+        ALT_SDMMC_DMA_BUF_DESC_t * dma_desc = &dma_descriptors[count].desc;
 
-        /*  Create chain description list*/
-        if (count == (ALT_SDMMC_DMA_DESC_COUNT - 1))
-        {
-            /*  If it is latest element set pointer to the ring head.*/
-            dma_desc[count].des3.fld.bap2_or_next = (uint32_t) dma_desc;
-        }
-        else
-        {
-            /*  Set pointer to the next element in the ring*/
-            dma_desc[count].des3.fld.bap2_or_next = (uint32_t) (&dma_desc[count + 1]);
-        }
+        dma_desc->des0.raw = 0;
+        dma_desc->des1.raw = 0;
+        dma_desc->des2.raw = 0;
+        dma_desc->des3.raw = 0;
+        /*  Last element returns to the ring head*/
+        dma_desc->des0.fld.er = (count == (ALT_SDMMC_DMA_DESC_COUNT - 1)) ? 1 : 0;
     }
-    
-    dma_cur_descr = dma_desc;
-    
-    return alt_cache_system_purge(dma_descriptors, ALT_SDMMC_DMA_BUF_DESC_CACHE_SIZE);
+
+    dma_cur_descr = &dma_descriptors[0].desc;
+    dma_desc_used = 0;
+
+    return alt_cache_system_purge(dma_descriptors, sizeof(dma_descriptors));
 }
 
 /*
-// Clear descriptors of chain for DMA operations
+// Clear descriptors of ring for DMA operations
 */
 static ALT_STATUS_CODE alt_sdmmc_desc_chain_clear()
 {
     uint32_t count;
-    ALT_SDMMC_DMA_BUF_DESC_t * dma_desc = dma_descriptors;
+
+    /*  Only those filled since the last clear can be in use*/
+    if (dma_desc_used > ALT_SDMMC_DMA_DESC_COUNT)
+    {
+        dma_desc_used = ALT_SDMMC_DMA_DESC_COUNT;
+    }
 
     /*  Clean descriptions*/
-    for (count = 0; count < ALT_SDMMC_DMA_DESC_COUNT; count++)
+    for (count = 0; count < dma_desc_used; count++)
     {
-        dma_desc[count].des0.fld.own  = 0;
-        dma_desc[count].des0.fld.dic  = 0;
-        dma_desc[count].des0.fld.ld   = 0;
-        dma_desc[count].des0.fld.fs   = 0;
-        dma_desc[count].des1.fld.bs1  = 0;
-        dma_desc[count].des2.fld.bap1 = 0;
+        ALT_SDMMC_DMA_BUF_DESC_t * dma_desc = &dma_descriptors[count].desc;
+
+        dma_desc->des0.fld.own  = 0;
+        dma_desc->des0.fld.dic  = 0;
+        dma_desc->des0.fld.ld   = 0;
+        dma_desc->des0.fld.fs   = 0;
+        dma_desc->des1.raw      = 0;
+        dma_desc->des2.raw      = 0;
+        dma_desc->des3.raw      = 0;
     }
 
-    dma_cur_descr = dma_desc;
-        
-    return alt_cache_system_purge(dma_descriptors, ALT_SDMMC_DMA_BUF_DESC_CACHE_SIZE);
+    dma_cur_descr = &dma_descriptors[0].desc;
+    count = dma_desc_used;
+    dma_desc_used = 0;
+
+    return (count == 0) ? ALT_E_SUCCESS
+                        : alt_cache_system_purge(dma_descriptors, count * sizeof(ALT_SDMMC_DMA_DESC_LINE_t));
+}
+
+/*
+// Next descriptor in the ring
+*/
+static ALT_SDMMC_DMA_BUF_DESC_t * alt_sdmmc_desc_next(ALT_SDMMC_DMA_BUF_DESC_t * dma_desc)
+{
+    ALT_SDMMC_DMA_DESC_LINE_t * line = (ALT_SDMMC_DMA_DESC_LINE_t *)dma_desc + 1;
+
+    if (line == &dma_descriptors[ALT_SDMMC_DMA_DESC_COUNT])
+    {
+        line = dma_descriptors;
+    }
+    return &line->desc;
 }
 
 /*
@@ -1119,16 +1142,13 @@ uint32_t alt_sdmmc_card_speed_get(void)
     uint32_t clk_div = alt_sdmmc_card_clk_div_get();
 
     /*  The sdmmc_clk(clock_freq) is divided by 4, then further divided by 2*clk_div inside the controller.*/
-    uint32_t speed_bps = clock_freq / (4 * 2 * clk_div);
+    /*  A divider of 0 bypasses the second stage.*/
+    uint32_t speed_bps = (clk_div == 0) ? (clock_freq / 4) : (clock_freq / (4 * 2 * clk_div));
 
     return speed_bps;
 }
 
-#ifdef soc_cv_av
 ALT_STATUS_CODE alt_sdmmc_card_speed_set(ALT_SDMMC_CARD_INFO_t * card_info, uint32_t xfer_speed)
-#else
-ALT_STATUS_CODE alt_sdmmc_card_speed_set(__attribute__((unused))ALT_SDMMC_CARD_INFO_t * card_info, uint32_t xfer_speed)
-#endif
 {
     uint32_t        clk_div = clock_freq / (4 * 2 * xfer_speed);
     ALT_STATUS_CODE status = ALT_E_SUCCESS;
@@ -1136,9 +1156,7 @@ ALT_STATUS_CODE alt_sdmmc_card_speed_set(__attribute__((unused))ALT_SDMMC_CARD_I
     bool            clock_disabled = false;
     bool            low_power_enable =  false;
 
-#ifdef soc_cv_av
-       uint8_t switch_function[64] = {0}; /* switch function status 64 bytes long */
-#endif
+    uint8_t switch_function[64] __attribute__ ((aligned (ALT_CACHE_LINE_SIZE))) = {0}; /* switch function status 64 bytes long */
 
     current_clk_div = alt_sdmmc_card_clk_div_get();
     if (current_clk_div != clk_div)
@@ -1151,9 +1169,6 @@ ALT_STATUS_CODE alt_sdmmc_card_speed_set(__attribute__((unused))ALT_SDMMC_CARD_I
             low_power_enable = alt_sdmmc_card_clk_low_power_is_enabled();
             alt_sdmmc_card_clk_enable(low_power_enable);
         }
-#ifdef soc_cv_av
-       /* switch_function[64] = {0};  switch function status 64 bytes long */
-
         if (clk_div == 0) /*  need to switch from 25MHz to 50MHz*/
         {
             if (card_info->high_speed)
@@ -1184,11 +1199,13 @@ ALT_STATUS_CODE alt_sdmmc_card_speed_set(__attribute__((unused))ALT_SDMMC_CARD_I
                 else
                 {
                     dprintf("Switching to high speed failed, switch_function[16] = 0x%x\n", (int)switch_function[16]);
+                    status = ALT_E_ERROR;
                 }
             }
-            else
+            else if (xfer_speed > ALT_SDMMC_DEFAULT_SPEED_MAX)
             {
                 dprintf("High speed not supported.\n");
+                status = ALT_E_BAD_ARG;
             }
         }
         else if (current_clk_div == 0) /*  need to switch from 50MHz to 25MHz*/
@@ -1216,10 +1233,11 @@ ALT_STATUS_CODE alt_sdmmc_card_speed_set(__attribute__((unused))ALT_SDMMC_CARD_I
             }
             else
             {
+                /*  Lowering the clock is always safe, so continue even if the card did not confirm*/
                 dprintf("Switching to default speed failed\n");
+                status = ALT_E_SUCCESS;
             }
         }
-#endif
         if (status == ALT_E_SUCCESS)
         {
             status = alt_sdmmc_card_clk_div_set(clk_div);
@@ -1715,6 +1733,18 @@ ALT_STATUS_CODE alt_sdmmc_int_enable(const uint32_t mask)
     return ALT_E_SUCCESS;
 }
 
+/*
+// Disable the SD/MMC controller interrupt signal without changing the enabled
+// interrupt status conditions.
+*/
+ALT_STATUS_CODE alt_sdmmc_int_signal_disable(void)
+{
+    alt_clrbits_word(ALT_SDMMC_CTL_ADDR,
+                     ALT_SDMMC_CTL_INT_EN_SET_MSK);
+
+    return ALT_E_SUCCESS;
+}
+
 /*
 //Returns true if SD/MMC controller FIFO has reached the receive watermark level
 //otherwise returns false.
@@ -2099,16 +2129,64 @@ static ALT_STATUS_CODE alt_sdmmc_transfer_helper(uint32_t * buffer,
 }
 
 /*
-// Fill descriptors
+// Cache maintenance before a DMA transfer. The controller accesses memory
+// directly, so data to be written must be cleaned from the caches, and any
+// cached copy of a buffer to be read into must be dropped. Partial cache lines
+// at either end are cleaned first, so other data sharing them is not lost, but
+// must not be changed until the read completes.
+*/
+static void alt_sdmmc_dma_cache_prepare(uint32_t * buffer,
+                                        size_t buf_len,
+                                        ALT_SDMMC_TMOD_t transfer_mode)
+{
+    uint32_t start = (uint32_t)buffer & ~(ALT_CACHE_LINE_SIZE - 1);
+    uint32_t end = ((uint32_t)buffer + buf_len + ALT_CACHE_LINE_SIZE - 1) & ~(ALT_CACHE_LINE_SIZE - 1);
+
+    if (transfer_mode == ALT_SDMMC_TMOD_WRITE)
+    {
+        alt_cache_system_clean((void *)start, end - start);
+        return;
+    }
+    if (((uint32_t)buffer | buf_len) & (ALT_CACHE_LINE_SIZE - 1))
+    {
+        alt_cache_system_clean((void *)start, ALT_CACHE_LINE_SIZE);
+        alt_cache_system_clean((void *)(end - ALT_CACHE_LINE_SIZE), ALT_CACHE_LINE_SIZE);
+    }
+    alt_cache_system_invalidate((void *)start, end - start);
+    dma_read_start = start;
+    dma_read_length = end - start;
+}
+
+/*
+// Cache maintenance after a DMA read. Lines may have been fetched speculatively
+// while the transfer was in progress, so are dropped again.
+*/
+static void alt_sdmmc_dma_cache_complete(void)
+{
+    if (dma_read_length)
+    {
+        alt_cache_system_invalidate((void *)dma_read_start, dma_read_length);
+        dma_read_length = 0;
+    }
+}
+
+/*
+// Fill descriptors. Each takes two buffers of up to ALT_SDMMC_DMA_SEGMENT_SIZE.
+// Transfers larger than the ring refill descriptors as the DMA releases them,
+// resuming the DMA if it ran out. Only the line of each descriptor read or
+// written is maintained in the cache.
 */
 static ALT_STATUS_CODE alt_sdmmc_dma_trans_helper(uint32_t * buffer,
-                                                  size_t buf_len)
+                                                  size_t buf_len,
+                                                  ALT_SDMMC_TMOD_t transfer_mode)
 {
 #ifdef LOGGER
     dprintf("\nalt_sdmmc_dma_trans_helper: buf_len = %d\n",
                                                 (int)buf_len);
 #endif
     ALT_STATUS_CODE status = ALT_E_SUCCESS;
+
+    alt_sdmmc_dma_cache_prepare(buffer, buf_len, transfer_mode);
     /* Pointer to current descriptor*/
     ALT_SDMMC_DMA_BUF_DESC_t *cur_dma_desc = dma_cur_descr;
 
@@ -2125,37 +2203,45 @@ static ALT_STATUS_CODE alt_sdmmc_dma_trans_helper(uint32_t * buffer,
             status = ALT_E_ERROR;
             break;
         }
+        /* Drop any cached copy, to see if the DMA has released the descriptor*/
+        alt_cache_system_invalidate(cur_dma_desc, sizeof(ALT_SDMMC_DMA_DESC_LINE_t));
         /* If current descriptor is free then fill it*/
         if (cur_dma_desc->des0.fld.own == 0)
         {
-            int set_len = len_left > ALT_SDMMC_DMA_SEGMENT_SIZE ? ALT_SDMMC_DMA_SEGMENT_SIZE : len_left;
+            uint32_t set_len1 = len_left > ALT_SDMMC_DMA_SEGMENT_SIZE ? ALT_SDMMC_DMA_SEGMENT_SIZE : len_left;
+            uint32_t set_len2 = len_left - set_len1;
+            if (set_len2 > ALT_SDMMC_DMA_SEGMENT_SIZE)
+            {
+                set_len2 = ALT_SDMMC_DMA_SEGMENT_SIZE;
+            }
             /* Disable interrupt after it will be free*/
             cur_dma_desc->des0.fld.dic = 1;/* socfpga->dma_cur_pos % 4;*/
             /* Set If it is first part of buffer for transfer*/
             cur_dma_desc->des0.fld.fs = (buf_len == len_left) ? 1 : 0;
-            /* Set size of des2*/
-            cur_dma_desc->des1.fld.bs1 = set_len;
-            /* Set address of buffer in memory*/
+            /* Set sizes and addresses of both buffers in memory*/
+            cur_dma_desc->des1.fld.bs1 = set_len1;
+            cur_dma_desc->des1.fld.bs2 = set_len2;
             cur_dma_desc->des2.fld.bap1 = cur_buffer;
+            cur_dma_desc->des3.fld.bap2_or_next = cur_buffer + set_len1;
 
 #ifdef LOGGER
             dprintf("socfpga_setup_dma_add: des_adrdr %08X des2_paddr %08X des1_len %08X len_left %08X\n", 
-                        (int)cur_dma_desc, (int)cur_buffer, (int)set_len, (int)len_left);
+                        (int)cur_dma_desc, (int)cur_buffer, (int)(set_len1 + set_len2), (int)len_left);
 #endif
 
             /* Update address buffer and buffer len*/
-            cur_buffer += set_len;
-            len_left -= set_len;
+            cur_buffer += set_len1 + set_len2;
+            len_left -= set_len1 + set_len2;
             /* Set if it is last part of buffer*/
             cur_dma_desc->des0.fld.ld = (len_left == 0) ? 1 : 0;
             /* Descriptor could be used*/
             cur_dma_desc->des0.fld.own = 1;
+            alt_cache_system_clean(cur_dma_desc, sizeof(ALT_SDMMC_DMA_DESC_LINE_t));
+            dma_desc_used++;
             /* Currernt descriptor set to the next element */
-            cur_dma_desc = (ALT_SDMMC_DMA_BUF_DESC_t *)cur_dma_desc->des3.fld.bap2_or_next;
+            cur_dma_desc = alt_sdmmc_desc_next(cur_dma_desc);
         }
-        
-        alt_cache_system_purge(dma_descriptors, ALT_SDMMC_DMA_BUF_DESC_CACHE_SIZE);
-        
+
         idmac_status = alt_sdmmc_dma_int_status_get();
 
         /*  If DMA status is as descriptor unavailable then resume transfer and clean interrupt status*/
@@ -2227,6 +2313,8 @@ static ALT_STATUS_CODE alt_sdmmc_data_done_waiter(void)
         status = ALT_E_TMO;
     }
 
+    alt_sdmmc_dma_cache_complete();
+
     return status;
 }
 
@@ -2332,7 +2420,7 @@ static ALT_STATUS_CODE alt_sdmmc_card_scr_get(uint64_t* scr_reg)
         /*  Clean descriptor chain*/
         alt_sdmmc_desc_chain_clear();
 
-        alt_sdmmc_dma_start(dma_cur_descr, 0x0,
+        alt_sdmmc_dma_start(dma_cur_descr, ALT_SDMMC_DMA_DESC_SKIP,
                             ALT_SDMMC_DMA_PBL_1, false);
         /* Enable all dma interrupt status*/
         alt_sdmmc_dma_int_enable(ALT_SDMMC_DMA_INT_STATUS_ALL);
@@ -2367,7 +2455,7 @@ static ALT_STATUS_CODE alt_sdmmc_card_scr_get(uint64_t* scr_reg)
     if (alt_sdmmc_is_dma_enabled())
     {
         /* Fill descriptors*/
-        status = alt_sdmmc_dma_trans_helper((uint32_t*)scr_reg, 8);
+        status = alt_sdmmc_dma_trans_helper((uint32_t*)scr_reg, 8, ALT_SDMMC_TMOD_READ);
     }
     else
     {
@@ -3119,17 +3207,18 @@ static ALT_STATUS_CODE alt_sdmmc_card_enum_sd(ALT_SDMMC_CARD_INFO_t *card_info)
     } else {
 
         /*  If not an MMC, read SD Capabilities Register */
-        uint64_t scr_reg;
+        /*  Whole cache lines, as read by DMA*/
+        uint64_t scr_reg[ALT_CACHE_LINE_SIZE / sizeof(uint64_t)] __attribute__ ((aligned (ALT_CACHE_LINE_SIZE)));
         uint8_t * scr_buf_8;
 
         /*  Read SRC register*/
-        status = alt_sdmmc_card_scr_get(&scr_reg);
+        status = alt_sdmmc_card_scr_get(scr_reg);
         if (status != ALT_E_SUCCESS)
         {
             return status;
         }
    
-        scr_buf_8 = (uint8_t*)&scr_reg;
+        scr_buf_8 = (uint8_t*)scr_reg;
         card_info->scr_sd_spec = scr_buf_8[0] & 0xF;
         card_info->scr_bus_widths = scr_buf_8[1] & 0xF;
 #ifdef LOGGER
@@ -3147,7 +3236,7 @@ static ALT_STATUS_CODE alt_sdmmc_card_enum_sd(ALT_SDMMC_CARD_INFO_t *card_info)
 static ALT_STATUS_CODE alt_sdmmc_card_read_switch(ALT_SDMMC_CARD_INFO_t * card_info)
 {
     ALT_STATUS_CODE status = ALT_E_SUCCESS;
-    uint8_t switch_function[64] = {0};
+    uint8_t switch_function[64] __attribute__ ((aligned (ALT_CACHE_LINE_SIZE))) = {0};
 
     card_info->high_speed = false;
     if ((card_info->scr_sd_spec == 0) || !(card_info->csd_ccc & (CCC_CLASS_10 | CCC_CLASS_11)) )/*  version 1.01 or ! Class 10*/
@@ -3387,11 +3476,16 @@ ALT_STATUS_CODE alt_sdmmc_command_send(ALT_SDMMC_CMD_TYPE_t command_type,
     return status;
 }
 
-static ALT_STATUS_CODE alt_sdmmc_transfer(ALT_SDMMC_CARD_INFO_t * card_info,
-                                          uint32_t start_addr,
-                                          uint32_t buffer[],
-                                          const size_t buf_len,
-                                          ALT_SDMMC_TMOD_t transfer_mode)
+/*
+// Set up the controller and send the transfer command. For DMA transfers the
+// descriptors are filled and the data moves in the background; otherwise all
+// data has been moved to/from the FIFO on return.
+*/
+static ALT_STATUS_CODE alt_sdmmc_transfer_begin(ALT_SDMMC_CARD_INFO_t * card_info,
+                                                uint32_t start_block,
+                                                uint32_t buffer[],
+                                                const size_t buf_len,
+                                                ALT_SDMMC_TMOD_t transfer_mode)
 {
     ALT_STATUS_CODE status = ALT_E_SUCCESS;
     uint32_t block_count;
@@ -3411,8 +3505,7 @@ static ALT_STATUS_CODE alt_sdmmc_transfer(ALT_SDMMC_CARD_INFO_t * card_info,
 
     block_size = alt_sdmmc_block_size_get();
 
-    if (   (start_addr % block_size != 0) 
-        || (buf_len    % block_size != 0))
+    if (buf_len % block_size != 0)
     {
         return ALT_E_BAD_ARG;
     }
@@ -3460,25 +3553,25 @@ static ALT_STATUS_CODE alt_sdmmc_transfer(ALT_SDMMC_CARD_INFO_t * card_info,
         /*  Clean descriptor chain*/
         alt_sdmmc_desc_chain_clear();
         
-        alt_sdmmc_dma_start(dma_cur_descr, 0x0,
+        alt_sdmmc_dma_start(dma_cur_descr, ALT_SDMMC_DMA_DESC_SKIP,
                             ALT_SDMMC_DMA_PBL_1, false);
         /* Enable all dma interrupt status*/
         alt_sdmmc_dma_int_enable(ALT_SDMMC_DMA_INT_STATUS_ALL);
     }
 
 #ifdef LOGGER
-    dprintf("\nstart_addr = %d\n", (int)start_addr);
+    dprintf("\nstart_block = %d\n", (int)start_block);
 #endif
 
-    /* Send transfer command*/
+    /* Send transfer command. High capacity cards are block addressed, others byte addressed*/
 
     if (card_info->high_capacity)
     {
-        status = alt_sdmmc_command_send(ALT_SDMMC_CMD_TYPE_BASIC, (ALT_SDMMC_CMD_INDEX_t)cmd_index, start_addr / block_size, NULL);
+        status = alt_sdmmc_command_send(ALT_SDMMC_CMD_TYPE_BASIC, (ALT_SDMMC_CMD_INDEX_t)cmd_index, start_block, NULL);
     }
     else
     {
-        status = alt_sdmmc_command_send(ALT_SDMMC_CMD_TYPE_BASIC, (ALT_SDMMC_CMD_INDEX_t)cmd_index, start_addr, NULL);
+        status = alt_sdmmc_command_send(ALT_SDMMC_CMD_TYPE_BASIC, (ALT_SDMMC_CMD_INDEX_t)cmd_index, start_block * block_size, NULL);
     }
 
     if (status != ALT_E_SUCCESS)
@@ -3490,13 +3583,25 @@ static ALT_STATUS_CODE alt_sdmmc_transfer(ALT_SDMMC_CARD_INFO_t * card_info,
     if (alt_sdmmc_is_dma_enabled())
     {
         /* Fill descriptors*/
-        status = alt_sdmmc_dma_trans_helper(buffer, byte_count);
+        status = alt_sdmmc_dma_trans_helper(buffer, byte_count, transfer_mode);
     }
     else
     {
         status = alt_sdmmc_transfer_helper(buffer, byte_count, transfer_mode);
     }
 
+    return status;
+}
+
+static ALT_STATUS_CODE alt_sdmmc_transfer(ALT_SDMMC_CARD_INFO_t * card_info,
+                                          uint32_t start_block,
+                                          uint32_t buffer[],
+                                          const size_t buf_len,
+                                          ALT_SDMMC_TMOD_t transfer_mode)
+{
+    ALT_STATUS_CODE status;
+
+    status = alt_sdmmc_transfer_begin(card_info, start_block, buffer, buf_len, transfer_mode);
     if (status != ALT_E_SUCCESS)
     {
         return status;
@@ -3508,12 +3613,107 @@ static ALT_STATUS_CODE alt_sdmmc_transfer(ALT_SDMMC_CARD_INFO_t * card_info,
     return status;
 }
 
+/*
+// This function starts an SDMMC transfer without waiting for it to complete.
+*/
+ALT_STATUS_CODE alt_sdmmc_transfer_start(ALT_SDMMC_CARD_INFO_t * card_info, uint32_t block, void *buffer, const size_t size, ALT_SDMMC_TMOD_t mode)
+{
+    ALT_STATUS_CODE status;
+
+    /*  Only DMA transfers which fit in the descriptor chain can run in the background*/
+    if (alt_sdmmc_is_dma_enabled() != ALT_E_TRUE)
+    {
+        return ALT_E_BAD_OPERATION;
+    }
+    if ((size == 0) || (size > ALT_SDMMC_DMA_MAX_TRANSFER_SIZE))
+    {
+        return ALT_E_BAD_ARG;
+    }
+
+    status = alt_sdmmc_transfer_begin(card_info, block, buffer, size, mode);
+    if (status != ALT_E_SUCCESS)
+    {
+        return status;
+    }
+
+    /*  Only signal completion or errors, not command done or FIFO requests*/
+    alt_sdmmc_int_disable(  ALT_SDMMC_INT_STATUS_CMD
+                          | ALT_SDMMC_INT_STATUS_TXDR
+                          | ALT_SDMMC_INT_STATUS_RXDR
+                          | ALT_SDMMC_INT_STATUS_ACD);
+    alt_sdmmc_dma_int_disable(ALT_SDMMC_DMA_INT_STATUS_ALL);
+    alt_sdmmc_dma_int_enable(  ALT_SDMMC_DMA_INT_STATUS_FBE
+                             | ALT_SDMMC_DMA_INT_STATUS_CES
+                             | ALT_SDMMC_DMA_INT_STATUS_AI);
+
+    return ALT_E_SUCCESS;
+}
+
+/*
+// Returns ALT_E_TRUE if a transfer started by alt_sdmmc_transfer_start() has completed.
+*/
+ALT_STATUS_CODE alt_sdmmc_transfer_is_complete(void)
+{
+    uint32_t timeout;
+    uint32_t int_status = alt_sdmmc_int_status_get();
+
+    /*  Error or abnormal DMA. Clear status so the interrupt is released*/
+    if (   (alt_sdmmc_error_status_detect() != ALT_E_SUCCESS)
+        || (alt_sdmmc_dma_int_status_get() & ALT_SDMMC_DMA_INT_STATUS_AI))
+    {
+        alt_sdmmc_int_clear(ALT_SDMMC_INT_STATUS_ALL);
+        alt_sdmmc_dma_int_clear(ALT_SDMMC_DMA_INT_STATUS_ALL);
+        alt_sdmmc_dma_cache_complete();
+        return ALT_E_ERROR;
+    }
+
+    if (!(int_status & ALT_SDMMC_INT_STATUS_DTO))
+    {
+        return ALT_E_FALSE;
+    }
+    alt_sdmmc_int_clear(ALT_SDMMC_INT_STATUS_DTO);
+
+    /*  Stop command of a multiple block transfer follows data over*/
+    timeout = ALT_SDMMC_TMO_WAITER;
+    while (!alt_sdmmc_is_idle() && --timeout)
+        ;
+    alt_sdmmc_dma_cache_complete();
+    if (timeout == 0)
+    {
+        dprintf("Timed out waiting for SDMMC to become idle\n");
+        return ALT_E_ERROR;
+    }
+
+    return ALT_E_TRUE;
+}
+
+/*
+// Returns ALT_E_TRUE if a new transfer can be started without waiting.
+*/
+ALT_STATUS_CODE alt_sdmmc_transfer_is_ready(void)
+{
+    if ((alt_sdmmc_is_idle() == ALT_E_TRUE) && (alt_sdmmc_is_busy() == ALT_E_FALSE))
+    {
+        return ALT_E_TRUE;
+    }
+    else
+    {
+        return ALT_E_FALSE;
+    }
+}
+
 /*
 // This function performs SDMMC write.
 */
 ALT_STATUS_CODE alt_sdmmc_write(ALT_SDMMC_CARD_INFO_t * card_info, void *dest, void *src, const size_t size)
 {
-    return alt_sdmmc_transfer(card_info, (uint32_t)dest, src, size, ALT_SDMMC_TMOD_WRITE);
+    uint16_t block_size = alt_sdmmc_block_size_get();
+
+    if ((uint32_t)dest % block_size != 0)
+    {
+        return ALT_E_BAD_ARG;
+    }
+    return alt_sdmmc_transfer(card_info, (uint32_t)dest / block_size, src, size, ALT_SDMMC_TMOD_WRITE);
 }
 
 /*
@@ -3521,7 +3721,29 @@ ALT_STATUS_CODE alt_sdmmc_write(ALT_SDMMC_CARD_INFO_t * card_info, void *dest, v
 */
 ALT_STATUS_CODE alt_sdmmc_read(ALT_SDMMC_CARD_INFO_t * card_info, void *dest, void *src, const size_t size)
 {
-    return alt_sdmmc_transfer(card_info, (uint32_t)src, dest, size, ALT_SDMMC_TMOD_READ);
+    uint16_t block_size = alt_sdmmc_block_size_get();
+
+    if ((uint32_t)src % block_size != 0)
+    {
+        return ALT_E_BAD_ARG;
+    }
+    return alt_sdmmc_transfer(card_info, (uint32_t)src / block_size, dest, size, ALT_SDMMC_TMOD_READ);
+}
+
+/*
+// This function performs SDMMC write by block number.
+*/
+ALT_STATUS_CODE alt_sdmmc_block_write(ALT_SDMMC_CARD_INFO_t * card_info, uint32_t dest_block, void *src, const size_t size)
+{
+    return alt_sdmmc_transfer(card_info, dest_block, src, size, ALT_SDMMC_TMOD_WRITE);
+}
+
+/*
+// This function performs SDMMC read by block number.
+*/
+ALT_STATUS_CODE alt_sdmmc_block_read(ALT_SDMMC_CARD_INFO_t * card_info, void *dest, uint32_t src_block, const size_t size)
+{
+    return alt_sdmmc_transfer(card_info, src_block, dest, size, ALT_SDMMC_TMOD_READ);
 }
 
 /*
@@ -3569,7 +3791,7 @@ static ALT_STATUS_CODE alt_sdmmc_card_switch_function(uint32_t function_arg, uin
         /*  Clean descriptor chain*/
         alt_sdmmc_desc_chain_clear();
 
-        alt_sdmmc_dma_start(dma_cur_descr, 0x0,
+        alt_sdmmc_dma_start(dma_cur_descr, ALT_SDMMC_DMA_DESC_SKIP,
                             ALT_SDMMC_DMA_PBL_1, false);
         /* Enable all dma interrupt status*/
         alt_sdmmc_dma_int_enable(ALT_SDMMC_DMA_INT_STATUS_ALL);
@@ -3590,7 +3812,7 @@ static ALT_STATUS_CODE alt_sdmmc_card_switch_function(uint32_t function_arg, uin
     if (alt_sdmmc_is_dma_enabled())
     {
         /* Fill descriptors*/
-        status = alt_sdmmc_dma_trans_helper((uint32_t*)switch_status, 64);
+        status = alt_sdmmc_dma_trans_helper((uint32_t*)switch_status, 64, ALT_SDMMC_TMOD_READ);
     }
     else
     {
@@ -3623,11 +3845,6 @@ static ALT_STATUS_CODE alt_sdmmc_card_switch_function(uint32_t function_arg, uin
     return status;
 }
 
-__attribute__((weak)) ALT_STATUS_CODE alt_cache_system_purge(__attribute__((unused))void * address,__attribute__((unused)) size_t length)
-{
-    return ALT_E_SUCCESS;
-}
-
 #if defined (soc_a10)
 ALT_STATUS_CODE alt_sdmmc_ecc_start(void)
 {
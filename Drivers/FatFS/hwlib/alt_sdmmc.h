@@ -580,6 +580,17 @@ ALT_STATUS_CODE alt_sdmmc_int_disable(const uint32_t mask);
  */
 ALT_STATUS_CODE alt_sdmmc_int_enable(const uint32_t mask);
 
+/*!
+ * Disable the SD/MMC controller \b ALT_INT_INTERRUPT_SDMMC_IRQ interrupt signal.
+ *
+ * The enabled status conditions are unchanged, and are still reported by
+ * alt_sdmmc_int_status_get(). The signal is enabled again by the next call to
+ * alt_sdmmc_int_enable(), which happens for every command sent to the card.
+ *
+ * \retval      ALT_E_SUCCESS   Indicates successful completion.
+ */
+ALT_STATUS_CODE alt_sdmmc_int_signal_disable(void);
+
 /*!
  * This type definition enumerates the interrupt status conditions that contribute
  * to the \b ALT_INT_INTERRUPT_SDMMC_IRQ signal state.
@@ -799,9 +810,21 @@ ALT_STATUS_CODE alt_sdmmc_card_clk_div_set(const uint32_t clk_div);
  */
 uint32_t alt_sdmmc_card_speed_get(void);
 
+/*!
+ * The fastest card clock in default speed mode, in Hz.
+ */
+#define ALT_SDMMC_DEFAULT_SPEED_MAX     25000000
+
+/*!
+ * The fastest card clock in high speed mode, in Hz.
+ */
+#define ALT_SDMMC_HIGH_SPEED_MAX        50000000
+
 /*!
  * Sets the card data transfer rate. The unit is compatible with
- * ALT_SDMMC_CARD_INFO_t::tran_speed.
+ * ALT_SDMMC_CARD_INFO_t::tran_speed. Rates above ALT_SDMMC_DEFAULT_SPEED_MAX
+ * switch the card to high speed mode with CMD6, and lower rates switch it
+ * back.
  *
  * \param       card_info
  *              A pointer to a ALT_SDMMC_CARD_INFO_t structure that holds
@@ -811,6 +834,7 @@ uint32_t alt_sdmmc_card_speed_get(void);
  * \param       Desired data transfer rate in bit/s.
  *
  * \retval      ALT_E_SUCCESS   The operation was successful.
+ * \retval      ALT_E_BAD_ARG   The card does not support high speed mode.
  * \retval      ALT_E_ERROR     The operation failed.
  */
 ALT_STATUS_CODE alt_sdmmc_card_speed_set(ALT_SDMMC_CARD_INFO_t *card_info, uint32_t xfer_speed);
@@ -1607,6 +1631,27 @@ ALT_STATUS_CODE alt_sdmmc_fifo_write(const void *src, const size_t size);
  * @{
  */
 
+/*!
+ * Size in bytes of each of the two buffers described by each internal DMA
+ * descriptor. The largest power of two which fits the 13-bit buffer size
+ * fields.
+ */
+#define ALT_SDMMC_DMA_SEGMENT_SIZE      4096
+
+/*!
+ * The number of internal DMA descriptors in the ring.
+ */
+#define ALT_SDMMC_DMA_DESC_COUNT        64
+
+/*!
+ * The largest block read or write which can be described by the DMA
+ * descriptor ring at once, and so the largest which can be started by
+ * alt_sdmmc_transfer_start(). Blocking reads and writes of any size are
+ * issued as a single READ/WRITE_MULTIPLE_BLOCK command, with descriptors
+ * refilled as the DMA releases them.
+ */
+#define ALT_SDMMC_DMA_MAX_TRANSFER_SIZE (ALT_SDMMC_DMA_SEGMENT_SIZE * 2 * ALT_SDMMC_DMA_DESC_COUNT)
+
 /*!
  * Reads a block of data from the SD/MMC flash card.
  *
@@ -1663,6 +1708,131 @@ ALT_STATUS_CODE alt_sdmmc_read(ALT_SDMMC_CARD_INFO_t *card_info, void *dest, voi
  */
 ALT_STATUS_CODE alt_sdmmc_write(ALT_SDMMC_CARD_INFO_t *card_info, void *dest, void *src, const size_t size);
 
+/*!
+ * Reads blocks of data from the SD/MMC flash card by block number.
+ *
+ * As alt_sdmmc_read(), but the card is addressed in blocks rather than bytes,
+ * so the whole of a high capacity (SDHC/SDXC) card beyond 4GB can be reached.
+ *
+ *
+ * \param       card_info
+ *              A pointer to a ALT_SDMMC_CARD_INFO_t structure that holds
+ *              identification and device property information for any detected
+ *              card.
+ *
+ * \param       dest
+ *              The address of a caller supplied destination buffer in system
+ *              memory large enough to contain the requested blocks of flash data.
+ *
+ * \param       src_block
+ *              The number of the first block to read.
+ *
+ * \param       size
+ *              The number of data bytes to read, a multiple of the block size.
+ *
+ * \retval      ALT_E_SUCCESS   The operation was successful.
+ * \retval      ALT_E_BAD_ARG   The size is not a multiple of the block size.
+ * \retval      ALT_E_ERROR     The operation failed.
+ */
+ALT_STATUS_CODE alt_sdmmc_block_read(ALT_SDMMC_CARD_INFO_t *card_info, void *dest, uint32_t src_block, const size_t size);
+
+/*!
+ * Writes blocks of data to the SD/MMC flash card by block number.
+ *
+ * As alt_sdmmc_write(), but the card is addressed in blocks rather than bytes,
+ * so the whole of a high capacity (SDHC/SDXC) card beyond 4GB can be reached.
+ *
+ *
+ * \param       card_info
+ *              A pointer to a ALT_SDMMC_CARD_INFO_t structure that holds
+ *              identification and device property information for any detected
+ *              card.
+ *
+ * \param       dest_block
+ *              The number of the first block to write.
+ *
+ * \param       src
+ *              The source address in system memory to begin writing data from.
+ *
+ * \param       size
+ *              The number of data bytes to write, a multiple of the block size.
+ *
+ * \retval      ALT_E_SUCCESS   Indicates successful completion.
+ * \retval      ALT_E_BAD_ARG   The size is not a multiple of the block size.
+ * \retval      ALT_E_ERROR     Indicates an error occurred.
+ */
+ALT_STATUS_CODE alt_sdmmc_block_write(ALT_SDMMC_CARD_INFO_t *card_info, uint32_t dest_block, void *src, const size_t size);
+
+/*!
+ * This type enumerates the direction of a block transfer.
+ */
+typedef enum ALT_SDMMC_TMOD_e
+{
+    ALT_SDMMC_TMOD_READ          = 0,   /*!< Read from the card */
+    ALT_SDMMC_TMOD_WRITE         = 1    /*!< Write to the card */
+} ALT_SDMMC_TMOD_t;
+
+/*!
+ * Start a block transfer to or from the SD/MMC flash card in the background.
+ *
+ * The transfer command is sent and the internal DMA controller descriptors are
+ * filled, then the function returns while the data is moved. Only the data
+ * transfer over and error status conditions are left enabled, so the
+ * \b ALT_INT_INTERRUPT_SDMMC_IRQ signal indicates when the transfer ends. The
+ * transfer must then be finished with alt_sdmmc_transfer_is_complete().
+ *
+ * The internal DMA controller must be enabled, the \e buffer must be word
+ * aligned, and \e size must be a multiple of the block size.
+ *
+ *
+ * \param       card_info
+ *              A pointer to a ALT_SDMMC_CARD_INFO_t structure that holds
+ *              identification and device property information for any detected
+ *              card.
+ *
+ * \param       block
+ *              The number of the first block to transfer.
+ *
+ * \param       buffer
+ *              The buffer in system memory to read data into or write data from.
+ *
+ * \param       size
+ *              The number of data bytes to transfer, up to
+ *              ALT_SDMMC_DMA_MAX_TRANSFER_SIZE.
+ *
+ * \param       mode
+ *              ALT_SDMMC_TMOD_READ or ALT_SDMMC_TMOD_WRITE.
+ *
+ * \retval      ALT_E_SUCCESS       The transfer was started.
+ * \retval      ALT_E_BAD_OPERATION The internal DMA controller is not enabled.
+ * \retval      ALT_E_BAD_ARG       The size is invalid.
+ * \retval      ALT_E_ERROR         The transfer could not be started.
+ */
+ALT_STATUS_CODE alt_sdmmc_transfer_start(ALT_SDMMC_CARD_INFO_t *card_info, uint32_t block, void *buffer, const size_t size, ALT_SDMMC_TMOD_t mode);
+
+/*!
+ * Check whether a transfer started by alt_sdmmc_transfer_start() has completed.
+ *
+ * Does not wait for the transfer. Once completion or an error has been reported
+ * the status conditions are cleared, releasing the interrupt signal.
+ *
+ * \retval      ALT_E_TRUE      The transfer completed successfully.
+ * \retval      ALT_E_FALSE     The transfer is still in progress.
+ * \retval      ALT_E_ERROR     The transfer ended with an error.
+ */
+ALT_STATUS_CODE alt_sdmmc_transfer_is_complete(void);
+
+/*!
+ * Check whether a new transfer can be started without waiting.
+ *
+ * After a write the card may remain busy programming the data for some time
+ * after the transfer has completed.
+ *
+ * \retval      ALT_E_TRUE      The controller is idle and the card is not busy.
+ * \retval      ALT_E_FALSE     The controller or card is busy.
+ */
+ALT_STATUS_CODE alt_sdmmc_transfer_is_ready(void);
+
 /*! @} */
 
 /*! @} */
@@ -0,0 +1,627 @@
+/*
+ * Wear-Levelling Flash Log
+ * ------------------------
+ *
+ * Log-structured block layer which maps logical sectors
+ * onto a region of any flash device with a generic flash
+ * driver.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#include "FlashLog.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "Util/crc_software.h"
+
+#define FLASHLOG_BLOCK_MAGIC   0x31474C46  // "FLG1"
+#define FLASHLOG_RECORD_MAGIC  0xA5000000
+#define FLASHLOG_RECORD_MASK   0xFF000000
+
+#define FLASHLOG_UNMAPPED      0xFFFFFFFF
+#define FLASHLOG_NONE          UINT_MAX
+
+//Record types
+enum {
+    FLASHLOG_RECORD_SECTOR = 1,
+    FLASHLOG_RECORD_KEY,
+    FLASHLOG_RECORD_DELETE
+};
+
+//Block states
+enum {
+    FLASHLOG_BLOCK_UNKNOWN,
+    FLASHLOG_BLOCK_FREE,
+    FLASHLOG_BLOCK_ACTIVE,
+    FLASHLOG_BLOCK_FULL
+};
+
+//Block header
+typedef struct {
+    uint32_t magic;
+    uint32_t eraseCount;
+    uint32_t eraseCheck;  // ~eraseCount
+    uint32_t reserved;
+} FlashLogBlockHeader_t;
+
+//Record header
+typedef struct {
+    uint32_t tag;         // Magic (31:24), type (23:16), length (15:0)
+    uint32_t id;          // Logical sector, or key + sectorCount
+    uint32_t seq;         // Sequence number, newest wins
+    uint32_t crc;         // CRC32 of tag, id, seq and data
+} FlashLogRecord_t;
+
+#define FLASHLOG_RECORD_TAG(type, length) (FLASHLOG_RECORD_MAGIC | ((type) << 16) | (length))
+#define FLASHLOG_RECORD_TYPE(tag)         (((tag) >> 16) & 0xFF)
+#define FLASHLOG_RECORD_LENGTH(tag)       ((tag) & 0xFFFF)
+
+//Sequence comparison, safe against wrapping
+#define FLASHLOG_SEQ_NEWER(a, b) ((int32_t)((a) - (b)) > 0)
+
+/*
+ * Internal Functions
+ */
+
+static unsigned int _FlashLog_roundUp(unsigned int val, unsigned int align) {
+    return (val + align - 1) & ~(align - 1);
+}
+
+static unsigned int _FlashLog_mapSize(PFlashLogCtx_t ctx) {
+    return ctx->sectorCount + ctx->keyCount;
+}
+
+static unsigned int _FlashLog_blockAddress(PFlashLogCtx_t ctx, unsigned int block) {
+    return ctx->base + block * ctx->blockSize;
+}
+
+static unsigned int _FlashLog_slotAddress(PFlashLogCtx_t ctx, unsigned int phys) {
+    unsigned int block = phys / ctx->slotsPerBlock;
+    unsigned int slot  = phys % ctx->slotsPerBlock;
+    return _FlashLog_blockAddress(ctx, block) + ctx->headerSize + slot * ctx->slotSize;
+}
+
+//Check whether a physical slot is still in the write buffer
+static bool _FlashLog_inBuffer(PFlashLogCtx_t ctx, unsigned int phys) {
+    return ctx->bufferCount && (phys >= ctx->bufferStart) && (phys < ctx->bufferStart + ctx->bufferCount);
+}
+
+static bool _FlashLog_isErased(const uint8_t* data, unsigned int length) {
+    const uint32_t* word = (const uint32_t*)data;
+    for (unsigned int idx = 0; idx < length / sizeof(uint32_t); idx++) {
+        if (word[idx] != 0xFFFFFFFF) return false;
+    }
+    return true;
+}
+
+static uint32_t _FlashLog_recordCrc(const FlashLogRecord_t* rec, const uint8_t* data, unsigned int length) {
+    uint32_t crc = SWCRC_update(&SWCRC_CRC32, 0xFFFFFFFF, (const uint8_t*)rec, offsetof(FlashLogRecord_t, crc));
+    crc = SWCRC_update(&SWCRC_CRC32, crc, data, length);
+    return crc ^ 0xFFFFFFFF;
+}
+
+//Check a record read from flash is complete and belongs to this log
+static bool _FlashLog_recordValid(PFlashLogCtx_t ctx, const uint8_t* slot) {
+    const FlashLogRecord_t* rec = (const FlashLogRecord_t*)slot;
+    if ((rec->tag & FLASHLOG_RECORD_MASK) != FLASHLOG_RECORD_MAGIC) return false;
+    unsigned int type = FLASHLOG_RECORD_TYPE(rec->tag);
+    if ((type < FLASHLOG_RECORD_SECTOR) || (type > FLASHLOG_RECORD_DELETE)) return false;
+    if (FLASHLOG_RECORD_LENGTH(rec->tag) > FLASHLOG_SECTOR_SIZE) return false;
+    if (rec->id >= _FlashLog_mapSize(ctx)) return false;
+    return rec->crc == _FlashLog_recordCrc(rec, slot + ctx->headerSize, FLASHLOG_RECORD_LENGTH(rec->tag));
+}
+
+//Read from a slot, which may still be in the write buffer
+static HpsErr_t _FlashLog_readSlot(PFlashLogCtx_t ctx, unsigned int phys, unsigned int offset, unsigned int length, uint8_t* dest) {
+    if (_FlashLog_inBuffer(ctx, phys)) {
+        memcpy(dest, ctx->buffer + (phys - ctx->bufferStart) * ctx->slotSize + offset, length);
+        return ERR_SUCCESS;
+    }
+    return FLASH_read(ctx->flash, _FlashLog_slotAddress(ctx, phys) + offset, length, dest);
+}
+
+//Program the write buffer to flash
+// - The records stay buffered if programming fails, so the flush can be retried.
+static HpsErr_t _FlashLog_flush(PFlashLogCtx_t ctx) {
+    if (!ctx->bufferCount) return ERR_SUCCESS;
+    unsigned int length = ctx->bufferCount * ctx->slotSize;
+    HpsErr_t status = FLASH_write(ctx->flash, _FlashLog_slotAddress(ctx, ctx->bufferStart), length, ctx->buffer);
+    if (IS_ERROR(status)) return status;
+    //Next slot taken starts a new buffer
+    ctx->bufferCount = 0;
+    return status;
+}
+
+//Erase a block and write its header
+static HpsErr_t _FlashLog_eraseBlock(PFlashLogCtx_t ctx, unsigned int block) {
+    FlashLogBlock_t* blk = &ctx->blocks[block];
+    HpsErr_t status = FLASH_erase(ctx->flash, _FlashLog_blockAddress(ctx, block), ctx->blockSize);
+    if (IS_ERROR(status)) return status;
+    blk->eraseCount++;
+    ctx->blockErases++;
+    //Header keeps the erase count across power cycles
+    memset(ctx->scratch, 0xFF, ctx->headerSize);
+    FlashLogBlockHeader_t* hdr = (FlashLogBlockHeader_t*)ctx->scratch;
+    hdr->magic = FLASHLOG_BLOCK_MAGIC;
+    hdr->eraseCount = blk->eraseCount;
+    hdr->eraseCheck = ~blk->eraseCount;
+    status = FLASH_write(ctx->flash, _FlashLog_blockAddress(ctx, block), ctx->headerSize, ctx->scratch);
+    if (IS_ERROR(status)) return status;
+    //Now free
+    if (blk->state != FLASHLOG_BLOCK_FREE) ctx->freeBlocks++;
+    blk->state = FLASHLOG_BLOCK_FREE;
+    blk->used = 0;
+    blk->valid = 0;
+    return ERR_SUCCESS;
+}
+
+//Open the least worn free block for appending
+static HpsErr_t _FlashLog_openBlock(PFlashLogCtx_t ctx) {
+    unsigned int best = FLASHLOG_NONE;
+    for (unsigned int block = 0; block < ctx->blockCount; block++) {
+        if (ctx->blocks[block].state != FLASHLOG_BLOCK_FREE) continue;
+        if ((best == FLASHLOG_NONE) || (ctx->blocks[block].eraseCount < ctx->blocks[best].eraseCount)) {
+            best = block;
+        }
+    }
+    if (best == FLASHLOG_NONE) return ERR_NOSPACE;
+    ctx->blocks[best].state = FLASHLOG_BLOCK_ACTIVE;
+    ctx->freeBlocks--;
+    ctx->activeBlock = best;
+    return ERR_SUCCESS;
+}
+
+//Choose a block to garbage collect
+// - greedy selects the full block with the fewest live records, if any are stale.
+// - wear selects the least worn full block if the erase count spread is too high,
+//   which moves cold data so the block can be reused.
+static unsigned int _FlashLog_pickVictim(PFlashLogCtx_t ctx, bool greedy, bool wear) {
+    unsigned int fewest = FLASHLOG_NONE;
+    unsigned int coldest = FLASHLOG_NONE;
+    uint32_t maxErase = 0;
+    for (unsigned int block = 0; block < ctx->blockCount; block++) {
+        FlashLogBlock_t* blk = &ctx->blocks[block];
+        if (blk->eraseCount > maxErase) maxErase = blk->eraseCount;
+        if (blk->state != FLASHLOG_BLOCK_FULL) continue;
+        if ((fewest == FLASHLOG_NONE) || (blk->valid < ctx->blocks[fewest].valid)) fewest = block;
+        if ((coldest == FLASHLOG_NONE) || (blk->eraseCount < ctx->blocks[coldest].eraseCount)) coldest = block;
+    }
+    if (wear && (coldest != FLASHLOG_NONE) && ((maxErase - ctx->blocks[coldest].eraseCount) > FLASHLOG_WEAR_THRESHOLD)) {
+        return coldest;
+    }
+    if (greedy && (fewest != FLASHLOG_NONE) && (ctx->blocks[fewest].valid < ctx->slotsPerBlock)) {
+        return fewest;
+    }
+    return FLASHLOG_NONE;
+}
+
+static HpsErr_t _FlashLog_collectBlock(PFlashLogCtx_t ctx, unsigned int maxCopies);
+
+//Allocate the next slot in the log
+// - Returns the physical slot in *phys. The slot is in the write buffer.
+// - If forGc is false, garbage collection will be run if required to keep
+//   the reserve blocks free.
+static HpsErr_t _FlashLog_allocSlot(PFlashLogCtx_t ctx, bool forGc, unsigned int* phys) {
+    HpsErr_t status;
+    //Buffer is still full if its last flush failed, so retry before taking another slot
+    if (ctx->bufferCount >= FLASHLOG_WRITE_BUFFER_SLOTS) {
+        status = _FlashLog_flush(ctx);
+        if (IS_ERROR(status)) return status;
+    }
+    //Finish any partly collected block first, otherwise new records could
+    //use up the space its remaining live records need to move to.
+    if (!forGc && (ctx->gcBlock != FLASHLOG_NONE)) {
+        status = _FlashLog_collectBlock(ctx, UINT_MAX);
+        if (IS_ERROR(status)) return status;
+    }
+    while ((ctx->activeBlock == FLASHLOG_NONE) || (ctx->blocks[ctx->activeBlock].used >= ctx->slotsPerBlock)) {
+        //Active block full. Buffer can't span blocks, so flush first.
+        status = _FlashLog_flush(ctx);
+        if (IS_ERROR(status)) return status;
+        if (ctx->activeBlock != FLASHLOG_NONE) {
+            ctx->blocks[ctx->activeBlock].state = FLASHLOG_BLOCK_FULL;
+            ctx->activeBlock = FLASHLOG_NONE;
+        }
+        //Reclaim space if only the reserve is left. This may leave the
+        //collector's block active with space, so check again.
+        if (!forGc && (ctx->freeBlocks < FLASHLOG_RESERVE_BLOCKS)) {
+            ctx->gcBlock = _FlashLog_pickVictim(ctx, true, false);
+            ctx->gcSlot = 0;
+            if (ctx->gcBlock == FLASHLOG_NONE) return ERR_NOSPACE;
+            status = _FlashLog_collectBlock(ctx, UINT_MAX);
+            if (IS_ERROR(status)) return status;
+            continue;
+        }
+        status = _FlashLog_openBlock(ctx);
+        if (IS_ERROR(status)) return status;
+    }
+    //Take the next slot
+    *phys = ctx->activeBlock * ctx->slotsPerBlock + ctx->blocks[ctx->activeBlock].used++;
+    if (!ctx->bufferCount) ctx->bufferStart = *phys;
+    ctx->bufferCount++;
+    return ERR_SUCCESS;
+}
+
+//Append a record to the log
+static HpsErr_t _FlashLog_append(PFlashLogCtx_t ctx, unsigned int type, unsigned int id, const uint8_t* data, unsigned int length, bool forGc) {
+    unsigned int phys;
+    HpsErr_t status = _FlashLog_allocSlot(ctx, forGc, &phys);
+    if (IS_ERROR(status)) return status;
+    //Build record in the write buffer
+    uint8_t* slot = ctx->buffer + (phys - ctx->bufferStart) * ctx->slotSize;
+    memset(slot, 0xFF, ctx->slotSize);
+    FlashLogRecord_t* rec = (FlashLogRecord_t*)slot;
+    rec->tag = FLASHLOG_RECORD_TAG(type, length);
+    rec->id = id;
+    rec->seq = ctx->seq++;
+    if (length) memcpy(slot + ctx->headerSize, data, length);
+    rec->crc = _FlashLog_recordCrc(rec, slot + ctx->headerSize, length);
+    //Previous copy is now stale
+    uint32_t old = ctx->map[id];
+    if (old != FLASHLOG_UNMAPPED) ctx->blocks[old / ctx->slotsPerBlock].valid--;
+    ctx->map[id] = phys;
+    ctx->blocks[phys / ctx->slotsPerBlock].valid++;
+    //Program once a full buffer has been collected
+    if (ctx->bufferCount >= FLASHLOG_WRITE_BUFFER_SLOTS) return _FlashLog_flush(ctx);
+    return ERR_SUCCESS;
+}
+
+//Garbage collect the current victim block
+// - Moves at most maxCopies live records.
+// - Returns ERR_AGAIN if the limit was reached, or ERR_SUCCESS once the block is erased.
+static HpsErr_t _FlashLog_collectBlock(PFlashLogCtx_t ctx, unsigned int maxCopies) {
+    HpsErr_t status;
+    FlashLogBlock_t* blk = &ctx->blocks[ctx->gcBlock];
+    const FlashLogRecord_t* rec = (const FlashLogRecord_t*)ctx->scratch;
+    while (blk->valid && (ctx->gcSlot < blk->used)) {
+        if (!maxCopies) return ERR_AGAIN;
+        unsigned int phys = ctx->gcBlock * ctx->slotsPerBlock + ctx->gcSlot;
+        //Check the header first, so stale data isn't read
+        status = FLASH_read(ctx->flash, _FlashLog_slotAddress(ctx, phys), ctx->headerSize, ctx->scratch);
+        if (IS_ERROR(status)) return status;
+        if (((rec->tag & FLASHLOG_RECORD_MASK) == FLASHLOG_RECORD_MAGIC) &&
+            (rec->id < _FlashLog_mapSize(ctx)) && (ctx->map[rec->id] == phys)) {
+            unsigned int length = FLASHLOG_RECORD_LENGTH(rec->tag);
+            status = FLASH_read(ctx->flash, _FlashLog_slotAddress(ctx, phys) + ctx->headerSize, length, ctx->scratch + ctx->headerSize);
+            if (IS_ERROR(status)) return status;
+            status = _FlashLog_append(ctx, FLASHLOG_RECORD_TYPE(rec->tag), rec->id, ctx->scratch + ctx->headerSize, length, true);
+            if (IS_ERROR(status)) return status;
+            ctx->gcCopies++;
+            maxCopies--;
+        }
+        ctx->gcSlot++;
+    }
+    //Copies must be in flash before the originals are erased
+    status = _FlashLog_flush(ctx);
+    if (IS_ERROR(status)) return status;
+    status = _FlashLog_eraseBlock(ctx, ctx->gcBlock);
+    if (IS_ERROR(status)) return status;
+    ctx->gcBlock = FLASHLOG_NONE;
+    return ERR_SUCCESS;
+}
+
+//Mount the log, rebuilding the map from the records in flash
+static HpsErr_t _FlashLog_mount(PFlashLogCtx_t ctx, bool format) {
+    HpsErr_t status = ERR_SUCCESS;
+    unsigned int mapSize = _FlashLog_mapSize(ctx);
+    //Sequence of the mapped record for each id, only needed while mounting
+    uint32_t* mapSeq = malloc(mapSize * sizeof(uint32_t));
+    if (!mapSeq) return ERR_ALLOCFAIL;
+    bool haveSeq = false;
+    uint32_t lastSeq = 0;
+    unsigned int lastBlock = FLASHLOG_NONE;
+    const FlashLogBlockHeader_t* hdr = (const FlashLogBlockHeader_t*)ctx->scratch;
+    const FlashLogRecord_t* rec = (const FlashLogRecord_t*)ctx->scratch;
+    for (unsigned int block = 0; block < ctx->blockCount; block++) {
+        FlashLogBlock_t* blk = &ctx->blocks[block];
+        status = FLASH_read(ctx->flash, _FlashLog_blockAddress(ctx, block), ctx->headerSize, ctx->scratch);
+        if (IS_ERROR(status)) break;
+        bool hdrValid = (hdr->magic == FLASHLOG_BLOCK_MAGIC) && (hdr->eraseCheck == ~hdr->eraseCount);
+        if (hdrValid) blk->eraseCount = hdr->eraseCount;
+        if (!hdrValid || format) {
+            //Not part of a log, or being formatted
+            status = _FlashLog_eraseBlock(ctx, block);
+            if (IS_ERROR(status)) break;
+            continue;
+        }
+        //Scan every slot, as torn writes may leave gaps
+        for (unsigned int slot = 0; slot < ctx->slotsPerBlock; slot++) {
+            unsigned int phys = block * ctx->slotsPerBlock + slot;
+            status = FLASH_read(ctx->flash, _FlashLog_slotAddress(ctx, phys), ctx->slotSize, ctx->scratch);
+            if (IS_ERROR(status)) break;
+            if (_FlashLog_isErased(ctx->scratch, ctx->slotSize)) continue;
+            blk->used = slot + 1;
+            if (!_FlashLog_recordValid(ctx, ctx->scratch)) continue;
+            //Newest copy of each id wins
+            uint32_t old = ctx->map[rec->id];
+            if ((old == FLASHLOG_UNMAPPED) || FLASHLOG_SEQ_NEWER(rec->seq, mapSeq[rec->id])) {
+                if (old != FLASHLOG_UNMAPPED) ctx->blocks[old / ctx->slotsPerBlock].valid--;
+                ctx->map[rec->id] = phys;
+                mapSeq[rec->id] = rec->seq;
+                blk->valid++;
+            }
+            if (!haveSeq || FLASHLOG_SEQ_NEWER(rec->seq, lastSeq)) {
+                haveSeq = true;
+                lastSeq = rec->seq;
+                lastBlock = block;
+            }
+        }
+        if (IS_ERROR(status)) break;
+        if (blk->used) {
+            blk->state = FLASHLOG_BLOCK_FULL;
+        } else {
+            blk->state = FLASHLOG_BLOCK_FREE;
+            ctx->freeBlocks++;
+        }
+    }
+    free(mapSeq);
+    if (IS_ERROR(status)) return status;
+    //Continue appending to the block with the newest record
+    ctx->seq = haveSeq ? (lastSeq + 1) : 0;
+    if ((lastBlock != FLASHLOG_NONE) && (ctx->blocks[lastBlock].used < ctx->slotsPerBlock)) {
+        ctx->blocks[lastBlock].state = FLASHLOG_BLOCK_ACTIVE;
+        ctx->activeBlock = lastBlock;
+    }
+    return ERR_SUCCESS;
+}
+
+static void _FlashLog_cleanup(PFlashLogCtx_t ctx) {
+    //Program anything still buffered
+    if (ctx->buffer && ctx->header.initialised) {
+        _FlashLog_flush(ctx);
+    }
+    free(ctx->map);
+    free(ctx->blocks);
+    free(ctx->buffer);
+    free(ctx->scratch);
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the flash log
+// - flash is the flash driver to use.
+// - base is the address of the region in flash, which must be block aligned.
+// - blockCount is the number of erase blocks in the region.
+// - sectorCount and keyCount are the number of logical sectors and keys provided.
+//   Together they must fit in the region with FLASHLOG_RESERVE_BLOCKS left over.
+// - If format is true, any existing contents are erased. Otherwise the existing
+//   log is mounted, and any blocks not belonging to a log are erased.
+// - Returns ERR_NOSPACE if the sectors and keys don't fit in the region.
+HpsErr_t FlashLog_initialise(PFlashCtx_t flash, unsigned int base, unsigned int blockCount, unsigned int sectorCount, unsigned int keyCount, bool format, PFlashLogCtx_t* pCtx) {
+    //Ensure user pointers valid
+    if (!flash) return ERR_NULLPTR;
+    if (!FLASH_isInitialised(flash)) return ERR_NOINIT;
+    if (!flash->blockSize || (base % flash->blockSize)) return ERR_ALIGNMENT;
+    if (blockCount <= FLASHLOG_RESERVE_BLOCKS) return ERR_TOOSMALL;
+    //Slots are aligned to the larger of the flash word size or 32-bit
+    unsigned int align = (flash->wordSize > sizeof(uint32_t)) ? flash->wordSize : sizeof(uint32_t);
+    if (align & (align - 1)) return ERR_NOSUPPORT;
+    unsigned int headerSize = _FlashLog_roundUp(sizeof(FlashLogRecord_t), align);
+    unsigned int slotSize = _FlashLog_roundUp(headerSize + FLASHLOG_SECTOR_SIZE, align);
+    if (flash->blockSize < headerSize + slotSize) return ERR_TOOSMALL;
+    unsigned int slotsPerBlock = (flash->blockSize - headerSize) / slotSize;
+    if (slotsPerBlock > UINT16_MAX) slotsPerBlock = UINT16_MAX;
+    //Check the sectors and keys fit, leaving the reserve for garbage collection
+    uint64_t capacity = (uint64_t)(blockCount - FLASHLOG_RESERVE_BLOCKS) * slotsPerBlock;
+    if ((uint64_t)sectorCount + keyCount > capacity) return ERR_NOSPACE;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_FlashLog_cleanup);
+    if (IS_ERROR(status)) return status;
+    //Save settings
+    PFlashLogCtx_t ctx = *pCtx;
+    ctx->flash = flash;
+    ctx->base = base;
+    ctx->blockCount = blockCount;
+    ctx->blockSize = flash->blockSize;
+    ctx->headerSize = headerSize;
+    ctx->slotSize = slotSize;
+    ctx->slotsPerBlock = slotsPerBlock;
+    ctx->sectorCount = sectorCount;
+    ctx->keyCount = keyCount;
+    ctx->activeBlock = FLASHLOG_NONE;
+    ctx->gcBlock = FLASHLOG_NONE;
+    //Allocate tables and buffers
+    ctx->map = malloc((sectorCount + keyCount) * sizeof(uint32_t));
+    ctx->blocks = calloc(blockCount, sizeof(FlashLogBlock_t));
+    ctx->buffer = malloc(FLASHLOG_WRITE_BUFFER_SLOTS * slotSize);
+    ctx->scratch = malloc(slotSize);
+    if (!ctx->map || !ctx->blocks || !ctx->buffer || !ctx->scratch) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    memset(ctx->map, 0xFF, (sectorCount + keyCount) * sizeof(uint32_t));
+    //Rebuild the map from flash
+    status = _FlashLog_mount(ctx, format);
+    if (IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+    //And initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+// - Returns true if driver previously initialised
+bool FlashLog_isInitialised(PFlashLogCtx_t ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Get the number of logical sectors
+HpsErrExt_t FlashLog_getSectorCount(PFlashLogCtx_t ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    return ctx->sectorCount;
+}
+
+//Read logical sectors
+// - Sectors which have never been written read as all 0xFF.
+HpsErr_t FlashLog_read(PFlashLogCtx_t ctx, unsigned int sector, unsigned int count, uint8_t* dest) {
+    if (!dest) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    if ((sector >= ctx->sectorCount) || (count > ctx->sectorCount - sector)) return ERR_BEYONDEND;
+    //Read each sector from wherever it was last written
+    while (count--) {
+        uint32_t phys = ctx->map[sector++];
+        if (phys == FLASHLOG_UNMAPPED) {
+            memset(dest, 0xFF, FLASHLOG_SECTOR_SIZE);
+        } else {
+            status = _FlashLog_readSlot(ctx, phys, ctx->headerSize, FLASHLOG_SECTOR_SIZE, dest);
+            if (IS_ERROR(status)) return status;
+        }
+        dest += FLASHLOG_SECTOR_SIZE;
+    }
+    return ERR_SUCCESS;
+}
+
+//Write logical sectors
+// - Data is buffered in RAM. Call FlashLog_sync() to ensure it is in flash.
+HpsErr_t FlashLog_write(PFlashLogCtx_t ctx, unsigned int sector, unsigned int count, const uint8_t* src) {
+    if (!src) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    if ((sector >= ctx->sectorCount) || (count > ctx->sectorCount - sector)) return ERR_BEYONDEND;
+    //Append each sector to the log
+    while (count--) {
+        status = _FlashLog_append(ctx, FLASHLOG_RECORD_SECTOR, sector++, src, FLASHLOG_SECTOR_SIZE, false);
+        if (IS_ERROR(status)) return status;
+        src += FLASHLOG_SECTOR_SIZE;
+    }
+    return ERR_SUCCESS;
+}
+
+//Trim logical sectors
+// - Marks the sectors as unused so they are not copied by garbage collection.
+HpsErr_t FlashLog_trim(PFlashLogCtx_t ctx, unsigned int sector, unsigned int count) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    if ((sector >= ctx->sectorCount) || (count > ctx->sectorCount - sector)) return ERR_BEYONDEND;
+    while (count--) {
+        uint32_t phys = ctx->map[sector];
+        if (phys != FLASHLOG_UNMAPPED) {
+            ctx->blocks[phys / ctx->slotsPerBlock].valid--;
+            ctx->map[sector] = FLASHLOG_UNMAPPED;
+        }
+        sector++;
+    }
+    return ERR_SUCCESS;
+}
+
+//Program any buffered writes to flash
+HpsErr_t FlashLog_sync(PFlashLogCtx_t ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    return _FlashLog_flush(ctx);
+}
+
+//Run background garbage collection
+// - Call periodically when idle. At most maxCopies live records are moved per call.
+// - Only collects once free blocks are running low, or to balance wear.
+// - Returns ERR_AGAIN if there is more work to do, or ERR_SUCCESS if none.
+HpsErr_t FlashLog_collect(PFlashLogCtx_t ctx, unsigned int maxCopies) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    //Pick a new victim if not already collecting one
+    if (ctx->gcBlock == FLASHLOG_NONE) {
+        bool low = (ctx->freeBlocks <= FLASHLOG_RESERVE_BLOCKS);
+        ctx->gcBlock = _FlashLog_pickVictim(ctx, low, true);
+        ctx->gcSlot = 0;
+        if (ctx->gcBlock == FLASHLOG_NONE) return ERR_SUCCESS;
+    }
+    status = _FlashLog_collectBlock(ctx, maxCopies);
+    if (!IS_SUCCESS(status)) return status;
+    //Block freed, check if there is another to do
+    bool low = (ctx->freeBlocks <= FLASHLOG_RESERVE_BLOCKS);
+    return (_FlashLog_pickVictim(ctx, low, true) != FLASHLOG_NONE) ? ERR_AGAIN : ERR_SUCCESS;
+}
+
+//Write a key-value pair
+// - length must be no more than FLASHLOG_SECTOR_SIZE.
+HpsErr_t FlashLog_kvWrite(PFlashLogCtx_t ctx, unsigned int key, const void* data, unsigned int length) {
+    if (!data && length) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    if (key >= ctx->keyCount) return ERR_BADID;
+    if (length > FLASHLOG_SECTOR_SIZE) return ERR_TOOBIG;
+    return _FlashLog_append(ctx, FLASHLOG_RECORD_KEY, ctx->sectorCount + key, data, length, false);
+}
+
+//Read a key-value pair
+// - Up to maxLength bytes are copied to data.
+// - Returns the length of the value, or ERR_NOTFOUND if the key has no value.
+HpsErrExt_t FlashLog_kvRead(PFlashLogCtx_t ctx, unsigned int key, void* data, unsigned int maxLength) {
+    if (!data && maxLength) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    if (key >= ctx->keyCount) return ERR_BADID;
+    uint32_t phys = ctx->map[ctx->sectorCount + key];
+    if (phys == FLASHLOG_UNMAPPED) return ERR_NOTFOUND;
+    //Read the header to find the length, then the value
+    FlashLogRecord_t rec;
+    status = _FlashLog_readSlot(ctx, phys, 0, sizeof(rec), (uint8_t*)&rec);
+    if (IS_ERROR(status)) return status;
+    if (FLASHLOG_RECORD_TYPE(rec.tag) == FLASHLOG_RECORD_DELETE) return ERR_NOTFOUND;
+    unsigned int length = FLASHLOG_RECORD_LENGTH(rec.tag);
+    if (maxLength > length) maxLength = length;
+    if (maxLength) {
+        status = _FlashLog_readSlot(ctx, phys, ctx->headerSize, maxLength, (uint8_t*)data);
+        if (IS_ERROR(status)) return status;
+    }
+    return length;
+}
+
+//Delete a key-value pair
+HpsErr_t FlashLog_kvDelete(PFlashLogCtx_t ctx, unsigned int key) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    if (key >= ctx->keyCount) return ERR_BADID;
+    uint32_t phys = ctx->map[ctx->sectorCount + key];
+    if (phys == FLASHLOG_UNMAPPED) return ERR_SUCCESS;
+    FlashLogRecord_t rec;
+    status = _FlashLog_readSlot(ctx, phys, 0, sizeof(rec), (uint8_t*)&rec);
+    if (IS_ERROR(status)) return status;
+    if (FLASHLOG_RECORD_TYPE(rec.tag) == FLASHLOG_RECORD_DELETE) return ERR_SUCCESS;
+    //Deletion is recorded so older values don't reappear when mounted
+    return _FlashLog_append(ctx, FLASHLOG_RECORD_DELETE, ctx->sectorCount + key, NULL, 0, false);
+}
+
+//Get statistics
+HpsErr_t FlashLog_getStats(PFlashLogCtx_t ctx, PFlashLogStats_t stats) {
+    if (!stats) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    stats->totalBlocks = ctx->blockCount;
+    stats->freeBlocks = ctx->freeBlocks;
+    stats->totalSlots = ctx->blockCount * ctx->slotsPerBlock;
+    stats->validSlots = 0;
+    stats->minEraseCount = UINT32_MAX;
+    stats->maxEraseCount = 0;
+    for (unsigned int block = 0; block < ctx->blockCount; block++) {
+        FlashLogBlock_t* blk = &ctx->blocks[block];
+        stats->validSlots += blk->valid;
+        if (blk->eraseCount < stats->minEraseCount) stats->minEraseCount = blk->eraseCount;
+        if (blk->eraseCount > stats->maxEraseCount) stats->maxEraseCount = blk->eraseCount;
+    }
+    stats->gcCopies = ctx->gcCopies;
+    stats->blockErases = ctx->blockErases;
+    return ERR_SUCCESS;
+}
@@ -0,0 +1,209 @@
+/*
+ * Wear-Levelling Flash Log
+ * ------------------------
+ *
+ * Log-structured block layer which maps logical sectors
+ * onto a region of any flash device with a generic flash
+ * driver (Util/driver_flash.h), such as the EPCQ or CFI.
+ *
+ * Rather than erasing and re-writing a whole erase block
+ * to update a sector, each write is appended to the end
+ * of the log as a new record, and the old copy becomes
+ * stale. Writes are collected in a RAM buffer and then
+ * programmed as a single multi-sector append, so small
+ * updates cost no erases at all.
+ *
+ * Stale records are reclaimed by garbage collection, which
+ * copies any live records out of a block and then erases
+ * it. Collection can be run in the background by calling
+ * FlashLog_collect() when idle, and is also run whenever
+ * the log is about to run out of free blocks.
+ *
+ * Erase counts are stored in each block and are balanced
+ * by always opening the least worn free block, and by
+ * moving cold (rarely written) data out of the least worn
+ * block once the spread of erase counts exceeds the
+ * FLASHLOG_WEAR_THRESHOLD.
+ *
+ * The log can be used in two ways:
+ *
+ *  - As a disk of sectorCount logical sectors, for example
+ *    as a FatFS volume, with FlashLog_read/write/sync/trim.
+ *  - As a key-value store of keyCount keys, each holding up
+ *    to FLASHLOG_SECTOR_SIZE bytes, with FlashLog_kv*().
+ *
+ * Both can be used at once on the same log.
+ *
+ * Flash Layout:
+ *
+ *    Block  : Block header (magic, erase count) then slots.
+ *    Slot   : Record header (type/length, id, sequence, CRC32)
+ *             followed by FLASHLOG_SECTOR_SIZE bytes of data.
+ *
+ * The newest record (highest sequence number) for each id
+ * is the live copy. Records are checked with a CRC32 when
+ * mounted, so a write torn by a power failure is discarded
+ * and the previous copy of the sector is used instead.
+ *
+ * The flash must allow programming erased bits of a block
+ * which is partially written (true of NOR flash such as
+ * the EPCQ and CFI devices).
+ *
+ * Restrictions:
+ *  - Trim is held in RAM only. A trimmed sector is freed for
+ *    garbage collection, but an older copy may reappear after
+ *    the log is mounted again. Deleted keys are persistent.
+ *  - Mounting reads every used slot, so mount time grows with
+ *    the size of the region.
+ *  - Data written is only guaranteed to be in flash once
+ *    FlashLog_sync() has been called.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef FLASHLOG_H_
+#define FLASHLOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/driver_ctx.h"
+#include "Util/driver_flash.h"
+
+//Size of logical sectors and key-value values in bytes
+#ifndef FLASHLOG_SECTOR_SIZE
+#define FLASHLOG_SECTOR_SIZE 512
+#endif
+
+//Number of slots buffered in RAM before programming
+// - Larger buffers make fewer, longer programming operations.
+#ifndef FLASHLOG_WRITE_BUFFER_SLOTS
+#define FLASHLOG_WRITE_BUFFER_SLOTS 8
+#endif
+
+//Number of erase blocks held back for garbage collection
+// - Must be at least 2.
+#ifndef FLASHLOG_RESERVE_BLOCKS
+#define FLASHLOG_RESERVE_BLOCKS 2
+#endif
+
+//Difference in erase counts which triggers a static wear-levelling move
+#ifndef FLASHLOG_WEAR_THRESHOLD
+#define FLASHLOG_WEAR_THRESHOLD 64
+#endif
+
+//Block tracking state
+typedef struct {
+    uint32_t eraseCount;  // Number of times the block has been erased
+    uint16_t used;        // Number of slots written (or buffered)
+    uint16_t valid;       // Number of slots which hold live records
+    uint8_t  state;       // FLASHLOG_BLOCK_xxx
+} FlashLogBlock_t;
+
+//Statistics
+typedef struct {
+    unsigned int totalBlocks;
+    unsigned int freeBlocks;
+    unsigned int totalSlots;
+    unsigned int validSlots;
+    uint32_t minEraseCount;
+    uint32_t maxEraseCount;
+    uint32_t gcCopies;     // Live records moved by garbage collection
+    uint32_t blockErases;  // Blocks erased since initialisation
+} FlashLogStats_t, *PFlashLogStats_t;
+
+//Driver context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    PFlashCtx_t flash;
+    unsigned int base;          // Start of region in flash
+    unsigned int blockCount;    // Number of erase blocks in region
+    unsigned int blockSize;
+    unsigned int headerSize;    // Block and record header size, rounded to flash word size
+    unsigned int slotSize;      // Record header and data, rounded to flash word size
+    unsigned int slotsPerBlock;
+    unsigned int sectorCount;   // Logical sectors
+    unsigned int keyCount;      // Key-value keys, mapped after the sectors
+    uint32_t* map;              // Map of id to physical slot
+    FlashLogBlock_t* blocks;
+    unsigned int freeBlocks;
+    unsigned int activeBlock;   // Block being appended to
+    uint32_t seq;               // Sequence number of next record
+    uint8_t* scratch;           // One slot of scratch space
+    //Write buffer
+    uint8_t* buffer;
+    unsigned int bufferStart;   // Physical slot of first buffered record
+    unsigned int bufferCount;
+    //Garbage collection
+    unsigned int gcBlock;       // Block being collected
+    unsigned int gcSlot;        // Next slot to check in block
+    uint32_t gcCopies;
+    uint32_t blockErases;
+} FlashLogCtx_t, *PFlashLogCtx_t;
+
+//Initialise the flash log
+// - flash is the flash driver to use.
+// - base is the address of the region in flash, which must be block aligned.
+// - blockCount is the number of erase blocks in the region.
+// - sectorCount and keyCount are the number of logical sectors and keys provided.
+//   Together they must fit in the region with FLASHLOG_RESERVE_BLOCKS left over.
+// - If format is true, any existing contents are erased. Otherwise the existing
+//   log is mounted, and any blocks not belonging to a log are erased.
+// - Returns ERR_NOSPACE if the sectors and keys don't fit in the region.
+HpsErr_t FlashLog_initialise(PFlashCtx_t flash, unsigned int base, unsigned int blockCount, unsigned int sectorCount, unsigned int keyCount, bool format, PFlashLogCtx_t* pCtx);
+
+//Check if driver initialised
+// - Returns true if driver previously initialised
+bool FlashLog_isInitialised(PFlashLogCtx_t ctx);
+
+//Get the number of logical sectors
+HpsErrExt_t FlashLog_getSectorCount(PFlashLogCtx_t ctx);
+
+//Read logical sectors
+// - Sectors which have never been written read as all 0xFF.
+HpsErr_t FlashLog_read(PFlashLogCtx_t ctx, unsigned int sector, unsigned int count, uint8_t* dest);
+
+//Write logical sectors
+// - Data is buffered in RAM. Call FlashLog_sync() to ensure it is in flash.
+HpsErr_t FlashLog_write(PFlashLogCtx_t ctx, unsigned int sector, unsigned int count, const uint8_t* src);
+
+//Trim logical sectors
+// - Marks the sectors as unused so they are not copied by garbage collection.
+HpsErr_t FlashLog_trim(PFlashLogCtx_t ctx, unsigned int sector, unsigned int count);
+
+//Program any buffered writes to flash
+HpsErr_t FlashLog_sync(PFlashLogCtx_t ctx);
+
+//Run background garbage collection
+// - Call periodically when idle. At most maxCopies live records are moved per call.
+// - Only collects once free blocks are running low, or to balance wear.
+// - A partly collected block is finished by the next write.
+// - Returns ERR_AGAIN if there is more work to do, or ERR_SUCCESS if none.
+HpsErr_t FlashLog_collect(PFlashLogCtx_t ctx, unsigned int maxCopies);
+
+//Write a key-value pair
+// - length must be no more than FLASHLOG_SECTOR_SIZE.
+HpsErr_t FlashLog_kvWrite(PFlashLogCtx_t ctx, unsigned int key, const void* data, unsigned int length);
+
+//Read a key-value pair
+// - Up to maxLength bytes are copied to data.
+// - Returns the length of the value, or ERR_NOTFOUND if the key has no value.
+HpsErrExt_t FlashLog_kvRead(PFlashLogCtx_t ctx, unsigned int key, void* data, unsigned int maxLength);
+
+//Delete a key-value pair
+HpsErr_t FlashLog_kvDelete(PFlashLogCtx_t ctx, unsigned int key);
+
+//Get statistics
+HpsErr_t FlashLog_getStats(PFlashLogCtx_t ctx, PFlashLogStats_t stats);
+
+#endif /* FLASHLOG_H_ */
@@ -0,0 +1,748 @@
+/*
+ * HPS DMA Driver
+ * ------------------------------
+ *
+ * Driver for the ARM DMA-330 (PL330) DMA controller in
+ * the HPS, implementing the generic DMA interface.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+-----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#include "HPS_DMA.h"
+#include "Util/bit_helpers.h"
+#include "Util/lowlevel.h"
+#include "FatFS/hwlib/alt_cache.h"
+
+#include <string.h>
+
+// Registers in DMA controller
+#define HPS_DMA_DSR       (0x000/sizeof(unsigned int))
+#define HPS_DMA_INTEN     (0x020/sizeof(unsigned int))
+#define HPS_DMA_INTMIS    (0x028/sizeof(unsigned int))
+#define HPS_DMA_INTCLR    (0x02C/sizeof(unsigned int))
+#define HPS_DMA_FTR(n)    ((0x040 + 0x04*(n))/sizeof(unsigned int))
+#define HPS_DMA_CSR(n)    ((0x100 + 0x08*(n))/sizeof(unsigned int))
+#define HPS_DMA_DBGSTATUS (0xD00/sizeof(unsigned int))
+#define HPS_DMA_DBGCMD    (0xD04/sizeof(unsigned int))
+#define HPS_DMA_DBGINST0  (0xD08/sizeof(unsigned int))
+#define HPS_DMA_DBGINST1  (0xD0C/sizeof(unsigned int))
+#define HPS_DMA_CR0       (0xE00/sizeof(unsigned int))
+
+// DSR flags
+#define HPS_DMA_DSR_DNS 9
+
+// CR0 fields
+#define HPS_DMA_CR0_CHANNELS      4
+#define HPS_DMA_CR0_CHANNELS_MASK 0x7
+
+// Channel states
+#define HPS_DMA_CSR_STATE_MASK 0xF
+enum {
+    HPS_DMA_STATE_STOPPED  = 0x0,
+    HPS_DMA_STATE_KILLING  = 0x8,
+    HPS_DMA_STATE_FAULTING = 0xF
+};
+
+// CCR fields
+#define HPS_DMA_CCR_SRCINC   0
+#define HPS_DMA_CCR_SRCSIZE  1
+#define HPS_DMA_CCR_SRCBURST 4
+#define HPS_DMA_CCR_SRCPROT  8
+#define HPS_DMA_CCR_DSTINC   14
+#define HPS_DMA_CCR_DSTSIZE  15
+#define HPS_DMA_CCR_DSTBURST 18
+#define HPS_DMA_CCR_DSTPROT  22
+
+#define HPS_DMA_PROT_NONSECURE 0x2
+
+// Instructions
+#define HPS_DMA_INST_END    0x00
+#define HPS_DMA_INST_KILL   0x01
+#define HPS_DMA_INST_LD     0x04
+#define HPS_DMA_INST_ST     0x08
+#define HPS_DMA_INST_WMB    0x13
+#define HPS_DMA_INST_LP     0x20
+#define HPS_DMA_INST_LDPS   0x25
+#define HPS_DMA_INST_LPEND  0x38
+#define HPS_DMA_INST_STPS   0x29
+#define HPS_DMA_INST_WFPS   0x30
+#define HPS_DMA_INST_SEV    0x34
+#define HPS_DMA_INST_FLUSHP 0x35
+#define HPS_DMA_INST_GO     0xA0
+#define HPS_DMA_INST_MOV    0xBC
+
+#define HPS_DMA_GO_NS   1
+#define HPS_DMA_LP_LC1  1
+#define HPS_DMA_LPEND_LC1 2
+
+enum {
+    HPS_DMA_MOV_SAR = 0,
+    HPS_DMA_MOV_CCR = 1,
+    HPS_DMA_MOV_DAR = 2
+};
+
+// Largest beat size and burst length on the 64-bit AXI master
+#define HPS_DMA_MAX_BEAT  8
+#define HPS_DMA_MAX_BURST 16
+#define HPS_DMA_MAX_LOOP  256
+
+/*
+ * Cache Maintenance
+ *
+ * The alt_cache API is implemented by FatFS/hwlib/alt_cache.c. These stubs
+ * are only used if that is not built, in which case the caches must not be
+ * enabled.
+ */
+
+__attribute__((weak)) ALT_STATUS_CODE alt_cache_system_clean(__attribute__((unused)) void* address, __attribute__((unused)) size_t length) {
+    return ALT_E_SUCCESS;
+}
+
+__attribute__((weak)) ALT_STATUS_CODE alt_cache_system_invalidate(__attribute__((unused)) void* address, __attribute__((unused)) size_t length) {
+    return ALT_E_SUCCESS;
+}
+
+#define HPS_DMA_LINE_MASK (ALT_CACHE_LINE_SIZE - 1)
+
+/*
+ * Internal Functions
+ */
+
+// Microcode being assembled
+typedef struct {
+    uint8_t* buf;
+    unsigned int len;
+    bool overflow;
+} HPSDmaProgram_t;
+
+static void _HPS_DMA_emit(HPSDmaProgram_t* prog, const uint8_t* inst, unsigned int len) {
+    if (prog->len + len > HPS_DMA_PROGRAM_SIZE) {
+        prog->overflow = true;
+        return;
+    }
+    memcpy(prog->buf + prog->len, inst, len);
+    prog->len += len;
+}
+
+static void _HPS_DMA_emit1(HPSDmaProgram_t* prog, uint8_t op) {
+    _HPS_DMA_emit(prog, &op, 1);
+}
+
+static void _HPS_DMA_emit2(HPSDmaProgram_t* prog, uint8_t op, uint8_t arg) {
+    uint8_t inst[2] = {op, arg};
+    _HPS_DMA_emit(prog, inst, 2);
+}
+
+static void _HPS_DMA_emitMov(HPSDmaProgram_t* prog, uint8_t reg, uint32_t val) {
+    uint8_t inst[6] = {HPS_DMA_INST_MOV, reg, (uint8_t)val, (uint8_t)(val >> 8), (uint8_t)(val >> 16), (uint8_t)(val >> 24)};
+    _HPS_DMA_emit(prog, inst, 6);
+}
+
+//Emit the load/store pair for one burst
+static void _HPS_DMA_emitBurst(PHPSDmaCtx_t ctx, HPSDmaProgram_t* prog, HPSDmaDirection direction) {
+    if (ctx->request == HPS_DMA_NO_REQUEST) {
+        _HPS_DMA_emit1(prog, HPS_DMA_INST_LD);
+        _HPS_DMA_emit1(prog, HPS_DMA_INST_ST);
+    } else if (direction == HPS_DMA_PERIPH_TO_MEM) {
+        _HPS_DMA_emit2(prog, HPS_DMA_INST_WFPS, ctx->request << 3);
+        _HPS_DMA_emit2(prog, HPS_DMA_INST_LDPS, ctx->request << 3);
+        _HPS_DMA_emit1(prog, HPS_DMA_INST_ST);
+    } else {
+        _HPS_DMA_emit2(prog, HPS_DMA_INST_WFPS, ctx->request << 3);
+        _HPS_DMA_emit1(prog, HPS_DMA_INST_LD);
+        _HPS_DMA_emit2(prog, HPS_DMA_INST_STPS, ctx->request << 3);
+    }
+}
+
+//Emit a phase of count bursts with the given beat size and burst length
+static void _HPS_DMA_emitPhase(PHPSDmaCtx_t ctx, HPSDmaProgram_t* prog, HPSDmaDirection direction, unsigned int beat, unsigned int burst, uint32_t count) {
+    if (!count) return;
+    //Configure the channel
+    uint32_t prot = ctx->nonSecure ? HPS_DMA_PROT_NONSECURE : 0;
+    uint32_t size = 31 - __builtin_clz(beat);
+    uint32_t ccr = (size << HPS_DMA_CCR_SRCSIZE) | ((burst - 1) << HPS_DMA_CCR_SRCBURST) | (prot << HPS_DMA_CCR_SRCPROT) |
+                   (size << HPS_DMA_CCR_DSTSIZE) | ((burst - 1) << HPS_DMA_CCR_DSTBURST) | (prot << HPS_DMA_CCR_DSTPROT);
+    if (direction != HPS_DMA_PERIPH_TO_MEM) ccr |= _BV(HPS_DMA_CCR_SRCINC);
+    if (direction != HPS_DMA_MEM_TO_PERIPH) ccr |= _BV(HPS_DMA_CCR_DSTINC);
+    _HPS_DMA_emitMov(prog, HPS_DMA_MOV_CCR, ccr);
+    //Loop counters only go to 256, so nest two loops, repeating as needed.
+    while (count && !prog->overflow) {
+        uint32_t outer = count / HPS_DMA_MAX_LOOP;
+        uint32_t inner = HPS_DMA_MAX_LOOP;
+        if (outer > HPS_DMA_MAX_LOOP) {
+            outer = HPS_DMA_MAX_LOOP;
+        } else if (outer <= 1) {
+            //Last part fits in a single loop
+            outer = 1;
+            inner = (count >= HPS_DMA_MAX_LOOP) ? HPS_DMA_MAX_LOOP : count;
+        }
+        unsigned int outerStart = 0;
+        if (outer > 1) {
+            _HPS_DMA_emit2(prog, HPS_DMA_INST_LP | (HPS_DMA_LP_LC1 << 1), outer - 1);
+            outerStart = prog->len;
+        }
+        unsigned int innerStart = 0;
+        if (inner > 1) {
+            _HPS_DMA_emit2(prog, HPS_DMA_INST_LP, inner - 1);
+            innerStart = prog->len;
+        }
+        _HPS_DMA_emitBurst(ctx, prog, direction);
+        if (inner > 1) _HPS_DMA_emit2(prog, HPS_DMA_INST_LPEND, prog->len - innerStart);
+        if (outer > 1) _HPS_DMA_emit2(prog, HPS_DMA_INST_LPEND | HPS_DMA_LPEND_LC1 << 1, prog->len - outerStart);
+        count -= outer * inner;
+    }
+}
+
+//Assemble the microcode for a chunk
+// - Direction and width are normally those of the context, but may be overridden
+//   for a single chunk (e.g. memset reads a fixed pattern) without changing the context.
+static HpsErr_t _HPS_DMA_buildProgram(PHPSDmaCtx_t ctx, DmaChunk_t xfer, HPSDmaDirection direction, unsigned int width, uint8_t* buf) {
+    //DMA-330 has a 32-bit address space
+    if ((xfer.readAddr > UINT32_MAX) || (xfer.writeAddr > UINT32_MAX) || (xfer.length > UINT32_MAX)) return ERR_BEYONDEND;
+    if ((xfer.readAddr + xfer.length - 1 > UINT32_MAX) || (xfer.writeAddr + xfer.length - 1 > UINT32_MAX)) return ERR_BEYONDEND;
+    uint32_t src = (uint32_t)xfer.readAddr;
+    uint32_t dst = (uint32_t)xfer.writeAddr;
+    uint32_t length = (uint32_t)xfer.length;
+    HPSDmaProgram_t prog = {buf, 0, false};
+    _HPS_DMA_emitMov(&prog, HPS_DMA_MOV_SAR, src);
+    _HPS_DMA_emitMov(&prog, HPS_DMA_MOV_DAR, dst);
+    if (direction != HPS_DMA_MEM_TO_MEM) {
+        //Peripheral FIFO is accessed one word at a time
+        uint32_t mem = (direction == HPS_DMA_MEM_TO_PERIPH) ? src : dst;
+        if ((mem | length) & (width - 1)) return ERR_ALIGNMENT;
+        if (ctx->request != HPS_DMA_NO_REQUEST) _HPS_DMA_emit2(&prog, HPS_DMA_INST_FLUSHP, ctx->request << 3);
+        _HPS_DMA_emitPhase(ctx, &prog, direction, width, 1, length / width);
+    } else {
+        //Largest beat for which both addresses can be aligned together
+        unsigned int beat = HPS_DMA_MAX_BEAT;
+        while ((src ^ dst) & (beat - 1)) beat >>= 1;
+        //Bytes until aligned, then full bursts, then single beats, then any bytes left.
+        uint32_t head = (-src) & (beat - 1);
+        if (head > length) head = length;
+        uint32_t remain = length - head;
+        uint32_t bursts = remain / (beat * HPS_DMA_MAX_BURST);
+        remain -= bursts * beat * HPS_DMA_MAX_BURST;
+        _HPS_DMA_emitPhase(ctx, &prog, direction, 1, 1, head);
+        _HPS_DMA_emitPhase(ctx, &prog, direction, beat, HPS_DMA_MAX_BURST, bursts);
+        _HPS_DMA_emitPhase(ctx, &prog, direction, beat, 1, remain / beat);
+        _HPS_DMA_emitPhase(ctx, &prog, direction, 1, 1, remain % beat);
+    }
+    //Wait for the writes to complete then signal the channel event
+    _HPS_DMA_emit1(&prog, HPS_DMA_INST_WMB);
+    _HPS_DMA_emit2(&prog, HPS_DMA_INST_SEV, ctx->channel << 3);
+    _HPS_DMA_emit1(&prog, HPS_DMA_INST_END);
+    return prog.overflow ? ERR_TOOBIG : ERR_SUCCESS;
+}
+
+//Execute an instruction using the debug interface
+// - If toChannel is false, the instruction is executed by the manager thread.
+// - The debug registers are shared by all channels, so IRQs are masked to stop
+//   another channel's IRQ handler starting its own sequence part way through.
+static void _HPS_DMA_debugExecute(PHPSDmaCtx_t ctx, bool toChannel, const uint8_t inst[6]) {
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    while (ctx->base[HPS_DMA_DBGSTATUS] & 1);
+    ctx->base[HPS_DMA_DBGINST0] = (inst[1] << 24) | (inst[0] << 16) | (ctx->channel << 8) | (toChannel ? 1 : 0);
+    ctx->base[HPS_DMA_DBGINST1] = inst[2] | (inst[3] << 8) | (inst[4] << 16) | (inst[5] << 24);
+    ctx->base[HPS_DMA_DBGCMD] = 0;
+    HPS_IRQ_globalEnable(IS_SUCCESS(irqStatus));
+}
+
+static unsigned int _HPS_DMA_channelState(PHPSDmaCtx_t ctx) {
+    return ctx->base[HPS_DMA_CSR(ctx->channel)] & HPS_DMA_CSR_STATE_MASK;
+}
+
+//Stop the channel immediately
+static void _HPS_DMA_kill(PHPSDmaCtx_t ctx) {
+    const uint8_t inst[6] = {HPS_DMA_INST_KILL, 0, 0, 0, 0, 0};
+    _HPS_DMA_debugExecute(ctx, true, inst);
+    while (_HPS_DMA_channelState(ctx) != HPS_DMA_STATE_STOPPED);
+    ctx->base[HPS_DMA_INTCLR] = _BV(ctx->channel);
+}
+
+//Start the chunk at the head of the queue
+static void _HPS_DMA_startHead(PHPSDmaCtx_t ctx) {
+    uint32_t addr = (uint32_t)(uintptr_t)ctx->slots[ctx->head].program;
+    const uint8_t inst[6] = {
+        HPS_DMA_INST_GO | (ctx->nonSecure ? (HPS_DMA_GO_NS << 1) : 0), ctx->channel,
+        (uint8_t)addr, (uint8_t)(addr >> 8), (uint8_t)(addr >> 16), (uint8_t)(addr >> 24)
+    };
+    ctx->running = true;
+    _HPS_DMA_debugExecute(ctx, false, inst);
+}
+
+//Drop all chunks which have not been started
+static void _HPS_DMA_dropQueue(PHPSDmaCtx_t ctx) {
+    ctx->count = ctx->running ? 1 : 0;
+    ctx->ready = ctx->count;
+}
+
+//Advance the queue if the running chunk has completed
+// - Called from the IRQ handler, or with IRQs disabled.
+static void _HPS_DMA_service(PHPSDmaCtx_t ctx) {
+    if (!ctx->running) return;
+    unsigned int state = _HPS_DMA_channelState(ctx);
+    if (state == HPS_DMA_STATE_FAULTING) {
+        //Save the fault type and stop the channel
+        ctx->faultType = ctx->base[HPS_DMA_FTR(ctx->channel)];
+        _HPS_DMA_kill(ctx);
+        ctx->running = false;
+        _HPS_DMA_dropQueue(ctx);
+        ctx->aborting = false;
+        ctx->aborted = true;
+        return;
+    }
+    if (state != HPS_DMA_STATE_STOPPED) return;
+    ctx->base[HPS_DMA_INTCLR] = _BV(ctx->channel);
+    //Head chunk has completed. Drop any stale copy of the data from the cache.
+    HPSDmaSlot_t* slot = &ctx->slots[ctx->head];
+    if (slot->invalidateLength) alt_cache_system_invalidate(slot->invalidate, slot->invalidateLength);
+    bool isLast = slot->isLast;
+    ctx->running = false;
+    ctx->head = (ctx->head + 1) % HPS_DMA_QUEUE_LENGTH;
+    ctx->count--;
+    ctx->ready--;
+    if (ctx->aborting) {
+        _HPS_DMA_dropQueue(ctx);
+        ctx->aborting = false;
+        ctx->aborted = true;
+    } else if (ctx->ready) {
+        _HPS_DMA_startHead(ctx);
+    }
+    if (isLast || !ctx->ready) ctx->done = true;
+}
+
+//Service the queue from outside the IRQ handler
+static void _HPS_DMA_poll(PHPSDmaCtx_t ctx) {
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    _HPS_DMA_service(ctx);
+    HPS_IRQ_globalEnable(IS_SUCCESS(irqStatus));
+}
+
+static void __irq _HPS_DMA_irqHandler(HPSIRQSource interruptID, void* param, bool* handled) {
+    PHPSDmaCtx_t ctx = (PHPSDmaCtx_t)param;
+    if (!ctx || !(ctx->base[HPS_DMA_INTMIS] & _BV(ctx->channel))) return;
+    //Event is signalled just before the channel ends
+    while (ctx->running && (_HPS_DMA_channelState(ctx) != HPS_DMA_STATE_STOPPED) && (_HPS_DMA_channelState(ctx) != HPS_DMA_STATE_FAULTING));
+    ctx->base[HPS_DMA_INTCLR] = _BV(ctx->channel);
+    _HPS_DMA_service(ctx);
+    *handled = true;
+}
+
+//Reserve the next free slot in the queue
+// - The slot is counted, but not started until the next HPS_DMA_startTransfer.
+// - Returns ERR_BUSY if the queue is full.
+static HpsErr_t _HPS_DMA_reserve(PHPSDmaCtx_t ctx, HPSDmaSlot_t** pSlot) {
+    if (!ctx->useIrq) _HPS_DMA_poll(ctx);
+    //The IRQ handler advances head and count, so pick the slot and count it together
+    HpsErr_t status = ERR_BUSY;
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    if (ctx->count < HPS_DMA_QUEUE_LENGTH) {
+        *pSlot = &ctx->slots[(ctx->head + ctx->count) % HPS_DMA_QUEUE_LENGTH];
+        ctx->count++;
+        status = ERR_SUCCESS;
+    }
+    HPS_IRQ_globalEnable(IS_SUCCESS(irqStatus));
+    return status;
+}
+
+//Release a reserved slot which could not be filled
+// - Only the last slot can be released. It is not counted any more if the queue
+//   was dropped by an abort or fault in the meantime.
+static void _HPS_DMA_release(PHPSDmaCtx_t ctx) {
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    if (ctx->count > ctx->ready) ctx->count--;
+    HPS_IRQ_globalEnable(IS_SUCCESS(irqStatus));
+}
+
+//Queue a chunk in a reserved slot
+// - The chunk is built with the given direction and width rather than those of the context.
+// - If invalidateLength is non-zero, that range is invalidated in the cache on completion.
+static HpsErr_t _HPS_DMA_queueSlot(PHPSDmaCtx_t ctx, HPSDmaSlot_t* slot, DmaChunk_t xfer, HPSDmaDirection direction, unsigned int width, bool autoStart, void* invalidate, unsigned int invalidateLength) {
+    //Slots past ready are never started by the IRQ handler, so can be filled with IRQs enabled
+    HpsErr_t status = _HPS_DMA_buildProgram(ctx, xfer, direction, width, slot->program);
+    if (IS_ERROR(status)) {
+        _HPS_DMA_release(ctx);
+        return status;
+    }
+    slot->isLast = xfer.isLast;
+    slot->invalidate = invalidate;
+    slot->invalidateLength = invalidateLength;
+    //Microcode must be in memory before the channel reads it
+    alt_cache_system_clean((void*)((uintptr_t)slot->program & ~HPS_DMA_LINE_MASK), HPS_DMA_PROGRAM_SIZE + ALT_CACHE_LINE_SIZE);
+    if (autoStart) return HPS_DMA_startTransfer(ctx);
+    return ERR_SUCCESS;
+}
+
+//Queue a chunk
+// - If invalidateLength is non-zero, that range is invalidated in the cache on completion.
+static HpsErr_t _HPS_DMA_queue(PHPSDmaCtx_t ctx, DmaChunk_t xfer, bool autoStart, void* invalidate, unsigned int invalidateLength) {
+    HPSDmaSlot_t* slot;
+    HpsErr_t status = _HPS_DMA_reserve(ctx, &slot);
+    if (IS_ERROR(status)) return status;
+    return _HPS_DMA_queueSlot(ctx, slot, xfer, ctx->direction, ctx->width, autoStart, invalidate, invalidateLength);
+}
+
+static void _HPS_DMA_cleanup(PHPSDmaCtx_t ctx) {
+    if (ctx->base) {
+        //Stop the channel and its interrupt
+        if (ctx->running) _HPS_DMA_kill(ctx);
+        ctx->base[HPS_DMA_INTEN] &= ~_BV(ctx->channel);
+        if (ctx->useIrq) HPS_IRQ_unregisterHandler((HPSIRQSource)(IRQ_DMA0 + ctx->channel));
+    }
+    free(ctx->programs);
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise HPS DMA Channel
+// - base is the base address of the DMA controller (HPS_DMA_BASE)
+// - channel is the DMA channel to use (0 to 7). Each channel can only be used by one context.
+// - If useIrq is true, the next chunk is started from the DMA channel interrupt. This
+//   requires HPS_IRQ to be initialised first. Otherwise the queue advances when polled.
+// - Returns 0 if successful.
+HpsErr_t HPS_DMA_initialise(void* base, unsigned int channel, bool useIrq, PHPSDmaCtx_t* pCtx) {
+    //Ensure user pointers valid
+    if (!base) return ERR_NULLPTR;
+    if (!pointerIsAligned(base, sizeof(unsigned int))) return ERR_ALIGNMENT;
+    if (channel >= HPS_DMA_CHANNELS) return ERR_BADID;
+    if (useIrq && !HPS_IRQ_isInitialised()) return ERR_NOINIT;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_HPS_DMA_cleanup);
+    if (IS_ERROR(status)) return status;
+    //Save base address pointers
+    PHPSDmaCtx_t ctx = *pCtx;
+    ctx->base = (unsigned int*)base;
+    ctx->channel = channel;
+    ctx->direction = HPS_DMA_MEM_TO_MEM;
+    ctx->request = HPS_DMA_NO_REQUEST;
+    ctx->width = 1;
+    ctx->copyThreshold = HPS_DMA_COPY_THRESHOLD;
+    //Check the channel exists in this controller
+    unsigned int channels = ((ctx->base[HPS_DMA_CR0] >> HPS_DMA_CR0_CHANNELS) & HPS_DMA_CR0_CHANNELS_MASK) + 1;
+    if (channel >= channels) return DriverContextInitFail(pCtx, ERR_BADID);
+    //Channels run in the same security state as the manager
+    ctx->nonSecure = !!(ctx->base[HPS_DMA_DSR] & _BV(HPS_DMA_DSR_DNS));
+    //Allocate the microcode buffers
+    ctx->programs = malloc(HPS_DMA_QUEUE_LENGTH * HPS_DMA_PROGRAM_SIZE);
+    if (!ctx->programs) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    for (unsigned int idx = 0; idx < HPS_DMA_QUEUE_LENGTH; idx++) {
+        ctx->slots[idx].program = ctx->programs + idx * HPS_DMA_PROGRAM_SIZE;
+    }
+    //Make sure channel is stopped
+    if (_HPS_DMA_channelState(ctx) != HPS_DMA_STATE_STOPPED) _HPS_DMA_kill(ctx);
+    //Route channel event to the interrupt if required
+    if (useIrq) {
+        status = HPS_IRQ_registerHandler((HPSIRQSource)(IRQ_DMA0 + channel), &_HPS_DMA_irqHandler, ctx);
+        if (IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+        ctx->useIrq = true;
+    }
+    ctx->base[HPS_DMA_INTCLR] = _BV(channel);
+    ctx->base[HPS_DMA_INTEN] |= _BV(channel);
+    //Initialise DMA common context
+    ctx->dma.ctx = ctx;
+    ctx->dma.transferSpace   = (DmaXferSpaceFunc_t)&HPS_DMA_transferSpace;
+    ctx->dma.setupTransfer   = (DmaXferFunc_t)&HPS_DMA_setupTransfer;
+    ctx->dma.startTransfer   = (DmaXferStartFunc_t)&HPS_DMA_startTransfer;
+    ctx->dma.abortTransfer   = (DmaAbortFunc_t)&HPS_DMA_abortTransfer;
+    ctx->dma.transferBusy    = (DmaStatusFunc_t)&HPS_DMA_transferBusy;
+    ctx->dma.transferDone    = (DmaStatusFunc_t)&HPS_DMA_transferDone;
+    ctx->dma.transferAborted = (DmaStatusFunc_t)&HPS_DMA_transferAborted;
+    //And initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+// - Returns true if driver context is initialised
+bool HPS_DMA_isInitialised(PHPSDmaCtx_t ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Configure peripheral transfers
+// - direction selects which address is a fixed address peripheral FIFO
+// - request is the peripheral request interface, or HPS_DMA_NO_REQUEST if the FIFO
+//   is always ready. FPGA requests must be selected in the system manager.
+// - width is the FIFO width in bytes (1, 2, 4 or 8). Chunk lengths must be a multiple.
+// - Can only be changed when nothing is queued.
+HpsErr_t HPS_DMA_setPeripheral(PHPSDmaCtx_t ctx, HPSDmaDirection direction, unsigned int request, unsigned int width) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    if (direction > HPS_DMA_PERIPH_TO_MEM) return ERR_BADID;
+    if ((request != HPS_DMA_NO_REQUEST) && (request > 31)) return ERR_BADID;
+    if (!width || (width > HPS_DMA_MAX_BEAT) || (width & (width - 1))) return ERR_NOSUPPORT;
+    if (ctx->count) return ERR_BUSY;
+    ctx->direction = direction;
+    ctx->request = (direction == HPS_DMA_MEM_TO_MEM) ? HPS_DMA_NO_REQUEST : request;
+    ctx->width = width;
+    return ERR_SUCCESS;
+}
+
+//Check if there is space to queue a transfer
+// - Returns the number of free queue entries
+// - Returns ERR_NOSPACE if the space is 0.
+HpsErr_t HPS_DMA_transferSpace(PHPSDmaCtx_t ctx, unsigned int* space) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    if (!space) return ERR_NULLPTR;
+    if (!ctx->useIrq) _HPS_DMA_poll(ctx);
+    *space = HPS_DMA_QUEUE_LENGTH - ctx->count;
+    return *space ? ERR_SUCCESS : ERR_NOSPACE;
+}
+
+//Queue a transfer
+// - Chunks are queued until started by HPS_DMA_startTransfer, or immediately if autoStart.
+// - Returns ERR_BUSY if the queue is full.
+// - Returns ERR_TOOBIG if the chunk is too long for HPS_DMA_PROGRAM_SIZE.
+HpsErr_t HPS_DMA_setupTransfer(PHPSDmaCtx_t ctx, DmaChunk_t xfer, bool autoStart) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    return _HPS_DMA_queue(ctx, xfer, autoStart, NULL, 0);
+}
+
+//Start all queued transfers
+HpsErr_t HPS_DMA_startTransfer(PHPSDmaCtx_t ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    _HPS_DMA_service(ctx);
+    ctx->ready = ctx->count;
+    if (ctx->ready && !ctx->running) {
+        ctx->done = false;
+        _HPS_DMA_startHead(ctx);
+    }
+    HPS_IRQ_globalEnable(IS_SUCCESS(irqStatus));
+    return ERR_SUCCESS;
+}
+
+//Abort transfers
+// - DMA_ABORT_SAFE stops once the current chunk completes and drops the rest of the queue.
+// - DMA_ABORT_FORCE stops the channel immediately.
+// - DMA_ABORT_NONE cancels a pending safe abort.
+HpsErr_t HPS_DMA_abortTransfer(PHPSDmaCtx_t ctx, DmaAbortType abort) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    _HPS_DMA_service(ctx);
+    if (abort == DMA_ABORT_NONE) {
+        ctx->aborting = false;
+    } else if ((abort == DMA_ABORT_FORCE) || !ctx->running) {
+        if (ctx->running) _HPS_DMA_kill(ctx);
+        ctx->running = false;
+        _HPS_DMA_dropQueue(ctx);
+        ctx->aborting = false;
+        ctx->aborted = true;
+    } else {
+        ctx->aborting = true;
+    }
+    HPS_IRQ_globalEnable(IS_SUCCESS(irqStatus));
+    return ERR_SUCCESS;
+}
+
+//Check if the channel is busy
+// - Returns ERR_BUSY if a transfer is in progress.
+HpsErr_t HPS_DMA_transferBusy(PHPSDmaCtx_t ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    if (!ctx->useIrq) _HPS_DMA_poll(ctx);
+    return ctx->running ? ERR_BUSY : ERR_SUCCESS;
+}
+
+//Check if transfer is done
+// - Returns ERR_SUCCESS once, when a chunk with isLast set completes or the queue empties.
+// - Returns ERR_BUSY if still in progress, or ERR_NOTFOUND if nothing is running.
+HpsErr_t HPS_DMA_transferDone(PHPSDmaCtx_t ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    if (!ctx->useIrq) _HPS_DMA_poll(ctx);
+    if (ctx->done) {
+        ctx->done = false;
+        return ERR_SUCCESS;
+    }
+    return ctx->running ? ERR_BUSY : ERR_NOTFOUND;
+}
+
+//Check if abort is done
+// - Returns ERR_SUCCESS once, when an abort completes or the channel faults.
+// - Returns ERR_BUSY if a safe abort is pending, or ERR_NOTFOUND if none.
+HpsErr_t HPS_DMA_transferAborted(PHPSDmaCtx_t ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    if (!ctx->useIrq) _HPS_DMA_poll(ctx);
+    if (ctx->aborted) {
+        ctx->aborted = false;
+        return ERR_SUCCESS;
+    }
+    return ctx->aborting ? ERR_BUSY : ERR_NOTFOUND;
+}
+
+/*
+ * Copy Service
+ */
+
+//Copy memory
+// - Queues a copy of length bytes from src to dest. Returns once queued.
+// - Copies shorter than the threshold are done by the CPU before returning. Call
+//   HPS_DMA_wait() first if the buffers are still in use by an earlier transfer.
+// - Buffers must not overlap, and must not be accessed until HPS_DMA_wait().
+// - Waits for queue space if the queue is full.
+// - Channel must be configured for memory to memory transfers.
+HpsErr_t HPS_DMA_memcpyAsync(PHPSDmaCtx_t ctx, void* dest, const void* src, size_t length) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    if (!dest || !src) return ERR_NULLPTR;
+    if (ctx->direction != HPS_DMA_MEM_TO_MEM) return ERR_NOSUPPORT;
+    if (!length) return ERR_SUCCESS;
+    uintptr_t destAddr = (uintptr_t)dest;
+    uintptr_t srcAddr = (uintptr_t)src;
+    //Split into partial cache lines at either end of dest, and a line aligned middle
+    size_t head = (-destAddr) & HPS_DMA_LINE_MASK;
+    if (head > length) head = length;
+    size_t tail = (length - head) & HPS_DMA_LINE_MASK;
+    size_t middle = length - head - tail;
+    bool overlap = (srcAddr < destAddr + length) && (destAddr < srcAddr + length);
+    if (overlap || (middle < ctx->copyThreshold) || !middle) {
+        memmove(dest, src, length);
+        return ERR_SUCCESS;
+    }
+    memcpy(dest, src, head);
+    memcpy((uint8_t*)dest + length - tail, (const uint8_t*)src + length - tail, tail);
+    //Write the source out to memory, and drop the destination from the cache so
+    //that no dirty lines are evicted over the new data.
+    uintptr_t cleanStart = (srcAddr + head) & ~HPS_DMA_LINE_MASK;
+    uintptr_t cleanEnd = (srcAddr + head + middle + HPS_DMA_LINE_MASK) & ~HPS_DMA_LINE_MASK;
+    alt_cache_system_clean((void*)cleanStart, cleanEnd - cleanStart);
+    alt_cache_system_invalidate((void*)(destAddr + head), middle);
+    //Queue the middle, waiting for space if needed
+    DmaChunk_t xfer = {srcAddr + head, destAddr + head, middle, true};
+    while ((status = _HPS_DMA_queue(ctx, xfer, true, (void*)(destAddr + head), middle)) == ERR_BUSY);
+    return status;
+}
+
+//Fill memory
+// - Queues a fill of length bytes of dest with value. Returns once queued.
+// - Same restrictions as HPS_DMA_memcpyAsync.
+HpsErr_t HPS_DMA_memsetAsync(PHPSDmaCtx_t ctx, void* dest, int value, size_t length) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    if (!dest) return ERR_NULLPTR;
+    if (ctx->direction != HPS_DMA_MEM_TO_MEM) return ERR_NOSUPPORT;
+    if (!length) return ERR_SUCCESS;
+    uintptr_t destAddr = (uintptr_t)dest;
+    //Split into partial cache lines at either end, and a line aligned middle
+    size_t head = (-destAddr) & HPS_DMA_LINE_MASK;
+    if (head > length) head = length;
+    size_t tail = (length - head) & HPS_DMA_LINE_MASK;
+    size_t middle = length - head - tail;
+    if ((middle < ctx->copyThreshold) || !middle) {
+        memset(dest, value, length);
+        return ERR_SUCCESS;
+    }
+    memset(dest, value, head);
+    memset((uint8_t*)dest + length - tail, value, tail);
+    alt_cache_system_invalidate((void*)(destAddr + head), middle);
+    //Wait for a free slot
+    HPSDmaSlot_t* slot;
+    while ((status = _HPS_DMA_reserve(ctx, &slot)) == ERR_BUSY);
+    //The pattern is held in the slot, and read from a fixed address in 8-byte beats.
+    slot->pattern = 0x0101010101010101ULL * (uint8_t)value;
+    uintptr_t pattern = (uintptr_t)&slot->pattern;
+    alt_cache_system_clean((void*)(pattern & ~HPS_DMA_LINE_MASK), ALT_CACHE_LINE_SIZE);
+    //Built as a fixed source transfer for this chunk only, leaving the context as memory to memory.
+    DmaChunk_t xfer = {pattern, destAddr + head, middle, true};
+    return _HPS_DMA_queueSlot(ctx, slot, xfer, HPS_DMA_PERIPH_TO_MEM, sizeof(slot->pattern), true, (void*)(destAddr + head), middle);
+}
+
+//Wait for all queued copies to complete
+// - Returns ERR_ABORTED if the transfer was aborted or faulted.
+HpsErr_t HPS_DMA_wait(PHPSDmaCtx_t ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    while (HPS_DMA_transferBusy(ctx) == ERR_BUSY);
+    ctx->done = false;
+    if (ctx->aborted) {
+        ctx->aborted = false;
+        return ERR_ABORTED;
+    }
+    return ERR_SUCCESS;
+}
+
+//Set the copy threshold
+// - Copies of fewer than threshold bytes are done by the CPU.
+HpsErr_t HPS_DMA_setCopyThreshold(PHPSDmaCtx_t ctx, size_t threshold) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    ctx->copyThreshold = threshold;
+    return ERR_SUCCESS;
+}
+
+//Calibrate the copy threshold
+// - Times CPU and DMA copies of increasing size up to HPS_DMA_CALIBRATE_SIZE, and
+//   sets the threshold to the smallest size for which the DMA is faster.
+// - Uses the PMU cycle counter. Channel must be idle.
+// - Returns the new threshold.
+HpsErrExt_t HPS_DMA_calibrateCopy(PHPSDmaCtx_t ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    if (ctx->direction != HPS_DMA_MEM_TO_MEM) return ERR_NOSUPPORT;
+    if (ctx->count) return ERR_BUSY;
+    uint8_t* src = malloc(2 * HPS_DMA_CALIBRATE_SIZE + ALT_CACHE_LINE_SIZE);
+    if (!src) return ERR_ALLOCFAIL;
+    uint8_t* dest = (uint8_t*)(((uintptr_t)src + HPS_DMA_CALIBRATE_SIZE + HPS_DMA_LINE_MASK) & ~HPS_DMA_LINE_MASK);
+    memset(src, 0x5A, HPS_DMA_CALIBRATE_SIZE);
+    //Start the cycle counter without resetting it, in case it is used elsewhere
+    unsigned int pmcr = __GET_SYSREG(SYSREG_COPROC, PMCR);
+    __SET_SYSREG(SYSREG_COPROC, PMCR, pmcr | (1 << SYSREG_PMCR_BIT_E));
+    __SET_SYSREG(SYSREG_COPROC, PMCNTENSET, (1U << SYSREG_PMCNTENSET_BIT_C));
+    //Force every copy onto the DMA while timing
+    size_t threshold = SIZE_MAX;
+    ctx->copyThreshold = 0;
+    for (size_t size = 256; size <= HPS_DMA_CALIBRATE_SIZE; size *= 2) {
+        uint32_t cpuTime = UINT32_MAX;
+        uint32_t dmaTime = UINT32_MAX;
+        //Run each twice, keeping the fastest, so the first run warms the caches
+        for (unsigned int run = 0; run < 2; run++) {
+            uint32_t start = __GET_SYSREG(SYSREG_COPROC, PMCCNTR);
+            memcpy(dest, src, size);
+            uint32_t time = __GET_SYSREG(SYSREG_COPROC, PMCCNTR) - start;
+            if (time < cpuTime) cpuTime = time;
+            start = __GET_SYSREG(SYSREG_COPROC, PMCCNTR);
+            status = HPS_DMA_memcpyAsync(ctx, dest, src, size);
+            if (IS_SUCCESS(status)) status = HPS_DMA_wait(ctx);
+            time = __GET_SYSREG(SYSREG_COPROC, PMCCNTR) - start;
+            if (IS_ERROR(status)) break;
+            if (time < dmaTime) dmaTime = time;
+        }
+        if (IS_ERROR(status)) break;
+        if (dmaTime < cpuTime) {
+            threshold = size;
+            break;
+        }
+    }
+    free(src);
+    ctx->copyThreshold = threshold;
+    if (IS_ERROR(status)) return status;
+    return (HpsErrExt_t)((threshold > INT32_MAX) ? INT32_MAX : threshold);
+}
@@ -0,0 +1,254 @@
+/*
+ * HPS DMA Driver
+ * ------------------------------
+ *
+ * Driver for the ARM DMA-330 (PL330) DMA controller in
+ * the HPS, implementing the generic DMA interface (Util/
+ * driver_dma.h).
+ *
+ * Each driver context owns one of the eight DMA channels.
+ * Transfers are described by DmaChunk_t structures which
+ * are converted to DMA-330 microcode and held in a queue
+ * of HPS_DMA_QUEUE_LENGTH entries. Chunks are executed in
+ * order, with the next chunk started as soon as the last
+ * completes, either from the DMA interrupt if enabled,
+ * or when the status is next polled.
+ *
+ * By default transfers are memory to memory. A channel
+ * can instead be configured with HPS_DMA_setPeripheral()
+ * to read from or write to a fixed address FIFO, with
+ * optional flow control using a peripheral request
+ * interface (e.g. FPGA DMA requests 0-7).
+ *
+ *    PHPSDmaCtx_t dma;
+ *    HPS_DMA_initialise((void*)HPS_DMA_BASE, 0, true, &dma);
+ *    DmaChunk_t xfer = {(uintptr_t)src, (uintptr_t)dest, length, true};
+ *    DMA_setupTransfer(&dma->dma, xfer, true);
+ *    while (DMA_transferDone(&dma->dma) == ERR_BUSY);
+ *
+ * The DMA-330 accesses memory directly, so any data and the
+ * driver itself must not be held only in the data cache.
+ *
+ * Copy Service
+ * ------------
+ *
+ * HPS_DMA_memcpyAsync() and HPS_DMA_memsetAsync() queue large
+ * copies and fills on a memory to memory channel, while the
+ * CPU carries on. The caches are cleaned and invalidated as
+ * needed using alt_cache_system_clean/invalidate(). Partial
+ * cache lines at either end of the destination are done by
+ * the CPU so that invalidation never discards other data.
+ * Copies smaller than the threshold are faster on the CPU,
+ * so are done immediately. HPS_DMA_calibrateCopy() measures
+ * the crossover point to set the threshold.
+ *
+ *    HPS_DMA_calibrateCopy(dma);
+ *    HPS_DMA_memsetAsync(dma, frameBuffer, 0, sizeof(frameBuffer));
+ *    ... other work ...
+ *    HPS_DMA_wait(dma);
+ *
+ * The driver supports both Cyclone V devices (default) or
+ * Arria 10 devices (-D __ARRIA10__).
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+-----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef HPS_DMA_H_
+#define HPS_DMA_H_
+
+#include "Util/driver_dma.h"
+#include "HPS_IRQ/HPS_IRQ.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * DMA Controller Addresses
+ */
+
+#ifdef __ARRIA10__
+
+#define HPS_DMA_BASE_SECURE    0xFFDA1000
+#define HPS_DMA_BASE_NONSECURE 0xFFDA0000
+
+#else
+
+#define HPS_DMA_BASE_SECURE    0xFFE01000
+#define HPS_DMA_BASE_NONSECURE 0xFFE00000
+
+#endif
+
+// Bare-metal code runs in the secure state
+#ifndef HPS_DMA_BASE
+#define HPS_DMA_BASE HPS_DMA_BASE_SECURE
+#endif
+
+//Number of chunks which can be queued per channel
+#ifndef HPS_DMA_QUEUE_LENGTH
+#define HPS_DMA_QUEUE_LENGTH 8
+#endif
+
+//Size of microcode buffer per chunk
+// - Each chunk can transfer about 8MB per 10 bytes of buffer.
+#ifndef HPS_DMA_PROGRAM_SIZE
+#define HPS_DMA_PROGRAM_SIZE 128
+#endif
+
+//Default size in bytes below which copies are done by the CPU
+#ifndef HPS_DMA_COPY_THRESHOLD
+#define HPS_DMA_COPY_THRESHOLD 4096
+#endif
+
+//Largest copy size tried when calibrating the threshold
+#ifndef HPS_DMA_CALIBRATE_SIZE
+#define HPS_DMA_CALIBRATE_SIZE 65536
+#endif
+
+#define HPS_DMA_CHANNELS 8
+
+//Use no peripheral request interface
+#define HPS_DMA_NO_REQUEST UINT32_MAX
+
+// Transfer direction
+typedef enum {
+    HPS_DMA_MEM_TO_MEM,      // Both addresses increment
+    HPS_DMA_MEM_TO_PERIPH,   // Write address is fixed
+    HPS_DMA_PERIPH_TO_MEM    // Read address is fixed
+} HPSDmaDirection;
+
+// Queued chunk
+typedef struct {
+    uint8_t* program;
+    bool isLast;
+    void* invalidate;              // Range to invalidate in cache on completion
+    unsigned int invalidateLength;
+    uint64_t pattern;              // Source data for fills
+} HPSDmaSlot_t;
+
+// Driver context
+typedef struct {
+    // Context Header
+    DrvCtx_t header;
+    // Context Body
+    volatile unsigned int* base;
+    unsigned int channel;
+    bool nonSecure;
+    bool useIrq;
+    // Peripheral settings
+    HPSDmaDirection direction;
+    unsigned int request;
+    unsigned int width;
+    // Queue of chunks. The first ready chunks have been started.
+    HPSDmaSlot_t slots[HPS_DMA_QUEUE_LENGTH];
+    uint8_t* programs;
+    volatile unsigned int head;
+    volatile unsigned int count;
+    volatile unsigned int ready;
+    // Status
+    volatile bool running;
+    volatile bool done;
+    volatile bool aborting;
+    volatile bool aborted;
+    volatile unsigned int faultType;
+    // Copy service
+    size_t copyThreshold;
+    // DMA common interface
+    DmaCtx_t dma;
+} HPSDmaCtx_t, *PHPSDmaCtx_t;
+
+//Initialise HPS DMA Channel
+// - base is the base address of the DMA controller (HPS_DMA_BASE)
+// - channel is the DMA channel to use (0 to 7). Each channel can only be used by one context.
+// - If useIrq is true, the next chunk is started from the DMA channel interrupt. This
+//   requires HPS_IRQ to be initialised first. Otherwise the queue advances when polled.
+// - Returns 0 if successful.
+HpsErr_t HPS_DMA_initialise(void* base, unsigned int channel, bool useIrq, PHPSDmaCtx_t* pCtx);
+
+//Check if driver initialised
+// - Returns true if driver context is initialised
+bool HPS_DMA_isInitialised(PHPSDmaCtx_t ctx);
+
+//Configure peripheral transfers
+// - direction selects which address is a fixed address peripheral FIFO
+// - request is the peripheral request interface, or HPS_DMA_NO_REQUEST if the FIFO
+//   is always ready. FPGA requests must be selected in the system manager.
+// - width is the FIFO width in bytes (1, 2, 4 or 8). Chunk lengths must be a multiple.
+// - Can only be changed when nothing is queued.
+HpsErr_t HPS_DMA_setPeripheral(PHPSDmaCtx_t ctx, HPSDmaDirection direction, unsigned int request, unsigned int width);
+
+//Check if there is space to queue a transfer
+// - Returns the number of free queue entries
+// - Returns ERR_NOSPACE if the space is 0.
+HpsErr_t HPS_DMA_transferSpace(PHPSDmaCtx_t ctx, unsigned int* space);
+
+//Queue a transfer
+// - Chunks are queued until started by HPS_DMA_startTransfer, or immediately if autoStart.
+// - Returns ERR_BUSY if the queue is full.
+// - Returns ERR_TOOBIG if the chunk is too long for HPS_DMA_PROGRAM_SIZE.
+HpsErr_t HPS_DMA_setupTransfer(PHPSDmaCtx_t ctx, DmaChunk_t xfer, bool autoStart);
+
+//Start all queued transfers
+HpsErr_t HPS_DMA_startTransfer(PHPSDmaCtx_t ctx);
+
+//Abort transfers
+// - DMA_ABORT_SAFE stops once the current chunk completes and drops the rest of the queue.
+// - DMA_ABORT_FORCE stops the channel immediately.
+// - DMA_ABORT_NONE cancels a pending safe abort.
+HpsErr_t HPS_DMA_abortTransfer(PHPSDmaCtx_t ctx, DmaAbortType abort);
+
+//Check if the channel is busy
+// - Returns ERR_BUSY if a transfer is in progress.
+HpsErr_t HPS_DMA_transferBusy(PHPSDmaCtx_t ctx);
+
+//Check if transfer is done
+// - Returns ERR_SUCCESS once, when a chunk with isLast set completes or the queue empties.
+// - Returns ERR_BUSY if still in progress, or ERR_NOTFOUND if nothing is running.
+HpsErr_t HPS_DMA_transferDone(PHPSDmaCtx_t ctx);
+
+//Check if abort is done
+// - Returns ERR_SUCCESS once, when an abort completes or the channel faults.
+// - Returns ERR_BUSY if a safe abort is pending, or ERR_NOTFOUND if none.
+HpsErr_t HPS_DMA_transferAborted(PHPSDmaCtx_t ctx);
+
+/*
+ * Copy Service
+ */
+
+//Copy memory
+// - Queues a copy of length bytes from src to dest. Returns once queued.
+// - Copies shorter than the threshold are done by the CPU before returning. Call
+//   HPS_DMA_wait() first if the buffers are still in use by an earlier transfer.
+// - Buffers must not overlap, and must not be accessed until HPS_DMA_wait().
+// - Waits for queue space if the queue is full.
+// - Channel must be configured for memory to memory transfers.
+HpsErr_t HPS_DMA_memcpyAsync(PHPSDmaCtx_t ctx, void* dest, const void* src, size_t length);
+
+//Fill memory
+// - Queues a fill of length bytes of dest with value. Returns once queued.
+// - Same restrictions as HPS_DMA_memcpyAsync.
+HpsErr_t HPS_DMA_memsetAsync(PHPSDmaCtx_t ctx, void* dest, int value, size_t length);
+
+//Wait for all queued copies to complete
+// - Returns ERR_ABORTED if the transfer was aborted or faulted.
+HpsErr_t HPS_DMA_wait(PHPSDmaCtx_t ctx);
+
+//Set the copy threshold
+// - Copies of fewer than threshold bytes are done by the CPU.
+HpsErr_t HPS_DMA_setCopyThreshold(PHPSDmaCtx_t ctx, size_t threshold);
+
+//Calibrate the copy threshold
+// - Times CPU and DMA copies of increasing size up to HPS_DMA_CALIBRATE_SIZE, and
+//   sets the threshold to the smallest size for which the DMA is faster.
+// - Uses the PMU cycle counter. Channel must be idle.
+// - Returns the new threshold.
+HpsErrExt_t HPS_DMA_calibrateCopy(PHPSDmaCtx_t ctx);
+
+#endif /* HPS_DMA_H_ */
@@ -0,0 +1,236 @@
+/*
+ * HPS Initialisation Scheduler
+ * ----------------------------
+ *
+ * Runs driver initialisation as a set of independent chains
+ * of non-blocking phases. The scheduler interleaves the
+ * chains so that time one driver spends waiting (e.g. for
+ * a display to power up) is used to progress the others.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#include "HPS_InitSched.h"
+#include "HPS_Watchdog/HPS_Watchdog.h"
+
+#include <stdio.h>
+
+#ifdef __ARRIA10__
+
+//Base address of A9 global timer
+#define HPS_GLOBAL_TIMER_BASE 0xFFFFC200
+
+// Assume 300MHz timer if not defined
+#define GUESS_TIMER_FREQ 300000000
+
+#else
+
+//Base address of A9 global timer
+#define HPS_GLOBAL_TIMER_BASE 0xFFFEC200
+
+// Assume 200MHz timer if not defined
+#define GUESS_TIMER_FREQ 200000000
+
+#endif
+
+//Allow timer frequency to be overridden.
+#ifndef HPS_INITSCHED_TIMER_FREQ
+#define HPS_INITSCHED_TIMER_FREQ GUESS_TIMER_FREQ
+#endif
+
+#define HPS_INITSCHED_TICKS_PER_US (HPS_INITSCHED_TIMER_FREQ / 1000000)
+
+// Register Offsets
+#define TIMER_COUNTLO (0x00 / sizeof(unsigned int))
+#define TIMER_COUNTHI (0x04 / sizeof(unsigned int))
+#define TIMER_CTRL    (0x08 / sizeof(unsigned int))
+
+#define TIMER_ENABLED (1 << 0)
+
+//Runtime state of each chain
+typedef struct {
+    unsigned int phase;   // Current phase
+    bool started;         // Whether current phase has been called yet
+    bool done;            // Whether chain has finished (complete or failed)
+    uint64_t phaseStart;  // Time current phase was first called
+    uint64_t readyAt;     // Time at which phase may next be called
+    unsigned int polls;   // Number of calls of current phase
+    int event;            // Timeline entry of current phase, or -1
+} InitChainState_t;
+
+static volatile unsigned int* __globalTimer = (unsigned int*)HPS_GLOBAL_TIMER_BASE;
+
+static InitChainState_t __chainState[HPS_INITSCHED_MAX_CHAINS];
+static InitEvent_t __events[HPS_INITSCHED_MAX_EVENTS];
+static unsigned int __eventCount = 0;
+static uint32_t __totalUs = 0;
+
+/*
+ * Internal Functions
+ */
+
+//Read the 64-bit global timer
+// - The high word is read either side of the low word to catch a carry
+static uint64_t _HPS_InitSched_now(void) {
+    unsigned int hi, lo;
+    do {
+        hi = __globalTimer[TIMER_COUNTHI];
+        lo = __globalTimer[TIMER_COUNTLO];
+    } while (hi != __globalTimer[TIMER_COUNTHI]);
+    return ((uint64_t)hi << 32) | lo;
+}
+
+//Convert a tick delta to microseconds
+static uint32_t _HPS_InitSched_toUs(uint64_t ticks) {
+    return (uint32_t)(ticks / HPS_INITSCHED_TICKS_PER_US);
+}
+
+//Close the timeline entry for a chain's current phase
+static void _HPS_InitSched_endEvent(InitChainState_t* state, uint64_t start, uint64_t now, HpsErr_t status) {
+    if (state->event < 0) return;
+    InitEvent_t* event = &__events[state->event];
+    event->polls  = (state->polls > 0xFFFF) ? 0xFFFF : state->polls;
+    event->status = status;
+    event->endUs  = _HPS_InitSched_toUs(now - start);
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Run a set of initialisation chains
+HpsErr_t HPS_InitSched_run(const InitChain_t* chains, unsigned int chainCount, bool showTimeline) {
+    if (!chains) return ERR_NULLPTR;
+    if (chainCount > HPS_INITSCHED_MAX_CHAINS) return ERR_TOOBIG;
+    //Validate the chain tables before starting anything
+    for (unsigned int idx = 0; idx < chainCount; idx++) {
+        if (chains[idx].phaseCount && !chains[idx].phases) return ERR_NULLPTR;
+        for (unsigned int phase = 0; phase < chains[idx].phaseCount; phase++) {
+            if (!chains[idx].phases[phase].func) return ERR_NULLPTR;
+        }
+    }
+    //Ensure the global timer is running
+    __globalTimer[TIMER_CTRL] |= TIMER_ENABLED;
+    uint64_t start = _HPS_InitSched_now();
+    //Reset the chain states
+    __eventCount = 0;
+    unsigned int remaining = 0;
+    for (unsigned int idx = 0; idx < chainCount; idx++) {
+        InitChainState_t* state = &__chainState[idx];
+        state->phase = 0;
+        state->started = false;
+        state->done = (chains[idx].phaseCount == 0);
+        state->readyAt = start;
+        if (!state->done) remaining++;
+    }
+    //Interleave the chains until all are done
+    HpsErr_t result = ERR_SUCCESS;
+    while (remaining) {
+        HPS_ResetWatchdog();
+        for (unsigned int idx = 0; idx < chainCount; idx++) {
+            InitChainState_t* state = &__chainState[idx];
+            if (state->done) continue;
+            //Skip if chain is still waiting for a delay
+            uint64_t now = _HPS_InitSched_now();
+            if (now < state->readyAt) continue;
+            const InitPhase_t* phase = &chains[idx].phases[state->phase];
+            //Start the phase if this is its first call
+            if (!state->started) {
+                state->started = true;
+                state->phaseStart = now;
+                state->polls = 0;
+                state->event = -1;
+                if (__eventCount < HPS_INITSCHED_MAX_EVENTS) {
+                    state->event = __eventCount++;
+                    __events[state->event] = (InitEvent_t){
+                        .chain = idx, .phase = state->phase, .polls = 0,
+                        .status = ERR_AGAIN, .startUs = _HPS_InitSched_toUs(now - start), .endUs = 0
+                    };
+                }
+            }
+            //Run the phase
+            unsigned int delayUs = 0;
+            HpsErr_t status = phase->func(chains[idx].param, &delayUs);
+            state->polls++;
+            now = _HPS_InitSched_now();
+            uint64_t delay = (uint64_t)delayUs * HPS_INITSCHED_TICKS_PER_US;
+            if (IS_SUCCESS(status)) {
+                //Phase complete. Move on to the next after any delay.
+                _HPS_InitSched_endEvent(state, start, now, status);
+                state->started = false;
+                state->readyAt = now + delay;
+                if (++state->phase >= chains[idx].phaseCount) {
+                    state->done = true;
+                    remaining--;
+                }
+                continue;
+            }
+            if (IS_RETRY(status) || IS_BUSY(status)) {
+                //Phase in progress. Check it is still within its deadline.
+                uint64_t deadline = (uint64_t)phase->deadlineUs * HPS_INITSCHED_TICKS_PER_US;
+                if (!phase->deadlineUs || ((now - state->phaseStart) <= deadline)) {
+                    state->readyAt = now + delay;
+                    continue;
+                }
+                status = ERR_TIMEOUT;
+            }
+            //Phase failed. Stop this chain.
+            _HPS_InitSched_endEvent(state, start, now, status);
+            state->done = true;
+            remaining--;
+            if (IS_SUCCESS(result)) result = status;
+        }
+    }
+    __totalUs = _HPS_InitSched_toUs(_HPS_InitSched_now() - start);
+    HPS_ResetWatchdog();
+    //Print timeline if requested
+    if (showTimeline) HPS_InitSched_printTimeline(chains, chainCount);
+    return result;
+}
+
+//Print the timeline of the last run
+void HPS_InitSched_printTimeline(const InitChain_t* chains, unsigned int chainCount) {
+    if (!chains) return;
+    printf("Init timeline (%lu.%03lu ms):\n", (unsigned long)(__totalUs / 1000), (unsigned long)(__totalUs % 1000));
+    printf("  %-12s %-16s %10s %10s %6s %6s\n", "Chain", "Phase", "Start(us)", "End(us)", "Polls", "Status");
+    for (unsigned int idx = 0; idx < __eventCount; idx++) {
+        const InitEvent_t* event = &__events[idx];
+        if (event->chain >= chainCount) continue;
+        const InitChain_t* chain = &chains[event->chain];
+        const char* phaseName = (event->phase < chain->phaseCount) ? chain->phases[event->phase].name : NULL;
+        printf("  %-12s %-16s %10lu %10lu %6u %6d\n",
+               chain->name ? chain->name : "?", phaseName ? phaseName : "?",
+               (unsigned long)event->startUs, (unsigned long)event->endUs,
+               (unsigned int)event->polls, (int)event->status);
+    }
+    //Compare against running the chains one after another, from the sum of their durations
+    uint32_t serialUs = 0;
+    for (unsigned int chain = 0; chain < chainCount; chain++) {
+        uint32_t chainStart = UINT32_MAX;
+        uint32_t chainEnd = 0;
+        for (unsigned int idx = 0; idx < __eventCount; idx++) {
+            if (__events[idx].chain != chain) continue;
+            if (__events[idx].startUs < chainStart) chainStart = __events[idx].startUs;
+            if (__events[idx].endUs > chainEnd) chainEnd = __events[idx].endUs;
+        }
+        if (chainEnd > chainStart) serialUs += chainEnd - chainStart;
+    }
+    printf("  Serial estimate %lu.%03lu ms\n", (unsigned long)(serialUs / 1000), (unsigned long)(serialUs % 1000));
+}
+
+//Get the timeline of the last run
+HpsErr_t HPS_InitSched_getTimeline(const InitEvent_t** events, unsigned int* count, uint32_t* totalUs) {
+    if (!events || !count) return ERR_NULLPTR;
+    *events = __events;
+    *count = __eventCount;
+    if (totalUs) *totalUs = __totalUs;
+    return ERR_SUCCESS;
+}
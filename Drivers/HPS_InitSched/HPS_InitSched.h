@@ -0,0 +1,131 @@
+/*
+ * HPS Initialisation Scheduler
+ * ----------------------------
+ *
+ * Runs driver initialisation as a set of independent chains
+ * of non-blocking phases. The scheduler interleaves the
+ * chains so that time one driver spends waiting (e.g. for
+ * a display to power up) is used to progress the others.
+ * The total bring-up time then approaches the length of
+ * the longest single chain rather than the sum of all of
+ * them.
+ *
+ * Each phase is a function which is called repeatedly
+ * until it completes:
+ *
+ *  - Return ERR_SUCCESS once the phase is complete. The
+ *    function may set *delayUs to the minimum time to wait
+ *    before the next phase of the chain is started.
+ *  - Return ERR_AGAIN (or ERR_BUSY if a shared resource is
+ *    in use) if the phase must be called again. *delayUs
+ *    may be set to the minimum time before the next call.
+ *  - Any other value is treated as an error, which stops
+ *    that chain. The remaining chains continue to run.
+ *
+ * Each phase may have a deadline measured from the first
+ * time it is called. If the phase has not completed when
+ * the deadline passes, the chain fails with ERR_TIMEOUT.
+ *
+ * Timing uses the ARM A9 global timer, which is enabled
+ * by the scheduler if not already running. The timer
+ * frequency can be overridden by globally defining
+ * HPS_INITSCHED_TIMER_FREQ. The default if not defined is
+ * 200MHz (Cyclone V) or 300MHz (Arria 10).
+ *
+ * Once complete a timeline of every phase can be printed.
+ *
+ * Example (see DE1SoC_BoardInit for a full board table):
+ *
+ *    static HpsErr_t lt24Start(void* param, unsigned int* delayUs) {
+ *        return LT24_initialiseStart(LSC_BASE_GPIO_JP1, LSC_BASE_LT24HWDATA, (PLT24Ctx_t*)param);
+ *    }
+ *    static HpsErr_t lt24Reset(void* param, unsigned int* delayUs) {
+ *        return LT24_initialiseContinue((PLT24Ctx_t*)param, delayUs);
+ *    }
+ *    static const InitPhase_t lt24Phases[] = {
+ *        {"setup", &lt24Start,      0},
+ *        {"reset", &lt24Reset, 500000}
+ *    };
+ *    ...
+ *    InitChain_t chains[] = {
+ *        {"LT24", lt24Phases, ARRAYSIZE(lt24Phases), &drivers.lt24},
+ *        {"SD"  , sdPhases  , ARRAYSIZE(sdPhases)  , NULL         }
+ *    };
+ *    status = HPS_InitSched_run(chains, ARRAYSIZE(chains), true);
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef HPS_INITSCHED_H_
+#define HPS_INITSCHED_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "Util/error.h"
+
+//Maximum number of chains which can be run at once
+#ifndef HPS_INITSCHED_MAX_CHAINS
+#define HPS_INITSCHED_MAX_CHAINS 8
+#endif
+
+//Maximum number of phases recorded in the timeline
+// - Phases beyond this are still run, but not recorded.
+#ifndef HPS_INITSCHED_MAX_EVENTS
+#define HPS_INITSCHED_MAX_EVENTS 32
+#endif
+
+//Phase function
+// - param is the parameter of the chain the phase belongs to
+// - *delayUs is 0 on entry. Set to delay the next call.
+typedef HpsErr_t (*InitPhaseFunc_t)(void* param, unsigned int* delayUs);
+
+//Phase table entry
+typedef struct {
+    const char* name;         // Name shown in the timeline
+    InitPhaseFunc_t func;     // Phase function
+    unsigned int deadlineUs;  // Time allowed from first call to completion. 0 = no deadline
+} InitPhase_t;
+
+//Chain of phases run in order
+typedef struct {
+    const char* name;           // Name shown in the timeline
+    const InitPhase_t* phases;  // Table of phases
+    unsigned int phaseCount;    // Number of phases in table
+    void* param;                // Parameter passed to every phase
+} InitChain_t;
+
+//Timeline entry for a phase
+typedef struct {
+    unsigned char chain;  // Index of chain
+    unsigned char phase;  // Index of phase within chain
+    unsigned short polls; // Number of times the phase function was called
+    HpsErr_t status;      // Result of the phase
+    uint32_t startUs;     // Time of first call, relative to start of run
+    uint32_t endUs;       // Time phase completed or failed
+} InitEvent_t;
+
+//Run a set of initialisation chains
+// - Interleaves the chains until every chain has either completed or failed.
+// - If showTimeline is true, prints the timeline with printf once complete.
+// - Returns ERR_SUCCESS if all chains completed, otherwise the error of the
+//   first chain to fail.
+HpsErr_t HPS_InitSched_run(const InitChain_t* chains, unsigned int chainCount, bool showTimeline);
+
+//Print the timeline of the last run
+// - Can be used if HPS_InitSched_run() was called with showTimeline false.
+void HPS_InitSched_printTimeline(const InitChain_t* chains, unsigned int chainCount);
+
+//Get the timeline of the last run
+// - *events is set to the event list, and *count to the number of entries.
+// - *totalUs is set to total run time (can be NULL).
+HpsErr_t HPS_InitSched_getTimeline(const InitEvent_t** events, unsigned int* count, uint32_t* totalUs);
+
+#endif /* HPS_INITSCHED_H_ */
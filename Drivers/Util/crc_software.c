@@ -0,0 +1,198 @@
+/* Software CRC Driver
+ * -------------------
+ *
+ * Table-driven software implementation of the generic
+ * CRC driver interface (Util/driver_crc.h), for boards
+ * without a hardware CRC core.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver.
+ */
+
+#include "crc_software.h"
+
+#include "Util/bit_helpers.h"
+
+/*
+ * Preset Tables
+ */
+
+SWCRC_GENERATE_TABLE(SWCRC_CRC32      , 0x04C11DB7, 32, true , 0xFFFFFFFF);
+SWCRC_GENERATE_TABLE(SWCRC_CRC32C     , 0x1EDC6F41, 32, true , 0xFFFFFFFF);
+SWCRC_GENERATE_TABLE(SWCRC_CRC16_CCITT, 0x1021    , 16, false, 0x0000    );
+
+/*
+ * Internal Functions
+ */
+
+//Load 32-bit word from aligned address
+static inline uint32_t _SWCRC_load(const uint8_t* data) {
+    return *(const uint32_t*)data;
+}
+
+//Reflected (LSB-first) CRC update
+static uint32_t _SWCRC_updateReflected(const uint32_t (*table)[256], uint32_t crc, const uint8_t* data, unsigned int length) {
+    //Process bytes until aligned for word access
+    while (length && !pointerIsAligned(data, sizeof(uint32_t))) {
+        crc = (crc >> 8) ^ table[0][(crc ^ *data++) & 0xFF];
+        length--;
+    }
+    //Slicing-by-8. The first word is XOR'd with the register, the second is
+    //looked up directly, as the register has been shifted out by then.
+    while (length >= 8) {
+        uint32_t lo = crc ^ le32_to_cpu(_SWCRC_load(data));
+        uint32_t hi = le32_to_cpu(_SWCRC_load(data + 4));
+        crc = table[7][(lo      ) & 0xFF] ^ table[6][(lo >>  8) & 0xFF] ^
+              table[5][(lo >> 16) & 0xFF] ^ table[4][(lo >> 24)       ] ^
+              table[3][(hi      ) & 0xFF] ^ table[2][(hi >>  8) & 0xFF] ^
+              table[1][(hi >> 16) & 0xFF] ^ table[0][(hi >> 24)       ];
+        data += 8;
+        length -= 8;
+    }
+    //Remaining bytes
+    while (length--) {
+        crc = (crc >> 8) ^ table[0][(crc ^ *data++) & 0xFF];
+    }
+    return crc;
+}
+
+//Normal (MSB-first) CRC update
+static uint32_t _SWCRC_updateNormal(const uint32_t (*table)[256], unsigned int width, uint32_t crc, const uint8_t* data, unsigned int length) {
+    uint32_t mask = 0xFFFFFFFFUL >> (32 - width);
+    //Process bytes until aligned for word access
+    while (length && !pointerIsAligned(data, sizeof(uint32_t))) {
+        crc = ((crc << 8) & mask) ^ table[0][((crc >> (width - 8)) ^ *data++) & 0xFF];
+        length--;
+    }
+    //Slicing-by-8 with the register aligned to the top of the first word
+    while (length >= 8) {
+        uint32_t lo = (crc << (32 - width)) ^ be32_to_cpu(_SWCRC_load(data));
+        uint32_t hi = be32_to_cpu(_SWCRC_load(data + 4));
+        crc = table[7][(lo >> 24)       ] ^ table[6][(lo >> 16) & 0xFF] ^
+              table[5][(lo >>  8) & 0xFF] ^ table[4][(lo      ) & 0xFF] ^
+              table[3][(hi >> 24)       ] ^ table[2][(hi >> 16) & 0xFF] ^
+              table[1][(hi >>  8) & 0xFF] ^ table[0][(hi      ) & 0xFF];
+        data += 8;
+        length -= 8;
+    }
+    //Remaining bytes
+    while (length--) {
+        crc = ((crc << 8) & mask) ^ table[0][((crc >> (width - 8)) ^ *data++) & 0xFF];
+    }
+    return crc;
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Update a raw CRC register value with a table
+// - Can be used directly without a driver context.
+uint32_t SWCRC_update(const SWCRCTable_t* table, uint32_t crc, const uint8_t* data, unsigned int length) {
+    if (!table || !data) return crc;
+    if (table->reflected) {
+        return _SWCRC_updateReflected(table->table, crc, data, length);
+    } else {
+        return _SWCRC_updateNormal(table->table, table->width, crc, data, length);
+    }
+}
+
+//Initialise the software CRC driver
+// - table is the CRC table to use, e.g. &SWCRC_CRC32
+// - mode selects whether the crc interface is combined or split mode.
+//   Split mode allows a calculation to be chained across several buffers.
+// - Returns ERR_SUCCESS if successful.
+HpsErr_t SWCRC_initialise(const SWCRCTable_t* table, CRCFuncMode mode, PSWCRCCtx_t* pCtx) {
+    //Ensure user pointers valid
+    if (!table) return ERR_NULLPTR;
+    if ((table->width < 8) || (table->width > 32)) return ERR_NOSUPPORT;
+    if ((mode != CRC_FUNC_COMBINED) && (mode != CRC_FUNC_SPLIT)) return ERR_BADID;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocate(pCtx);
+    if (IS_ERROR(status)) return status;
+    //Save the table
+    PSWCRCCtx_t ctx = *pCtx;
+    ctx->table = table;
+    ctx->initVal = table->initVal;
+    ctx->value = table->initVal;
+    //Populate the CRC structure
+    ctx->crc.ctx = ctx;
+    ctx->crc.mode = mode;
+    ctx->crc.getWidth = (CRCGetWidth_t)&SWCRC_getWidth;
+    if (mode == CRC_FUNC_COMBINED) {
+        ctx->crc.combined.calculate = (CRCCalcCombinedFunc_t)&SWCRC_calculateCombined;
+    } else {
+        ctx->crc.split.initialise = (CRCInitialiseFunc_t)&SWCRC_initialiseValue;
+        ctx->crc.split.calculate = (CRCCalculateFunc_t)&SWCRC_calculate;
+        ctx->crc.split.getResult = (CRCResultFunc_t)&SWCRC_getResult;
+    }
+    //And initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+// - Returns true if driver previously initialised
+bool SWCRC_isInitialised(PSWCRCCtx_t ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Get the CRC width in bits
+HpsErrExt_t SWCRC_getWidth(PSWCRCCtx_t ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    return ctx->table->width;
+}
+
+//Combined mode calculation
+// - *crc is the initial register value, and is replaced with the result.
+HpsErr_t SWCRC_calculateCombined(PSWCRCCtx_t ctx, const uint8_t* data, unsigned int length, unsigned int* crc) {
+    if (!data || !crc) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    //Calculate
+    uint32_t mask = 0xFFFFFFFFUL >> (32 - ctx->table->width);
+    *crc = SWCRC_update(ctx->table, *crc & mask, data, length);
+    return ERR_SUCCESS;
+}
+
+//Split mode - set the initial value
+HpsErr_t SWCRC_initialiseValue(PSWCRCCtx_t ctx, unsigned int initVal) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    ctx->initVal = initVal & (0xFFFFFFFFUL >> (32 - ctx->table->width));
+    return ERR_SUCCESS;
+}
+
+//Split mode - calculate
+// - If reset is true, the register is first loaded with the initial value,
+//   otherwise the calculation continues from the previous result.
+HpsErr_t SWCRC_calculate(PSWCRCCtx_t ctx, const uint8_t* data, unsigned int length, bool reset) {
+    if (!data) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    //Calculate
+    if (reset) ctx->value = ctx->initVal;
+    ctx->value = SWCRC_update(ctx->table, ctx->value, data, length);
+    return ERR_SUCCESS;
+}
+
+//Split mode - get the result
+HpsErr_t SWCRC_getResult(PSWCRCCtx_t ctx, unsigned int* res) {
+    if (!res) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (IS_ERROR(status)) return status;
+    *res = ctx->value;
+    return ERR_SUCCESS;
+}
@@ -0,0 +1,207 @@
+/* Software CRC Driver
+ * -------------------
+ *
+ * Table-driven software implementation of the generic
+ * CRC driver interface (Util/driver_crc.h), for boards
+ * without a hardware CRC core.
+ *
+ * Uses slicing-by-8, processing eight bytes per loop with
+ * eight 256-entry lookup tables. The tables are generated
+ * at compile time from the polynomial, so any CRC of 8 to
+ * 32 bits can be supported by generating a new table:
+ *
+ *    // In a header
+ *    SWCRC_DECLARE_TABLE(MyCrc);
+ *    // In one source file (name, poly, width, reflected, init)
+ *    SWCRC_GENERATE_TABLE(MyCrc, 0x8005, 16, true, 0x0000);
+ *
+ * The poly is given in normal (MSB-first) form. For a
+ * reflected CRC the table uses the bit-reversed poly.
+ *
+ * The following presets are provided:
+ *
+ *    SWCRC_CRC32        - 0x04C11DB7, reflected (zlib/Ethernet)
+ *    SWCRC_CRC32C       - 0x1EDC6F41, reflected (Castagnoli)
+ *    SWCRC_CRC16_CCITT  - 0x1021, not reflected
+ *
+ * Each table takes 8kB of read-only memory. Tables which
+ * are not referenced are removed by the linker.
+ *
+ * Like hardware CRC cores, the driver works on the raw CRC
+ * register. Any final XOR is applied by the caller (e.g. the
+ * crc32() compatibility function applies it for CRC32).
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver.
+ */
+
+#ifndef CRC_SOFTWARE_H_
+#define CRC_SOFTWARE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/driver_ctx.h"
+#include "Util/driver_crc.h"
+
+//CRC lookup table and configuration
+typedef struct {
+    unsigned int width;     // Width of CRC in bits (8 to 32)
+    bool reflected;         // Whether input and output are bit-reversed (LSB-first)
+    unsigned int initVal;   // Default initial value for split mode
+    uint32_t table[8][256]; // Slicing-by-8 tables. table[k][b] is CRC of b followed by k zero bytes
+} SWCRCTable_t, *PSWCRCTable_t;
+
+//Driver context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    const SWCRCTable_t* table;
+    unsigned int initVal;
+    unsigned int value;
+    CRCCtx_t crc;
+} SWCRCCtx_t, *PSWCRCCtx_t;
+
+//Preset tables
+extern const SWCRCTable_t SWCRC_CRC32;
+extern const SWCRCTable_t SWCRC_CRC32C;
+extern const SWCRCTable_t SWCRC_CRC16_CCITT;
+
+//Initialise the software CRC driver
+// - table is the CRC table to use, e.g. &SWCRC_CRC32
+// - mode selects whether the crc interface is combined or split mode.
+//   Split mode allows a calculation to be chained across several buffers.
+// - Returns ERR_SUCCESS if successful.
+HpsErr_t SWCRC_initialise(const SWCRCTable_t* table, CRCFuncMode mode, PSWCRCCtx_t* pCtx);
+
+//Check if driver initialised
+// - Returns true if driver previously initialised
+bool SWCRC_isInitialised(PSWCRCCtx_t ctx);
+
+//Get the CRC width in bits
+HpsErrExt_t SWCRC_getWidth(PSWCRCCtx_t ctx);
+
+//Combined mode calculation
+// - *crc is the initial register value, and is replaced with the result.
+HpsErr_t SWCRC_calculateCombined(PSWCRCCtx_t ctx, const uint8_t* data, unsigned int length, unsigned int* crc);
+
+//Split mode functions
+// - initialise sets the value loaded into the register when calculate is called with reset.
+// - calculate processes length bytes, first loading the init value if reset is true.
+//   Call with reset false to continue a previous calculation.
+// - getResult returns the current register value.
+HpsErr_t SWCRC_initialiseValue(PSWCRCCtx_t ctx, unsigned int initVal);
+HpsErr_t SWCRC_calculate(PSWCRCCtx_t ctx, const uint8_t* data, unsigned int length, bool reset);
+HpsErr_t SWCRC_getResult(PSWCRCCtx_t ctx, unsigned int* res);
+
+//Update a raw CRC register value with a table
+// - Can be used directly without a driver context.
+uint32_t SWCRC_update(const SWCRCTable_t* table, uint32_t crc, const uint8_t* data, unsigned int length);
+
+
+/*
+ * Compile-time Table Generation
+ *
+ * The CRC is linear, so table[k][b] is the XOR of the table
+ * entries for each set bit of b. For a single set bit, this is
+ * the register value after n shifts of a single bit, S(n), with
+ * n between 1 and 64. S(n) is generated as a sequence of enum
+ * constants so that each step only references the previous one.
+ */
+
+//Declare a table generated with SWCRC_GENERATE_TABLE
+#define SWCRC_DECLARE_TABLE(name) extern const SWCRCTable_t name
+
+//Generate a table
+// - poly is the normal (MSB-first) polynomial without the leading 1
+// - width is CRC width in bits, 8 to 32
+// - reflected selects an LSB-first CRC
+// - init is the default initial value in split mode
+#define SWCRC_GENERATE_TABLE(name, poly, width, reflected, init) \
+    _SWCRC_SEQUENCE(name, poly, width, reflected);                \
+    const SWCRCTable_t name = {                                   \
+        (width), (reflected), (init), {                           \
+            { _SWCRC_BYTES(_SWCRC_ROW0, name, reflected) },        \
+            { _SWCRC_BYTES(_SWCRC_ROW1, name, reflected) },        \
+            { _SWCRC_BYTES(_SWCRC_ROW2, name, reflected) },        \
+            { _SWCRC_BYTES(_SWCRC_ROW3, name, reflected) },        \
+            { _SWCRC_BYTES(_SWCRC_ROW4, name, reflected) },        \
+            { _SWCRC_BYTES(_SWCRC_ROW5, name, reflected) },        \
+            { _SWCRC_BYTES(_SWCRC_ROW6, name, reflected) },        \
+            { _SWCRC_BYTES(_SWCRC_ROW7, name, reflected) }         \
+        }                                                         \
+    }
+
+//Width mask and polynomial in the form used by the table
+#define _SWCRC_MASK(w) ((uint32_t)(0xFFFFFFFFUL >> (32 - (w))))
+#define _SWCRC_REV1(x)  ((((x) >>  1) & 0x55555555UL) | (((x) & 0x55555555UL) <<  1))
+#define _SWCRC_REV2(x)  ((((x) >>  2) & 0x33333333UL) | (((x) & 0x33333333UL) <<  2))
+#define _SWCRC_REV4(x)  ((((x) >>  4) & 0x0F0F0F0FUL) | (((x) & 0x0F0F0F0FUL) <<  4))
+#define _SWCRC_REV8(x)  ((((x) >>  8) & 0x00FF00FFUL) | (((x) & 0x00FF00FFUL) <<  8))
+#define _SWCRC_REV16(x) ((((x) >> 16) & 0x0000FFFFUL) | (((x) & 0x0000FFFFUL) << 16))
+#define _SWCRC_REV32(x) ((uint32_t)_SWCRC_REV16(_SWCRC_REV8(_SWCRC_REV4(_SWCRC_REV2(_SWCRC_REV1((uint32_t)(x)))))))
+#define _SWCRC_POLY(poly,w,refl) \
+    ((refl) ? (_SWCRC_REV32(poly) >> (32 - (w))) : ((uint32_t)(poly) & _SWCRC_MASK(w)))
+
+//Shift the register by one bit
+#define _SWCRC_STEP(c,poly,w,refl)                                                                  \
+    ((refl) ? ((((uint32_t)(c)) >> 1) ^ ((((uint32_t)(c)) & 1) ? _SWCRC_POLY(poly,w,refl) : 0))          \
+            : (((((uint32_t)(c)) << 1) & _SWCRC_MASK(w)) ^ (((((uint32_t)(c)) >> ((w) - 1)) & 1) ? _SWCRC_POLY(poly,w,refl) : 0)))
+
+//Sequence of single bit register values, S(0) to S(64)
+#define _SWCRC_S(name,n,prev,poly,w,refl) name##_S##n = (int)_SWCRC_STEP(name##_S##prev,poly,w,refl)
+#define _SWCRC_SEQUENCE(name,poly,w,refl) enum { \
+    name##_S0 = (int)((refl) ? 1UL : (1UL << ((w) - 1))), \
+    _SWCRC_S(name,1,0,poly,w,refl), _SWCRC_S(name,2,1,poly,w,refl), _SWCRC_S(name,3,2,poly,w,refl), _SWCRC_S(name,4,3,poly,w,refl), _SWCRC_S(name,5,4,poly,w,refl), _SWCRC_S(name,6,5,poly,w,refl), _SWCRC_S(name,7,6,poly,w,refl), _SWCRC_S(name,8,7,poly,w,refl), \
+    _SWCRC_S(name,9,8,poly,w,refl), _SWCRC_S(name,10,9,poly,w,refl), _SWCRC_S(name,11,10,poly,w,refl), _SWCRC_S(name,12,11,poly,w,refl), _SWCRC_S(name,13,12,poly,w,refl), _SWCRC_S(name,14,13,poly,w,refl), _SWCRC_S(name,15,14,poly,w,refl), _SWCRC_S(name,16,15,poly,w,refl), \
+    _SWCRC_S(name,17,16,poly,w,refl), _SWCRC_S(name,18,17,poly,w,refl), _SWCRC_S(name,19,18,poly,w,refl), _SWCRC_S(name,20,19,poly,w,refl), _SWCRC_S(name,21,20,poly,w,refl), _SWCRC_S(name,22,21,poly,w,refl), _SWCRC_S(name,23,22,poly,w,refl), _SWCRC_S(name,24,23,poly,w,refl), \
+    _SWCRC_S(name,25,24,poly,w,refl), _SWCRC_S(name,26,25,poly,w,refl), _SWCRC_S(name,27,26,poly,w,refl), _SWCRC_S(name,28,27,poly,w,refl), _SWCRC_S(name,29,28,poly,w,refl), _SWCRC_S(name,30,29,poly,w,refl), _SWCRC_S(name,31,30,poly,w,refl), _SWCRC_S(name,32,31,poly,w,refl), \
+    _SWCRC_S(name,33,32,poly,w,refl), _SWCRC_S(name,34,33,poly,w,refl), _SWCRC_S(name,35,34,poly,w,refl), _SWCRC_S(name,36,35,poly,w,refl), _SWCRC_S(name,37,36,poly,w,refl), _SWCRC_S(name,38,37,poly,w,refl), _SWCRC_S(name,39,38,poly,w,refl), _SWCRC_S(name,40,39,poly,w,refl), \
+    _SWCRC_S(name,41,40,poly,w,refl), _SWCRC_S(name,42,41,poly,w,refl), _SWCRC_S(name,43,42,poly,w,refl), _SWCRC_S(name,44,43,poly,w,refl), _SWCRC_S(name,45,44,poly,w,refl), _SWCRC_S(name,46,45,poly,w,refl), _SWCRC_S(name,47,46,poly,w,refl), _SWCRC_S(name,48,47,poly,w,refl), \
+    _SWCRC_S(name,49,48,poly,w,refl), _SWCRC_S(name,50,49,poly,w,refl), _SWCRC_S(name,51,50,poly,w,refl), _SWCRC_S(name,52,51,poly,w,refl), _SWCRC_S(name,53,52,poly,w,refl), _SWCRC_S(name,54,53,poly,w,refl), _SWCRC_S(name,55,54,poly,w,refl), _SWCRC_S(name,56,55,poly,w,refl), \
+    _SWCRC_S(name,57,56,poly,w,refl), _SWCRC_S(name,58,57,poly,w,refl), _SWCRC_S(name,59,58,poly,w,refl), _SWCRC_S(name,60,59,poly,w,refl), _SWCRC_S(name,61,60,poly,w,refl), _SWCRC_S(name,62,61,poly,w,refl), _SWCRC_S(name,63,62,poly,w,refl), _SWCRC_S(name,64,63,poly,w,refl), \
+}
+
+//Table entry for byte b from the S(n) for each bit
+#define _SWCRC_E(name,b,i,n) ((((b) >> (i)) & 1) ? (uint32_t)name##_S##n : 0)
+#define _SWCRC_ENTRY(name,b,n0,n1,n2,n3,n4,n5,n6,n7) \
+    (_SWCRC_E(name,b,0,n0) ^ _SWCRC_E(name,b,1,n1) ^ _SWCRC_E(name,b,2,n2) ^ _SWCRC_E(name,b,3,n3) ^ \
+     _SWCRC_E(name,b,4,n4) ^ _SWCRC_E(name,b,5,n5) ^ _SWCRC_E(name,b,6,n6) ^ _SWCRC_E(name,b,7,n7))
+
+//Row k uses S(8(k+1)-i) for bit i if reflected, otherwise S(8k+i+1)
+#define _SWCRC_ROW0(b,name,refl) ((refl) ? _SWCRC_ENTRY(name,b,8,7,6,5,4,3,2,1) : _SWCRC_ENTRY(name,b,1,2,3,4,5,6,7,8))
+#define _SWCRC_ROW1(b,name,refl) ((refl) ? _SWCRC_ENTRY(name,b,16,15,14,13,12,11,10,9) : _SWCRC_ENTRY(name,b,9,10,11,12,13,14,15,16))
+#define _SWCRC_ROW2(b,name,refl) ((refl) ? _SWCRC_ENTRY(name,b,24,23,22,21,20,19,18,17) : _SWCRC_ENTRY(name,b,17,18,19,20,21,22,23,24))
+#define _SWCRC_ROW3(b,name,refl) ((refl) ? _SWCRC_ENTRY(name,b,32,31,30,29,28,27,26,25) : _SWCRC_ENTRY(name,b,25,26,27,28,29,30,31,32))
+#define _SWCRC_ROW4(b,name,refl) ((refl) ? _SWCRC_ENTRY(name,b,40,39,38,37,36,35,34,33) : _SWCRC_ENTRY(name,b,33,34,35,36,37,38,39,40))
+#define _SWCRC_ROW5(b,name,refl) ((refl) ? _SWCRC_ENTRY(name,b,48,47,46,45,44,43,42,41) : _SWCRC_ENTRY(name,b,41,42,43,44,45,46,47,48))
+#define _SWCRC_ROW6(b,name,refl) ((refl) ? _SWCRC_ENTRY(name,b,56,55,54,53,52,51,50,49) : _SWCRC_ENTRY(name,b,49,50,51,52,53,54,55,56))
+#define _SWCRC_ROW7(b,name,refl) ((refl) ? _SWCRC_ENTRY(name,b,64,63,62,61,60,59,58,57) : _SWCRC_ENTRY(name,b,57,58,59,60,61,62,63,64))
+
+//Apply M to each byte value
+#define _SWCRC_BYTES(M,...) \
+    M(0,__VA_ARGS__), M(1,__VA_ARGS__), M(2,__VA_ARGS__), M(3,__VA_ARGS__), M(4,__VA_ARGS__), M(5,__VA_ARGS__), M(6,__VA_ARGS__), M(7,__VA_ARGS__), M(8,__VA_ARGS__), M(9,__VA_ARGS__), M(10,__VA_ARGS__), M(11,__VA_ARGS__), M(12,__VA_ARGS__), M(13,__VA_ARGS__), M(14,__VA_ARGS__), M(15,__VA_ARGS__), \
+    M(16,__VA_ARGS__), M(17,__VA_ARGS__), M(18,__VA_ARGS__), M(19,__VA_ARGS__), M(20,__VA_ARGS__), M(21,__VA_ARGS__), M(22,__VA_ARGS__), M(23,__VA_ARGS__), M(24,__VA_ARGS__), M(25,__VA_ARGS__), M(26,__VA_ARGS__), M(27,__VA_ARGS__), M(28,__VA_ARGS__), M(29,__VA_ARGS__), M(30,__VA_ARGS__), M(31,__VA_ARGS__), \
+    M(32,__VA_ARGS__), M(33,__VA_ARGS__), M(34,__VA_ARGS__), M(35,__VA_ARGS__), M(36,__VA_ARGS__), M(37,__VA_ARGS__), M(38,__VA_ARGS__), M(39,__VA_ARGS__), M(40,__VA_ARGS__), M(41,__VA_ARGS__), M(42,__VA_ARGS__), M(43,__VA_ARGS__), M(44,__VA_ARGS__), M(45,__VA_ARGS__), M(46,__VA_ARGS__), M(47,__VA_ARGS__), \
+    M(48,__VA_ARGS__), M(49,__VA_ARGS__), M(50,__VA_ARGS__), M(51,__VA_ARGS__), M(52,__VA_ARGS__), M(53,__VA_ARGS__), M(54,__VA_ARGS__), M(55,__VA_ARGS__), M(56,__VA_ARGS__), M(57,__VA_ARGS__), M(58,__VA_ARGS__), M(59,__VA_ARGS__), M(60,__VA_ARGS__), M(61,__VA_ARGS__), M(62,__VA_ARGS__), M(63,__VA_ARGS__), \
+    M(64,__VA_ARGS__), M(65,__VA_ARGS__), M(66,__VA_ARGS__), M(67,__VA_ARGS__), M(68,__VA_ARGS__), M(69,__VA_ARGS__), M(70,__VA_ARGS__), M(71,__VA_ARGS__), M(72,__VA_ARGS__), M(73,__VA_ARGS__), M(74,__VA_ARGS__), M(75,__VA_ARGS__), M(76,__VA_ARGS__), M(77,__VA_ARGS__), M(78,__VA_ARGS__), M(79,__VA_ARGS__), \
+    M(80,__VA_ARGS__), M(81,__VA_ARGS__), M(82,__VA_ARGS__), M(83,__VA_ARGS__), M(84,__VA_ARGS__), M(85,__VA_ARGS__), M(86,__VA_ARGS__), M(87,__VA_ARGS__), M(88,__VA_ARGS__), M(89,__VA_ARGS__), M(90,__VA_ARGS__), M(91,__VA_ARGS__), M(92,__VA_ARGS__), M(93,__VA_ARGS__), M(94,__VA_ARGS__), M(95,__VA_ARGS__), \
+    M(96,__VA_ARGS__), M(97,__VA_ARGS__), M(98,__VA_ARGS__), M(99,__VA_ARGS__), M(100,__VA_ARGS__), M(101,__VA_ARGS__), M(102,__VA_ARGS__), M(103,__VA_ARGS__), M(104,__VA_ARGS__), M(105,__VA_ARGS__), M(106,__VA_ARGS__), M(107,__VA_ARGS__), M(108,__VA_ARGS__), M(109,__VA_ARGS__), M(110,__VA_ARGS__), M(111,__VA_ARGS__), \
+    M(112,__VA_ARGS__), M(113,__VA_ARGS__), M(114,__VA_ARGS__), M(115,__VA_ARGS__), M(116,__VA_ARGS__), M(117,__VA_ARGS__), M(118,__VA_ARGS__), M(119,__VA_ARGS__), M(120,__VA_ARGS__), M(121,__VA_ARGS__), M(122,__VA_ARGS__), M(123,__VA_ARGS__), M(124,__VA_ARGS__), M(125,__VA_ARGS__), M(126,__VA_ARGS__), M(127,__VA_ARGS__), \
+    M(128,__VA_ARGS__), M(129,__VA_ARGS__), M(130,__VA_ARGS__), M(131,__VA_ARGS__), M(132,__VA_ARGS__), M(133,__VA_ARGS__), M(134,__VA_ARGS__), M(135,__VA_ARGS__), M(136,__VA_ARGS__), M(137,__VA_ARGS__), M(138,__VA_ARGS__), M(139,__VA_ARGS__), M(140,__VA_ARGS__), M(141,__VA_ARGS__), M(142,__VA_ARGS__), M(143,__VA_ARGS__), \
+    M(144,__VA_ARGS__), M(145,__VA_ARGS__), M(146,__VA_ARGS__), M(147,__VA_ARGS__), M(148,__VA_ARGS__), M(149,__VA_ARGS__), M(150,__VA_ARGS__), M(151,__VA_ARGS__), M(152,__VA_ARGS__), M(153,__VA_ARGS__), M(154,__VA_ARGS__), M(155,__VA_ARGS__), M(156,__VA_ARGS__), M(157,__VA_ARGS__), M(158,__VA_ARGS__), M(159,__VA_ARGS__), \
+    M(160,__VA_ARGS__), M(161,__VA_ARGS__), M(162,__VA_ARGS__), M(163,__VA_ARGS__), M(164,__VA_ARGS__), M(165,__VA_ARGS__), M(166,__VA_ARGS__), M(167,__VA_ARGS__), M(168,__VA_ARGS__), M(169,__VA_ARGS__), M(170,__VA_ARGS__), M(171,__VA_ARGS__), M(172,__VA_ARGS__), M(173,__VA_ARGS__), M(174,__VA_ARGS__), M(175,__VA_ARGS__), \
+    M(176,__VA_ARGS__), M(177,__VA_ARGS__), M(178,__VA_ARGS__), M(179,__VA_ARGS__), M(180,__VA_ARGS__), M(181,__VA_ARGS__), M(182,__VA_ARGS__), M(183,__VA_ARGS__), M(184,__VA_ARGS__), M(185,__VA_ARGS__), M(186,__VA_ARGS__), M(187,__VA_ARGS__), M(188,__VA_ARGS__), M(189,__VA_ARGS__), M(190,__VA_ARGS__), M(191,__VA_ARGS__), \
+    M(192,__VA_ARGS__), M(193,__VA_ARGS__), M(194,__VA_ARGS__), M(195,__VA_ARGS__), M(196,__VA_ARGS__), M(197,__VA_ARGS__), M(198,__VA_ARGS__), M(199,__VA_ARGS__), M(200,__VA_ARGS__), M(201,__VA_ARGS__), M(202,__VA_ARGS__), M(203,__VA_ARGS__), M(204,__VA_ARGS__), M(205,__VA_ARGS__), M(206,__VA_ARGS__), M(207,__VA_ARGS__), \
+    M(208,__VA_ARGS__), M(209,__VA_ARGS__), M(210,__VA_ARGS__), M(211,__VA_ARGS__), M(212,__VA_ARGS__), M(213,__VA_ARGS__), M(214,__VA_ARGS__), M(215,__VA_ARGS__), M(216,__VA_ARGS__), M(217,__VA_ARGS__), M(218,__VA_ARGS__), M(219,__VA_ARGS__), M(220,__VA_ARGS__), M(221,__VA_ARGS__), M(222,__VA_ARGS__), M(223,__VA_ARGS__), \
+    M(224,__VA_ARGS__), M(225,__VA_ARGS__), M(226,__VA_ARGS__), M(227,__VA_ARGS__), M(228,__VA_ARGS__), M(229,__VA_ARGS__), M(230,__VA_ARGS__), M(231,__VA_ARGS__), M(232,__VA_ARGS__), M(233,__VA_ARGS__), M(234,__VA_ARGS__), M(235,__VA_ARGS__), M(236,__VA_ARGS__), M(237,__VA_ARGS__), M(238,__VA_ARGS__), M(239,__VA_ARGS__), \
+    M(240,__VA_ARGS__), M(241,__VA_ARGS__), M(242,__VA_ARGS__), M(243,__VA_ARGS__), M(244,__VA_ARGS__), M(245,__VA_ARGS__), M(246,__VA_ARGS__), M(247,__VA_ARGS__), M(248,__VA_ARGS__), M(249,__VA_ARGS__), M(250,__VA_ARGS__), M(251,__VA_ARGS__), M(252,__VA_ARGS__), M(253,__VA_ARGS__), M(254,__VA_ARGS__), M(255,__VA_ARGS__)
+
+#endif /* CRC_SOFTWARE_H_ */
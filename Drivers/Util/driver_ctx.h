@@ -11,6 +11,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 17/10/2026 | Add validated handle fast path
  * 29/12/2023 | Creation of driver.
  */
 
@@ -102,6 +103,22 @@
         return ERR_SUCCESS;
     }
 
+    // Example fast path API (in driver header)
+
+    // The body is written once as a static inline in the header, and is used
+    // by both the checked API above and the unchecked fast path variant.
+    static inline HpsErr_t _MY_readValue(PMyDriverCtx_t ctx, unsigned int *val) {
+        *val = ctx->base[MY_DATA_REG];
+        return ERR_SUCCESS;
+    }
+    #define MY_readValueFast(handle, val) DriverHandleCall(handle, _MY_readValue, val)
+
+    // Usage:
+    PMyDriverCtx_t handle;
+    if (IS_SUCCESS(DriverContextGetHandle(ctx, &handle))) {
+        while (1) MY_readValueFast(handle, &val);
+    }
+
  *
  */
 
@@ -203,5 +220,47 @@ HpsErr_t DRV_checkContext(PDrvCtx_t ctx);
 #define DriverContextValidate(ctx) \
     DRV_checkContext((PDrvCtx_t)(ctx))
 
+
+/*
+ * Validated Handle Fast Path
+ *
+ * Hot paths can validate a context once to obtain a handle, and then
+ * call unchecked inline variants of a driver's API with that handle.
+ *
+ * In release builds the unchecked calls compile down to the raw
+ * register accesses with no context checks. If DEBUG is globally
+ * defined, every unchecked call still fully validates the context.
+ */
+
+// Validate a context once and return it as a handle
+// - *pHandle is set to NULL if the context is not valid.
+static inline HpsErr_t DRV_getHandle(PDrvCtx_t ctx, PDrvCtx_t* pHandle) {
+    if (!pHandle) return ERR_NULLPTR;
+    HpsErr_t status = DRV_checkContext(ctx);
+    *pHandle = IS_SUCCESS(status) ? ctx : NULL;
+    return status;
+}
+
+// Get a validated handle for a driver context
+// - Handle is of the same type as the context pointer.
+// - Returns HpsErr_t
+#define DriverContextGetHandle(ctx, pHandle) \
+    DRV_getHandle((PDrvCtx_t)(ctx), (PDrvCtx_t*)(pHandle))
+
+// Call an unchecked inline driver function with a validated handle
+// - func must be of the form HpsErr_t func(ctx, ...)
+// - Returns HpsErr_t
+#ifdef DEBUG
+#define DriverHandleCall(handle, func, ...)                                    \
+  __extension__({                                                              \
+    HpsErr_t __hstatus = DRV_checkContext((PDrvCtx_t)(handle));                \
+    if (IS_SUCCESS(__hstatus)) __hstatus = func((handle), ##__VA_ARGS__);      \
+    __hstatus;                                                                 \
+  })
+#else
+#define DriverHandleCall(handle, func, ...) \
+    func((handle), ##__VA_ARGS__)
+#endif
+
 #endif /* DRIVER_CTX_H */
 
@@ -6,6 +6,13 @@
  * a macro to define the entries and values. This
  * same macro can then be used to generate a string
  * lookup table for the enum values.
+ *
+ * Indexed lookups binary search a value-sorted order,
+ * and use a hash-and-displace perfect hash for strings.
+ * Each string is hashed to a bucket, and each bucket has
+ * a displacement chosen when the index is built so that
+ * every string lands in its own slot. If no displacement
+ * can be found, the index falls back to linear probing.
  * 
  * Company: University of Leeds
  * Author: T Carpenter
@@ -14,6 +21,8 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 17/10/2026 | Mask IRQs while building the lookup index
+ * 17/10/2026 | Add sorted and hashed lookup index
  * 30/01/2024 | Adapt for embedded code from DLL
  * 30/01/2018 | Creation of utility
  *
@@ -40,8 +49,175 @@
 #define DLLDbgPrintEx(...)
 #endif
 
-#ifndef enumToString
-const char* enumToString(size_t enumVal, const EnumLookupTable_t* lookupTable, size_t lookupTableLength) {
+#if defined(ENUM_LOOKUP_ENABLED) || defined(PCIEUARPLIBSYNC_EXPORTS)
+
+//Largest displacement to try for each hash bucket
+#ifndef ENUM_LOOKUP_MAX_DISP
+#define ENUM_LOOKUP_MAX_DISP 1024
+#endif
+
+//Largest number of strings in one hash bucket
+#define ENUM_LOOKUP_MAX_BUCKET 16
+
+//The index is built on first use, which could be from an interrupt handler, or
+//interrupt a build already in progress. On ARM, IRQs are masked while building
+//so a nested lookup can't see a half built index.
+#if defined(__arm__)
+    #include "Util/lowlevel.h"
+    #define _enumLookupMaskIrq()        __disable_irq()
+    #define _enumLookupRestoreIrq(mask) { if (!(mask)) __enable_irq(); }
+    #define _enumLookupBarrier()        __dmb(0xF)
+#else
+    #define _enumLookupMaskIrq()        0
+    #define _enumLookupRestoreIrq(mask) ((void)(mask))
+    #define _enumLookupBarrier()
+#endif
+
+/*
+ * Internal Functions
+ */
+
+//Seeded FNV-1a string hash with final avalanche
+static unsigned int _enumLookupHash(const char* str, unsigned int seed) {
+    unsigned int hash = 2166136261U ^ (seed * 0x9E3779B9U);
+    while (*str) {
+        hash ^= (unsigned char)*str++;
+        hash *= 16777619U;
+    }
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6BU;
+    hash ^= hash >> 13;
+    return hash;
+}
+
+//Bucket and slot for a string
+#define _enumLookupBucket(index, str)     (_enumLookupHash((str), 0) % (index)->length)
+#define _enumLookupSlot(index, str, disp) (_enumLookupHash((str), (disp)) % (index)->hashSize)
+
+//Check if the index is usable for a given table
+static int _enumLookupIndexValid(EnumLookupIndex_t* index, const EnumLookupTable_t* lookupTable, size_t lookupTableLength) {
+    if (!index || (index->table != lookupTable) || (index->length != lookupTableLength)) return 0;
+    if (!index->built) enumLookupBuildIndex(index);
+    return index->built;
+}
+
+//Check if a string appears earlier in the table
+// - Only the first of any duplicate strings is hashed to match linear search.
+static int _enumLookupIsDuplicate(EnumLookupIndex_t* index, size_t idx) {
+    for (size_t prev = 0; prev < idx; prev++) {
+        if (!strcmp(index->table[prev].str, index->table[idx].str)) return 1;
+    }
+    return 0;
+}
+
+//Place all strings using hash and displace
+// - Buckets are placed largest first, each trying displacements until
+//   all of its strings land in free slots.
+// - Returns 1 if successful.
+static int _enumLookupPlacePerfect(EnumLookupIndex_t* index) {
+    unsigned short* bucketSize = index->valueOrder; //Used as scratch before sorting
+    unsigned short members[ENUM_LOOKUP_MAX_BUCKET];
+    size_t slots[ENUM_LOOKUP_MAX_BUCKET];
+    size_t maxSize = 0;
+    //Count the strings in each bucket
+    memset(bucketSize, 0, index->length * sizeof(*bucketSize));
+    for (size_t idx = 0; idx < index->length; idx++) {
+        if (_enumLookupIsDuplicate(index, idx)) continue;
+        size_t bucket = _enumLookupBucket(index, index->table[idx].str);
+        if (++bucketSize[bucket] > maxSize) maxSize = bucketSize[bucket];
+    }
+    if (maxSize > ENUM_LOOKUP_MAX_BUCKET) return 0;
+    //Place buckets largest first
+    for (size_t size = maxSize; size > 0; size--) {
+        for (size_t bucket = 0; bucket < index->length; bucket++) {
+            if (bucketSize[bucket] != size) continue;
+            //Gather the strings in this bucket
+            size_t count = 0;
+            for (size_t idx = 0; idx < index->length; idx++) {
+                if ((_enumLookupBucket(index, index->table[idx].str) == bucket) && !_enumLookupIsDuplicate(index, idx)) {
+                    members[count++] = (unsigned short)idx;
+                }
+            }
+            //Find a displacement which puts every string in a free slot
+            unsigned int disp;
+            for (disp = 1; disp <= ENUM_LOOKUP_MAX_DISP; disp++) {
+                size_t placed;
+                for (placed = 0; placed < count; placed++) {
+                    slots[placed] = _enumLookupSlot(index, index->table[members[placed]].str, disp);
+                    if (index->hashSlots[slots[placed]]) break;
+                    //Also must not collide with earlier strings in this bucket
+                    size_t other;
+                    for (other = 0; (other < placed) && (slots[other] != slots[placed]); other++);
+                    if (other < placed) break;
+                }
+                if (placed == count) break;
+            }
+            if (disp > ENUM_LOOKUP_MAX_DISP) return 0;
+            //Claim the slots
+            for (size_t placed = 0; placed < count; placed++) {
+                index->hashSlots[slots[placed]] = members[placed] + 1;
+            }
+            index->hashDisp[bucket] = (unsigned short)disp;
+            bucketSize[bucket] = 0;
+        }
+    }
+    return 1;
+}
+
+//Place all strings using linear probing
+static void _enumLookupPlaceProbed(EnumLookupIndex_t* index) {
+    for (size_t idx = 0; idx < index->length; idx++) {
+        if (_enumLookupIsDuplicate(index, idx)) continue;
+        size_t slot = _enumLookupSlot(index, index->table[idx].str, 0);
+        while (index->hashSlots[slot]) slot = (slot + 1) % index->hashSize;
+        index->hashSlots[slot] = (unsigned short)(idx + 1);
+    }
+}
+
+//Fill in the index
+static void _enumLookupBuild(EnumLookupIndex_t* index) {
+    //Build the string hash, falling back to probing if there is no perfect hash
+    memset(index->hashSlots, 0, index->hashSize * sizeof(*index->hashSlots));
+    memset(index->hashDisp, 0, index->length * sizeof(*index->hashDisp));
+    index->perfect = _enumLookupPlacePerfect(index);
+    if (!index->perfect) {
+        memset(index->hashSlots, 0, index->hashSize * sizeof(*index->hashSlots));
+        _enumLookupPlaceProbed(index);
+    }
+    //Sort table indices by value. Insertion sort is stable, so for duplicate
+    //values the first table entry sorts first, matching linear search.
+    for (size_t idx = 0; idx < index->length; idx++) {
+        size_t pos = idx;
+        while (pos && (index->table[index->valueOrder[pos - 1]].enumVal > index->table[idx].enumVal)) {
+            index->valueOrder[pos] = index->valueOrder[pos - 1];
+            pos--;
+        }
+        index->valueOrder[pos] = (unsigned short)idx;
+    }
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Build the index for a lookup table
+void enumLookupBuildIndex(EnumLookupIndex_t* index) {
+    if (!index || index->built) return;
+    //Index entries are 16-bit with room for the empty hash slot marker.
+    if (!index->length || (index->length >= 0xFFFF)) return;
+    int mask = _enumLookupMaskIrq();
+    //Check again, as it may have been built before IRQs were masked
+    if (!index->built) {
+        _enumLookupBuild(index);
+        //Contents must be visible before the index is marked as built
+        _enumLookupBarrier();
+        index->built = 1;
+    }
+    _enumLookupRestoreIrq(mask);
+    DLLDbgPrintEx("Built enum lookup index of %d entries (perfect hash %d)\n", index->length, index->perfect);
+}
+
+const char* (enumToString)(size_t enumVal, const EnumLookupTable_t* lookupTable, size_t lookupTableLength) {
     for (size_t idx = 0; idx < lookupTableLength; idx++) {
         if (enumVal == lookupTable[idx].enumVal) {
             DLLDbgPrintEx("Matched enumVal %d to string %s\n", enumVal, lookupTable[idx].str);
@@ -51,18 +227,41 @@ const char* enumToString(size_t enumVal, const EnumLookupTable_t* lookupTable, s
     DLLDbgPrintEx("Could not match enumVal %d to string.\n",enumVal);
     return NULL;
 }
-#endif
 
-#ifndef enumToStringSafe
-const char* enumToStringSafe(size_t enumVal, const EnumLookupTable_t* lookupTable, size_t lookupTableLength) {
-    const char* str = enumToString(enumVal, lookupTable, lookupTableLength);
+const char* enumToStringIdx(size_t enumVal, const EnumLookupTable_t* lookupTable, size_t lookupTableLength, EnumLookupIndex_t* index) {
+    if (!_enumLookupIndexValid(index, lookupTable, lookupTableLength)) return (enumToString)(enumVal, lookupTable, lookupTableLength);
+    //Binary search for the first entry with a value not less than enumVal
+    size_t lo = 0;
+    size_t hi = lookupTableLength;
+    while (lo < hi) {
+        size_t mid = lo + ((hi - lo) / 2);
+        if (lookupTable[index->valueOrder[mid]].enumVal < enumVal) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if ((lo < lookupTableLength) && (lookupTable[index->valueOrder[lo]].enumVal == enumVal)) {
+        DLLDbgPrintEx("Matched enumVal %d to string %s\n", enumVal, lookupTable[index->valueOrder[lo]].str);
+        return lookupTable[index->valueOrder[lo]].str;
+    }
+    DLLDbgPrintEx("Could not match enumVal %d to string.\n",enumVal);
+    return NULL;
+}
+
+const char* (enumToStringSafe)(size_t enumVal, const EnumLookupTable_t* lookupTable, size_t lookupTableLength) {
+    const char* str = (enumToString)(enumVal, lookupTable, lookupTableLength);
+    if (!str) return UNKNOWN_STR;
+    return str;
+}
+
+const char* enumToStringSafeIdx(size_t enumVal, const EnumLookupTable_t* lookupTable, size_t lookupTableLength, EnumLookupIndex_t* index) {
+    const char* str = enumToStringIdx(enumVal, lookupTable, lookupTableLength, index);
     if (!str) return UNKNOWN_STR;
     return str;
 }
-#endif
 
-#ifndef stringToEnum
-size_t stringToEnum(const char* str, const EnumLookupTable_t* lookupTable, size_t lookupTableLength, size_t notFoundValue) {
+size_t (stringToEnum)(const char* str, const EnumLookupTable_t* lookupTable, size_t lookupTableLength, size_t notFoundValue) {
     for (size_t idx = 0; idx < lookupTableLength; idx++) {
         if (!strcmp(str, lookupTable[idx].str)) {
             DLLDbgPrintEx("Matched string %s to enumVal %d\n", str, lookupTable[idx].enumVal);
@@ -72,4 +271,31 @@ size_t stringToEnum(const char* str, const EnumLookupTable_t* lookupTable, size_
     DLLDbgPrintEx("Could not match string %s to enumVal. Using notFoundValue of %d\n", str, notFoundValue);
     return notFoundValue;
 }
+
+size_t stringToEnumIdx(const char* str, const EnumLookupTable_t* lookupTable, size_t lookupTableLength, EnumLookupIndex_t* index, size_t notFoundValue) {
+    if (!_enumLookupIndexValid(index, lookupTable, lookupTableLength)) return (stringToEnum)(str, lookupTable, lookupTableLength, notFoundValue);
+    if (index->perfect) {
+        //Perfect hash. String can only be in one slot.
+        unsigned int disp = index->hashDisp[_enumLookupBucket(index, str)];
+        unsigned short entry = disp ? index->hashSlots[_enumLookupSlot(index, str, disp)] : 0;
+        if (entry && !strcmp(str, lookupTable[entry - 1].str)) {
+            DLLDbgPrintEx("Matched string %s to enumVal %d\n", str, lookupTable[entry - 1].enumVal);
+            return lookupTable[entry - 1].enumVal;
+        }
+    } else {
+        //Probe from the hashed slot until found or an empty slot is reached
+        size_t slot = _enumLookupSlot(index, str, 0);
+        while (index->hashSlots[slot]) {
+            const EnumLookupTable_t* entry = &lookupTable[index->hashSlots[slot] - 1];
+            if (!strcmp(str, entry->str)) {
+                DLLDbgPrintEx("Matched string %s to enumVal %d\n", str, entry->enumVal);
+                return entry->enumVal;
+            }
+            slot = (slot + 1) % index->hashSize;
+        }
+    }
+    DLLDbgPrintEx("Could not match string %s to enumVal. Using notFoundValue of %d\n", str, notFoundValue);
+    return notFoundValue;
+}
+
 #endif
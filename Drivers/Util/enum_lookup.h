@@ -6,6 +6,16 @@
  * a macro to define the entries and values. This
  * same macro can then be used to generate a string
  * lookup table for the enum values.
+ *
+ * Alongside each table, the generator also emits an
+ * index holding a value-sorted order and a string hash
+ * table. Lookups which use EnumLookupTableAndSize() make
+ * use of the index, giving O(log n) enum to string and
+ * O(1) string to enum conversion. The index storage is
+ * sized at compile time and is filled in on first use,
+ * or up front by calling EnumLookupBuildIndex(enumType).
+ * Calls made with a plain table pointer and length still
+ * use a linear scan.
  * 
  * Company: University of Leeds
  * Author: T Carpenter
@@ -14,6 +24,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 17/10/2026 | Add sorted and hashed lookup index
  * 30/01/2024 | Adapt for embedded code from DLL
  * 30/01/2018 | Creation of utility
  *
@@ -56,31 +67,79 @@ typedef struct {
 
 #if defined(ENUM_LOOKUP_ENABLED) || defined(PCIEUARPLIBSYNC_EXPORTS)
 
+//Lookup table index
+// - Generated alongside the lookup table. Do not modify.
+typedef struct {
+    const EnumLookupTable_t* table;
+    size_t          length;
+    unsigned short* valueOrder; //Table indices sorted by enum value
+    unsigned short* hashSlots;  //String hash table of (table index + 1). 0 if empty.
+    unsigned short* hashDisp;   //Hash displacement for each bucket
+    size_t          hashSize;
+    unsigned int    perfect;
+    volatile unsigned int built;
+} EnumLookupIndex_t;
+
 //Convert an enum to string.
 // - Returns NULL if not found
 const char* enumToString(size_t enumVal, const EnumLookupTable_t* lookupTable, size_t lookupTableLength);
+const char* enumToStringIdx(size_t enumVal, const EnumLookupTable_t* lookupTable, size_t lookupTableLength, EnumLookupIndex_t* index);
 
 //Convert an enum to string.
 // - Retruns `UNKNWONW_STR` if not found
 const char* enumToStringSafe(size_t enumVal, const EnumLookupTable_t* lookupTable, size_t lookupTableLength);
+const char* enumToStringSafeIdx(size_t enumVal, const EnumLookupTable_t* lookupTable, size_t lookupTableLength, EnumLookupIndex_t* index);
 
 //Convert a string to an enum value
 // - Returns `notFoundVal` if not found.
 size_t stringToEnum(const char* str, const EnumLookupTable_t* lookupTable, size_t lookupTableLength, size_t notFoundValue);
+size_t stringToEnumIdx(const char* str, const EnumLookupTable_t* lookupTable, size_t lookupTableLength, EnumLookupIndex_t* index, size_t notFoundValue);
+
+//Build the index for a lookup table
+// - Called automatically on first indexed lookup. Can be called
+//   up front to avoid the one-off cost, or before sharing a table
+//   between threads.
+// - On ARM, IRQs are masked while the index is built, so lookups from
+//   interrupt handlers are safe. Call this up front if that latency
+//   matters.
+void enumLookupBuildIndex(EnumLookupIndex_t* index);
 
 //Pass this to above functions to provide arguments 2 and 3 for a given enum type.
-#define EnumLookupTableAndSize(enumType) enumType##_Lookup, enumType##_Lookup_Length
+// - Also passes the index, which selects the indexed lookup.
+#define EnumLookupTableAndSize(enumType) enumType##_Lookup, enumType##_Lookup_Length, &enumType##_Lookup_Index
+
+//Build the index for a given enum type
+#define EnumLookupBuildIndex(enumType) enumLookupBuildIndex(&enumType##_Lookup_Index)
+
+//Select the indexed functions if called with an index.
+#define _ENUM_EXPAND(x) x
+#define _ENUM_SELECT4(_1,_2,_3,_4,NAME,...) NAME
+#define _ENUM_SELECT5(_1,_2,_3,_4,_5,NAME,...) NAME
+
+#define enumToString(...)     _ENUM_EXPAND(_ENUM_SELECT4(__VA_ARGS__, enumToStringIdx    , (enumToString)    , ~)(__VA_ARGS__))
+#define enumToStringSafe(...) _ENUM_EXPAND(_ENUM_SELECT4(__VA_ARGS__, enumToStringSafeIdx, (enumToStringSafe), ~)(__VA_ARGS__))
+#define stringToEnum(...)     _ENUM_EXPAND(_ENUM_SELECT5(__VA_ARGS__, stringToEnumIdx    , (stringToEnum)    , ~)(__VA_ARGS__))
 
 // Generate lookup table header file
 #define GENERATE_ENUM_LOOKUP_TABLE_HEADER(enumType, lookupMacro) \
 extern const EnumLookupTable_t enumType##_Lookup [];   \
+extern EnumLookupIndex_t enumType##_Lookup_Index;      \
 extern const size_t enumType##_Lookup_Length
 
 // Generate lookup table header file
+// - Hash has one displacement bucket and two slots per entry.
 #define GENERATE_ENUM_LOOKUP_TABLE_SOURCE(enumType, lookupMacro) \
 const EnumLookupTable_t enumType##_Lookup [] = {  \
     lookupMacro(GENERATE_LOOKUP,enumType) \
 };                                        \
+static unsigned short enumType##_Lookup_Order [    sizeof(enumType##_Lookup) / sizeof(EnumLookupTable_t)]; \
+static unsigned short enumType##_Lookup_Disp  [    sizeof(enumType##_Lookup) / sizeof(EnumLookupTable_t)]; \
+static unsigned short enumType##_Lookup_Hash  [2 * sizeof(enumType##_Lookup) / sizeof(EnumLookupTable_t)]; \
+EnumLookupIndex_t enumType##_Lookup_Index = {     \
+    enumType##_Lookup, sizeof(enumType##_Lookup) / sizeof(EnumLookupTable_t),         \
+    enumType##_Lookup_Order, enumType##_Lookup_Hash, enumType##_Lookup_Disp,           \
+    2 * sizeof(enumType##_Lookup) / sizeof(EnumLookupTable_t), 0, 0                    \
+};                                        \
 const size_t enumType##_Lookup_Length = sizeof(enumType##_Lookup) / sizeof(EnumLookupTable_t)
 
 #else
@@ -89,6 +148,8 @@ const size_t enumType##_Lookup_Length = sizeof(enumType##_Lookup) / sizeof(EnumL
 #define enumToStringSafe(...) UNKNOWN_STR
 #define stringToEnum(...)     (-1)
 
+#define EnumLookupBuildIndex(...)
+
 #define GENERATE_ENUM_LOOKUP_TABLE_HEADER(...)
 #define GENERATE_ENUM_LOOKUP_TABLE_SOURCE(...)
 
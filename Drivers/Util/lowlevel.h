@@ -13,6 +13,10 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 17/10/2026 | Add PMU cycle counter registers
+ *            | Add cache control and maintenance registers
+ *            | Add MMU translation table registers
+ *            | Add MPIDR register
  * 31/01/2024 | Include ISR attributes header
  * 14/01/2024 | Creation of header
  *
@@ -114,6 +118,74 @@ __name_proc_state(ProcState state) {
     }
 }
 
+// ACTLR Register (Auxiliary Control)
+#define SYSREG_ACTLR_CP         1
+#define SYSREG_ACTLR_CP_OP      0
+#define SYSREG_ACTLR_CPA        0
+#define SYSREG_ACTLR_CPA_OP     1
+
+#define SYSREG_ACTLR_BIT_FW     0
+#define SYSREG_ACTLR_BIT_L1PE   2
+#define SYSREG_ACTLR_BIT_SMP    6
+#define SYSREG_ACTLR_BIT_PARITY 9
+
+// CSSELR Register (Cache Size Selection)
+#define SYSREG_CSSELR_CP        0
+#define SYSREG_CSSELR_CP_OP     2
+#define SYSREG_CSSELR_CPA       0
+#define SYSREG_CSSELR_CPA_OP    0
+
+// CCSIDR Register (Cache Size ID)
+#define SYSREG_CCSIDR_CP        0
+#define SYSREG_CCSIDR_CP_OP     1
+#define SYSREG_CCSIDR_CPA       0
+#define SYSREG_CCSIDR_CPA_OP    0
+
+// Cache maintenance operations (write only)
+//  - ICIALLU:  Invalidate all instruction caches
+//  - BPIALL:   Invalidate all branch predictors
+//  - DCxMVAC:  Invalidate/Clean/Clean+Invalidate data cache line by address
+//  - DCxSW:    Invalidate/Clean/Clean+Invalidate data cache line by set/way
+#define SYSREG_ICIALLU_CP       7
+#define SYSREG_ICIALLU_CP_OP    0
+#define SYSREG_ICIALLU_CPA      5
+#define SYSREG_ICIALLU_CPA_OP   0
+
+#define SYSREG_BPIALL_CP        7
+#define SYSREG_BPIALL_CP_OP     0
+#define SYSREG_BPIALL_CPA       5
+#define SYSREG_BPIALL_CPA_OP    6
+
+#define SYSREG_DCIMVAC_CP       7
+#define SYSREG_DCIMVAC_CP_OP    0
+#define SYSREG_DCIMVAC_CPA      6
+#define SYSREG_DCIMVAC_CPA_OP   1
+
+#define SYSREG_DCCMVAC_CP       7
+#define SYSREG_DCCMVAC_CP_OP    0
+#define SYSREG_DCCMVAC_CPA      10
+#define SYSREG_DCCMVAC_CPA_OP   1
+
+#define SYSREG_DCCIMVAC_CP      7
+#define SYSREG_DCCIMVAC_CP_OP   0
+#define SYSREG_DCCIMVAC_CPA     14
+#define SYSREG_DCCIMVAC_CPA_OP  1
+
+#define SYSREG_DCISW_CP         7
+#define SYSREG_DCISW_CP_OP      0
+#define SYSREG_DCISW_CPA        6
+#define SYSREG_DCISW_CPA_OP     2
+
+#define SYSREG_DCCSW_CP         7
+#define SYSREG_DCCSW_CP_OP      0
+#define SYSREG_DCCSW_CPA        10
+#define SYSREG_DCCSW_CPA_OP     2
+
+#define SYSREG_DCCISW_CP        7
+#define SYSREG_DCCISW_CP_OP     0
+#define SYSREG_DCCISW_CPA       14
+#define SYSREG_DCCISW_CPA_OP    2
+
 // Access macros
 #define __SET_PROC_STATE(state)     __set_proc_state(state)  // Must be constant value
 #define __GET_PROC_STATE()          __current_proc_state()
@@ -194,6 +266,14 @@ __MOV_REG_GEN(pc)
 #define SYSREG_SCTLR_BIT_Z     11
 #define SYSREG_SCTLR_BIT_I     12
 
+// MPIDR Register (Multiprocessor Affinity, read only)
+#define SYSREG_MPIDR_CP        0
+#define SYSREG_MPIDR_CP_OP     0
+#define SYSREG_MPIDR_CPA       0
+#define SYSREG_MPIDR_CPA_OP    5
+
+#define SYSREG_MPIDR_MASK_CPUID 0x3
+
 // VBAR Register
 #define SYSREG_VBAR_CP         12
 #define SYSREG_VBAR_CP_OP      0
@@ -206,6 +286,59 @@ __MOV_REG_GEN(pc)
 #define SYSREG_CPACR_CPA        0
 #define SYSREG_CPACR_CPA_OP     2
 
+// PMCR Register (Performance Monitor Control)
+#define SYSREG_PMCR_CP          9
+#define SYSREG_PMCR_CP_OP       0
+#define SYSREG_PMCR_CPA         12
+#define SYSREG_PMCR_CPA_OP      0
+
+#define SYSREG_PMCR_BIT_E       0
+#define SYSREG_PMCR_BIT_C       2
+#define SYSREG_PMCR_BIT_D       3
+
+// PMCNTENSET Register (Performance Monitor Count Enable Set)
+#define SYSREG_PMCNTENSET_CP     9
+#define SYSREG_PMCNTENSET_CP_OP  0
+#define SYSREG_PMCNTENSET_CPA    12
+#define SYSREG_PMCNTENSET_CPA_OP 1
+
+#define SYSREG_PMCNTENSET_BIT_C  31
+
+// PMCCNTR Register (Performance Monitor Cycle Counter)
+#define SYSREG_PMCCNTR_CP       9
+#define SYSREG_PMCCNTR_CP_OP    0
+#define SYSREG_PMCCNTR_CPA      13
+#define SYSREG_PMCCNTR_CPA_OP   0
+
+// TTBR0 Register (Translation Table Base 0)
+#define SYSREG_TTBR0_CP         2
+#define SYSREG_TTBR0_CP_OP      0
+#define SYSREG_TTBR0_CPA        0
+#define SYSREG_TTBR0_CPA_OP     0
+
+#define SYSREG_TTBR0_BIT_IRGN1  0
+#define SYSREG_TTBR0_BIT_S      1
+#define SYSREG_TTBR0_BIT_RGN    3
+#define SYSREG_TTBR0_BIT_IRGN0  6
+
+// TTBCR Register (Translation Table Base Control)
+#define SYSREG_TTBCR_CP         2
+#define SYSREG_TTBCR_CP_OP      0
+#define SYSREG_TTBCR_CPA        0
+#define SYSREG_TTBCR_CPA_OP     2
+
+// DACR Register (Domain Access Control)
+#define SYSREG_DACR_CP          3
+#define SYSREG_DACR_CP_OP       0
+#define SYSREG_DACR_CPA         0
+#define SYSREG_DACR_CPA_OP      0
+
+// TLBIALL (Invalidate entire unified TLB, write only)
+#define SYSREG_TLBIALL_CP       8
+#define SYSREG_TLBIALL_CP_OP    0
+#define SYSREG_TLBIALL_CPA      7
+#define SYSREG_TLBIALL_CPA_OP   0
+
 // Access macros
 //   Converts to MCR/MRC instructions
 #define __SET_SYSREG(coProc, regName, val) __arm_mcr(coProc, SYSREG_##regName##_CP_OP, (val), SYSREG_##regName##_CP, SYSREG_##regName##_CPA, SYSREG_##regName##_CPA_OP)
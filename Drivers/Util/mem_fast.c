@@ -0,0 +1,254 @@
+/* Fast Memory Routines
+ * --------------------
+ *
+ * Word-wide, LDM/STM and NEON implementations of memory
+ * copy, fill and compare.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Use only aligned word accesses
+ * 17/10/2026 | Only use LDM/STM when MEMFAST_IMPL_LDM is selected
+ * 17/10/2026 | Creation of driver.
+ */
+
+#include "mem_fast.h"
+
+#include <stdint.h>
+
+#include "Util/bit_helpers.h"
+
+#if (MEMFAST_IMPL == MEMFAST_IMPL_NEON) && !defined(__ARM_NEON)
+#error "MEMFAST_IMPL_NEON requires NEON to be enabled in the compiler (e.g. -mfpu=neon)"
+#endif
+
+//Blocks shorter than this are handled a byte at a time, as aligning costs more than it saves
+#define MEMFAST_MIN_BLOCK 16
+
+//Word type which may alias any other type. Words are only ever accessed at aligned
+//addresses, as unaligned accesses fault when the MMU is off (Strongly-ordered memory).
+typedef uint32_t __attribute__((may_alias)) MemFastWord_t;
+
+/*
+ * Copy
+ */
+
+//Every path copies strictly forwards, loading each block before storing it.
+//MemFast_move() relies on this for overlapping blocks with dst below src.
+void MemFast_copy(void* dst, const void* src, size_t length) {
+    uint8_t* d = (uint8_t*)dst;
+    const uint8_t* s = (const uint8_t*)src;
+#if MEMFAST_IMPL != MEMFAST_IMPL_BYTE
+    if (length >= MEMFAST_MIN_BLOCK) {
+        //Align the destination
+        while (!pointerIsAligned(d, sizeof(uint32_t))) {
+            *d++ = *s++;
+            length--;
+        }
+#if MEMFAST_IMPL == MEMFAST_IMPL_NEON
+        //64 bytes at a time. VLD1 does not need the source to be aligned.
+        while (length >= 64) {
+            __asm volatile (
+                "vld1.8 {d0-d3}, [%[s]]!\n\t"
+                "vld1.8 {d4-d7}, [%[s]]!\n\t"
+                "vst1.8 {d0-d3}, [%[d]]!\n\t"
+                "vst1.8 {d4-d7}, [%[d]]!"
+                : [d] "+r" (d), [s] "+r" (s)
+                :
+                : "d0", "d1", "d2", "d3", "d4", "d5", "d6", "d7", "memory");
+            length -= 64;
+        }
+#elif (MEMFAST_IMPL == MEMFAST_IMPL_LDM) && defined(__arm__)
+        //32 bytes at a time if both are aligned. LDM/STM need aligned addresses.
+        if (pointerIsAligned(s, sizeof(uint32_t))) {
+            while (length >= 32) {
+                __asm volatile (
+                    "ldmia %[s]!, {r3-r6, r8-r10, r12}\n\t"
+                    "stmia %[d]!, {r3-r6, r8-r10, r12}"
+                    : [d] "+r" (d), [s] "+r" (s)
+                    :
+                    : "r3", "r4", "r5", "r6", "r8", "r9", "r10", "r12", "memory");
+                length -= 32;
+            }
+        }
+#endif
+        //Then a word at a time
+        if (pointerIsAligned(s, sizeof(uint32_t))) {
+            for (; length >= 4; d += 4, s += 4, length -= 4) {
+                *(MemFastWord_t*)d = *(const MemFastWord_t*)s;
+            }
+        } else {
+            //Source is misaligned, so load the aligned words around it and shift them
+            //together (little endian). Stops 8 bytes from the end so the last load
+            //does not go past the source.
+            unsigned int shift = 8 * ((uintptr_t)s & (sizeof(uint32_t) - 1));
+            const MemFastWord_t* sw = (const MemFastWord_t*)(s - shift / 8);
+            uint32_t lo = *sw++;
+            for (; length >= 8; d += 4, s += 4, length -= 4) {
+                uint32_t hi = *sw++;
+                *(MemFastWord_t*)d = (lo >> shift) | (hi << (32 - shift));
+                lo = hi;
+            }
+        }
+    }
+#endif
+    //Remaining bytes
+    while (length--) {
+        *d++ = *s++;
+    }
+}
+
+/*
+ * Move
+ */
+
+void MemFast_move(void* dst, const void* src, size_t length) {
+    uint8_t* d = (uint8_t*)dst;
+    const uint8_t* s = (const uint8_t*)src;
+    if ((d <= s) || (d >= s + length)) {
+        //Copying forwards is safe if the destination is below the source, as each
+        //block is loaded before it is stored, and stores stay below the next load.
+        MemFast_copy(dst, src, length);
+        return;
+    }
+    //Destination overlaps the end of the source, so copy backwards
+    d += length;
+    s += length;
+#if MEMFAST_IMPL != MEMFAST_IMPL_BYTE
+    if ((length >= MEMFAST_MIN_BLOCK) && !((d - s) & (sizeof(uint32_t) - 1))) {
+        //Align the destination end
+        while (!pointerIsAligned(d, sizeof(uint32_t))) {
+            *--d = *--s;
+            length--;
+        }
+        //Then a word at a time. The source is now aligned too, and words do not
+        //overlap as d is at least a word above s.
+        for (; length >= 4; length -= 4) {
+            d -= 4;
+            s -= 4;
+            *(MemFastWord_t*)d = *(const MemFastWord_t*)s;
+        }
+    }
+#endif
+    //Remaining bytes
+    while (length--) {
+        *--d = *--s;
+    }
+}
+
+/*
+ * Fill
+ */
+
+void MemFast_set(void* dst, int value, size_t length) {
+    uint8_t* d = (uint8_t*)dst;
+#if MEMFAST_IMPL != MEMFAST_IMPL_BYTE
+    if (length >= MEMFAST_MIN_BLOCK) {
+        uint32_t w = 0x01010101U * (uint8_t)value;
+        //Align the destination
+        while (!pointerIsAligned(d, sizeof(uint32_t))) {
+            *d++ = (uint8_t)value;
+            length--;
+        }
+#if MEMFAST_IMPL == MEMFAST_IMPL_NEON
+        //64 bytes at a time
+        while (length >= 64) {
+            __asm volatile (
+                "vdup.32 q0, %[w]\n\t"
+                "vmov q1, q0\n\t"
+                "vst1.8 {d0-d3}, [%[d]]!\n\t"
+                "vst1.8 {d0-d3}, [%[d]]!"
+                : [d] "+r" (d)
+                : [w] "r" (w)
+                : "d0", "d1", "d2", "d3", "memory");
+            length -= 64;
+        }
+#elif (MEMFAST_IMPL == MEMFAST_IMPL_LDM) && defined(__arm__)
+        //32 bytes at a time, with the pattern held in the STM registers
+        if (length >= 32) {
+            register uint32_t w0 __asm("r3")  = w;
+            register uint32_t w1 __asm("r4")  = w;
+            register uint32_t w2 __asm("r5")  = w;
+            register uint32_t w3 __asm("r6")  = w;
+            register uint32_t w4 __asm("r8")  = w;
+            register uint32_t w5 __asm("r9")  = w;
+            register uint32_t w6 __asm("r10") = w;
+            register uint32_t w7 __asm("r12") = w;
+            while (length >= 32) {
+                __asm volatile (
+                    "stmia %[d]!, {r3-r6, r8-r10, r12}"
+                    : [d] "+r" (d)
+                    : "r" (w0), "r" (w1), "r" (w2), "r" (w3), "r" (w4), "r" (w5), "r" (w6), "r" (w7)
+                    : "memory");
+                length -= 32;
+            }
+        }
+#endif
+        //Then a word at a time
+        for (; length >= 4; d += 4, length -= 4) {
+            *(MemFastWord_t*)d = w;
+        }
+    }
+#endif
+    //Remaining bytes
+    while (length--) {
+        *d++ = (uint8_t)value;
+    }
+}
+
+/*
+ * Compare
+ */
+
+int MemFast_compare(const void* a, const void* b, size_t length) {
+    const uint8_t* pa = (const uint8_t*)a;
+    const uint8_t* pb = (const uint8_t*)b;
+#if MEMFAST_IMPL != MEMFAST_IMPL_BYTE
+    if (length >= MEMFAST_MIN_BLOCK) {
+        //Align the first block
+        while (!pointerIsAligned(pa, sizeof(uint32_t))) {
+            if (*pa != *pb) return *pa - *pb;
+            pa++;
+            pb++;
+            length--;
+        }
+#if MEMFAST_IMPL == MEMFAST_IMPL_NEON
+        //32 bytes at a time, until a block differs
+        while (length >= 32) {
+            uint32_t lo, hi;
+            __asm volatile (
+                "vld1.8 {d0-d3}, [%[a]]\n\t"
+                "vld1.8 {d4-d7}, [%[b]]\n\t"
+                "veor q0, q0, q2\n\t"
+                "veor q1, q1, q3\n\t"
+                "vorr q0, q0, q1\n\t"
+                "vorr d0, d0, d1\n\t"
+                "vmov %[lo], %[hi], d0"
+                : [lo] "=r" (lo), [hi] "=r" (hi)
+                : [a] "r" (pa), [b] "r" (pb), "m" (*(const uint8_t (*)[32])pa), "m" (*(const uint8_t (*)[32])pb)
+                : "d0", "d1", "d2", "d3", "d4", "d5", "d6", "d7");
+            if (lo | hi) break;
+            pa += 32;
+            pb += 32;
+            length -= 32;
+        }
+#endif
+        //Then a word at a time, until a word differs. Misaligned blocks are
+        //compared a byte at a time below.
+        if (pointerIsAligned(pb, sizeof(uint32_t))) {
+            for (; length >= 4; pa += 4, pb += 4, length -= 4) {
+                if (*(const MemFastWord_t*)pa != *(const MemFastWord_t*)pb) break;
+            }
+        }
+    }
+#endif
+    //Remaining bytes, or the bytes of the word which differs
+    for (; length; pa++, pb++, length--) {
+        if (*pa != *pb) return *pa - *pb;
+    }
+    return 0;
+}
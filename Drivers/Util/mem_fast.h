@@ -0,0 +1,72 @@
+/* Fast Memory Routines
+ * --------------------
+ *
+ * Copy, fill and compare routines for the small and
+ * medium sized blocks moved around by the drivers, e.g.
+ * sector windows and directory entries in FatFS or the
+ * SD card bounce buffer.
+ *
+ * Blocks are handled a word at a time once the destination
+ * is aligned, with bytes only used for the head and tail.
+ * The implementation is selected at build time by defining
+ * MEMFAST_IMPL to one of:
+ *
+ *    MEMFAST_IMPL_BYTE  - Simple byte loops
+ *    MEMFAST_IMPL_WORD  - Word loops in plain C (default)
+ *    MEMFAST_IMPL_LDM   - Word loops, with LDM/STM moving
+ *                         32 bytes at a time on ARM
+ *    MEMFAST_IMPL_NEON  - NEON loads and stores of 64 bytes at
+ *                         a time. Requires NEON to be enabled
+ *                         in the compiler (e.g. -mfpu=neon).
+ *
+ * The LDM/STM and NEON paths are inline assembly which has
+ * not yet been assembled with an ARM toolchain or run on the
+ * board, so are not the default. Check them on the target
+ * before selecting them.
+ *
+ * The NEON routines use registers d0-d7. Interrupt handlers
+ * do not save these, so if NEON is selected the routines
+ * must not be called from an interrupt handler which may
+ * interrupt other floating point or NEON code.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Make the plain C word loops the default
+ * 17/10/2026 | Creation of header
+ */
+
+#ifndef MEM_FAST_H_
+#define MEM_FAST_H_
+
+#include <stddef.h>
+
+#define MEMFAST_IMPL_BYTE 0
+#define MEMFAST_IMPL_WORD 1
+#define MEMFAST_IMPL_NEON 2
+#define MEMFAST_IMPL_LDM  3
+
+#ifndef MEMFAST_IMPL
+#define MEMFAST_IMPL MEMFAST_IMPL_WORD
+#endif
+
+//Copy length bytes from src to dst
+// - The blocks must not overlap. Use MemFast_move() for overlapping blocks.
+void MemFast_copy(void* dst, const void* src, size_t length);
+
+//Move length bytes from src to dst, where the blocks may overlap
+void MemFast_move(void* dst, const void* src, size_t length);
+
+//Fill length bytes of dst with the low byte of value
+void MemFast_set(void* dst, int value, size_t length);
+
+//Compare length bytes of two blocks
+// - Returns 0 if the blocks are equal. Otherwise returns the difference
+//   between the first pair of bytes which differ, as for memcmp().
+int MemFast_compare(const void* a, const void* b, size_t length);
+
+#endif /* MEM_FAST_H_ */
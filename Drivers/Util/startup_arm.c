@@ -27,6 +27,53 @@
  *
  *      -D IRQ_STACK_SIZE=0x100
  *
+ *
+ * MMU and Caches
+ * --------------
+ *
+ * By default the MMU is left disabled, so every access to
+ * memory goes straight to the DDR. Globally defining the
+ * macro STARTUP_ENABLE_CACHES adds a stage after the C
+ * library has been initialised, but before main() is run,
+ * which calls __enable_caches() (see startup_arm.h). This
+ * builds a flat (virtual = physical) translation table of
+ * 1MB sections, where:
+ *
+ *   - DDR (0 to MMU_DDR_SIZE) and the on-chip RAM are
+ *     normal write-back cacheable shareable memory.
+ *   - The HPS-to-FPGA and lightweight (0xFF200000) bridges
+ *     are strongly-ordered.
+ *   - HPS peripherals are device memory.
+ *   - Anything else faults.
+ *
+ * The Snoop Control Unit (SCU) is enabled and the core joins
+ * the SMP coherency domain (ACTLR.SMP and FW), so that the L1
+ * data caches of both cores are kept coherent and exclusive
+ * accesses (LDREX/STREX) work between cores. The L1 and L2
+ * caches, branch prediction and prefetch are then enabled.
+ * This requires FatFS/hwlib/alt_cache.c.
+ *
+ * If the application starts the second core, that core must
+ * also call __enable_caches() before touching data shared with
+ * the first. It uses the table built by core 0, and only its
+ * own L1 caches are enabled. Until then, and whenever the MMU
+ * is off, the cores are not coherent.
+ *
+ * The DDR size defaults to 1GB, and can be changed with:
+ *
+ *      -D MMU_DDR_SIZE=0x80000000
+ *
+ * SDRAM in the FPGA, accessed through the HPS-to-FPGA
+ * bridge, can also be made cacheable by giving the base
+ * and size of its window. Both must be multiples of 1MB:
+ *
+ *      -D MMU_FPGA_SDRAM_BASE=0xC0000000
+ *      -D MMU_FPGA_SDRAM_SIZE=0x04000000
+ *
+ * Any buffers accessed by DMA must then be maintained with
+ * the alt_cache API. The HPS_DMA and FatFS drivers already
+ * do this.
+ *
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -34,6 +81,8 @@
  *
  * Date       | Changes
  * -----------+------------------------------------
+ * 17/10/2026 | Enable SCU and SMP coherency, map RAM as shareable
+ * 17/10/2026 | Add optional MMU and cache enable stage
  * 31/01/2024 | Correct ISR attributes
  * 14/01/2023 | Split startup routines from IRQ
  *
@@ -42,8 +91,13 @@
 #ifdef __arm__
 
 #include "Util/lowlevel.h"
+#include "Util/startup_arm.h"
+
+#include "FatFS/hwlib/alt_cache.h"
 
 #include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
 
 //Default size of HPS IRQ stacks. Must be power of two.
 //There are five such stacks, one for each IRQ mode (excluding app mode)
@@ -194,6 +248,210 @@ void __init_stacks (void) {
     __main();
 }
 
+/*
+ * MMU Translation Table
+ *
+ * Short-descriptor format, with 4096 1MB section entries. The section holding
+ * the on-chip RAM also contains HPS peripherals, so is split into 4kB pages by
+ * a second level table.
+ */
+
+//Size of the DDR mapped from address 0. Must be a multiple of 1MB.
+#ifndef MMU_DDR_SIZE
+#define MMU_DDR_SIZE 0x40000000
+#endif
+
+//Window of FPGA SDRAM to map as cacheable memory. Must be multiples of 1MB.
+#ifndef MMU_FPGA_SDRAM_BASE
+#define MMU_FPGA_SDRAM_BASE 0xC0000000
+#endif
+#ifndef MMU_FPGA_SDRAM_SIZE
+#define MMU_FPGA_SDRAM_SIZE 0
+#endif
+
+#if (MMU_DDR_SIZE & 0xFFFFF) || (MMU_FPGA_SDRAM_BASE & 0xFFFFF) || (MMU_FPGA_SDRAM_SIZE & 0xFFFFF)
+#error "MMU regions must be a multiple of 1MB"
+#endif
+
+//Fixed regions of the HPS address map
+#define MMU_H2F_BRIDGE_BASE   0xC0000000
+#define MMU_PERIPH_BASE       0xFC000000
+#define MMU_LW_BRIDGE_BASE    0xFF200000
+#define MMU_LW_BRIDGE_END     0xFF400000
+#ifdef __ARRIA10__
+#define MMU_OCRAM_BASE        0xFFE00000
+#define MMU_OCRAM_SIZE        0x40000
+#define SCU_BASE              0xFFFFC000
+#else
+#define MMU_OCRAM_BASE        0xFFFF0000
+#define MMU_OCRAM_SIZE        0x10000
+#define SCU_BASE              0xFFFEC000
+#endif
+
+//Snoop Control Unit registers
+#define SCU_CONTROL           (0x00/sizeof(uint32_t))
+#define SCU_INVALIDATE_ALL    (0x0C/sizeof(uint32_t))
+#define SCU_CONTROL_BIT_EN    0
+
+#define MMU_SECTION_SHIFT     20
+#define MMU_PAGE_SHIFT        12
+#define MMU_SECTION_COUNT     4096
+#define MMU_PAGE_COUNT        256
+
+//Section descriptors
+#define MMU_SECTION           (2 << 0)
+#define MMU_SECTION_B         (1 << 2)
+#define MMU_SECTION_C         (1 << 3)
+#define MMU_SECTION_XN        (1 << 4)
+#define MMU_SECTION_AP_RW     (3 << 10)
+#define MMU_SECTION_TEX(x)    ((x) << 12)
+#define MMU_SECTION_S         (1 << 16)
+
+#define MMU_SECTION_NORMAL    (MMU_SECTION | MMU_SECTION_AP_RW | MMU_SECTION_TEX(1) | MMU_SECTION_C | MMU_SECTION_B | MMU_SECTION_S) // Write-back, write-allocate, shareable
+#define MMU_SECTION_DEVICE    (MMU_SECTION | MMU_SECTION_AP_RW | MMU_SECTION_XN | MMU_SECTION_B)                     // Shareable device
+#define MMU_SECTION_STRONG    (MMU_SECTION | MMU_SECTION_AP_RW | MMU_SECTION_XN)                                     // Strongly-ordered
+#define MMU_SECTION_FAULT     0
+
+//Second level table and small page descriptors
+#define MMU_COARSE            (1 << 0)
+#define MMU_PAGE              (2 << 0)
+#define MMU_PAGE_XN           (1 << 0)
+#define MMU_PAGE_B            (1 << 2)
+#define MMU_PAGE_C            (1 << 3)
+#define MMU_PAGE_AP_RW        (3 << 4)
+#define MMU_PAGE_TEX(x)       ((x) << 6)
+#define MMU_PAGE_S            (1 << 10)
+
+#define MMU_PAGE_NORMAL       (MMU_PAGE | MMU_PAGE_AP_RW | MMU_PAGE_TEX(1) | MMU_PAGE_C | MMU_PAGE_B | MMU_PAGE_S)
+#define MMU_PAGE_DEVICE       (MMU_PAGE | MMU_PAGE_AP_RW | MMU_PAGE_XN | MMU_PAGE_B)
+
+//All domains are clients, so access permissions are checked
+#define MMU_DACR_ALL_CLIENT   0x55555555
+
+//Translation table walks use write-back, write-allocate cacheable shareable accesses
+#define MMU_TTBR_WALK_WBWA    ((1 << SYSREG_TTBR0_BIT_IRGN0) | (1 << SYSREG_TTBR0_BIT_RGN) | (1 << SYSREG_TTBR0_BIT_S))
+
+//ACTLR bits for joining the coherency domain. FW broadcasts cache and TLB maintenance to the other core.
+#define SMP_ACTLR_BITS        ((1 << SYSREG_ACTLR_BIT_SMP) | (1 << SYSREG_ACTLR_BIT_FW))
+
+static uint32_t __mmu_sections[MMU_SECTION_COUNT] __attribute__((aligned(MMU_SECTION_COUNT * sizeof(uint32_t))));
+static uint32_t __mmu_ocram_pages[MMU_PAGE_COUNT] __attribute__((aligned(MMU_PAGE_COUNT * sizeof(uint32_t))));
+
+//Get the section attributes for an address
+static uint32_t __mmu_section_attr(uint32_t address) {
+    if (address < MMU_DDR_SIZE) return MMU_SECTION_NORMAL;
+    if ((address >= MMU_FPGA_SDRAM_BASE) && (address - MMU_FPGA_SDRAM_BASE < MMU_FPGA_SDRAM_SIZE)) return MMU_SECTION_NORMAL;
+    if ((address >= MMU_LW_BRIDGE_BASE) && (address < MMU_LW_BRIDGE_END)) return MMU_SECTION_STRONG;
+    if (address >= MMU_PERIPH_BASE) return MMU_SECTION_DEVICE;
+    if (address >= MMU_H2F_BRIDGE_BASE) return MMU_SECTION_STRONG;
+    return MMU_SECTION_FAULT;
+}
+
+//Build the flat mapped translation table
+static void __mmu_build_table(void) {
+    for (uint32_t section = 0; section < MMU_SECTION_COUNT; section++) {
+        uint32_t address = section << MMU_SECTION_SHIFT;
+        uint32_t attr = __mmu_section_attr(address);
+        __mmu_sections[section] = (attr == MMU_SECTION_FAULT) ? MMU_SECTION_FAULT : (address | attr);
+    }
+    uint32_t base = MMU_OCRAM_BASE & ~((1 << MMU_SECTION_SHIFT) - 1);
+    for (uint32_t page = 0; page < MMU_PAGE_COUNT; page++) {
+        uint32_t address = base + (page << MMU_PAGE_SHIFT);
+        bool ocram = (address >= MMU_OCRAM_BASE) && (address - MMU_OCRAM_BASE < MMU_OCRAM_SIZE);
+        __mmu_ocram_pages[page] = address | (ocram ? MMU_PAGE_NORMAL : MMU_PAGE_DEVICE);
+    }
+    __mmu_sections[base >> MMU_SECTION_SHIFT] = (uint32_t)__mmu_ocram_pages | MMU_COARSE;
+}
+
+//Enable the Snoop Control Unit. Must be done by core 0 with its caches off.
+static void __scu_enable(void) {
+    volatile uint32_t* scu = (volatile uint32_t*)SCU_BASE;
+    if (scu[SCU_CONTROL] & (1 << SCU_CONTROL_BIT_EN)) return; // Already enabled
+    scu[SCU_INVALIDATE_ALL] = 0xFFFF; // All ways of the tag RAMs of all cores
+    scu[SCU_CONTROL] |= (1 << SCU_CONTROL_BIT_EN);
+    __dsb(0xF);
+}
+
+//Check whether running on core 0
+static bool __is_primary_core(void) {
+    return !(__GET_SYSREG(SYSREG_COPROC, MPIDR) & SYSREG_MPIDR_MASK_CPUID);
+}
+
+//Enable the MMU and caches
+void __enable_caches (void) {
+    bool primary = __is_primary_core();
+    if (primary) {
+        // Caches must be off while the table is built, so it is written straight to memory
+        __disable_caches();
+        __mmu_build_table();
+        __scu_enable();
+    } else {
+        // Table, SCU and L2 are already set up by core 0, and shared
+        alt_cache_l1_disable_all();
+    }
+    // Join the coherency domain before the data cache and MMU are enabled
+    __SET_SYSREG(SYSREG_COPROC, ACTLR, __GET_SYSREG(SYSREG_COPROC, ACTLR) | SMP_ACTLR_BITS);
+    __isb(0xF);
+    // Use TTBR0 for the whole address space
+    __SET_SYSREG(SYSREG_COPROC, TTBCR, 0);
+    __SET_SYSREG(SYSREG_COPROC, TTBR0, (uint32_t)__mmu_sections | MMU_TTBR_WALK_WBWA);
+    __SET_SYSREG(SYSREG_COPROC, DACR, MMU_DACR_ALL_CLIENT);
+    __SET_SYSREG(SYSREG_COPROC, TLBIALL, 0);
+    __SET_SYSREG(SYSREG_COPROC, BPIALL, 0);
+    __dsb(0xF);
+    __isb(0xF);
+    // Enable the MMU. Mapping is flat, so execution continues from the next instruction
+    unsigned int sctlr = __GET_SYSREG(SYSREG_COPROC, SCTLR);
+    __SET_SYSREG(SYSREG_COPROC, SCTLR, sctlr | (1 << SYSREG_SCTLR_BIT_M));
+    __isb(0xF);
+    // Then L2 (core 0 only), L1 instruction and data caches, branch prediction and prefetch
+    if (primary) {
+        alt_cache_system_enable();
+    } else {
+        alt_cache_l1_enable_all();
+    }
+}
+
+//Disable the caches and MMU
+void __disable_caches (void) {
+    // Write back and disable the caches before the MMU, as without it all accesses are uncached.
+    // The L2 is shared, so is only disabled by core 0.
+    if (__is_primary_core()) {
+        alt_cache_system_disable();
+    } else {
+        alt_cache_l1_disable_all();
+    }
+    // No longer coherent, so leave the coherency domain
+    __SET_SYSREG(SYSREG_COPROC, ACTLR, __GET_SYSREG(SYSREG_COPROC, ACTLR) & ~SMP_ACTLR_BITS);
+    __isb(0xF);
+    unsigned int sctlr = __GET_SYSREG(SYSREG_COPROC, SCTLR);
+    __SET_SYSREG(SYSREG_COPROC, SCTLR, sctlr & ~(1 << SYSREG_SCTLR_BIT_M));
+    __isb(0xF);
+    __SET_SYSREG(SYSREG_COPROC, TLBIALL, 0);
+    __SET_SYSREG(SYSREG_COPROC, BPIALL, 0);
+    __dsb(0xF);
+    __isb(0xF);
+}
+
+#ifdef STARTUP_ENABLE_CACHES
+
+/*
+ * Cache Enable Stage
+ *
+ * The linker replaces calls to main() with $Sub$$main(), which runs once the
+ * C library has been initialised, and the original is called as $Super$$main().
+ * The table is zero-initialised data, so can't be built before then.
+ */
+
+int $Super$$main(void);
+
+int $Sub$$main(void) {
+    __enable_caches();
+    return $Super$$main();
+}
+
+#endif
+
 
 #endif
 
@@ -0,0 +1,39 @@
+/*
+ * Startup Routines
+ * ----------------
+ *
+ * Functions provided by startup_arm.c which may also be
+ * called by the application. See startup_arm.c for the
+ * build options.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Enable caches on either core
+ * 17/10/2026 | Creation of header
+ *
+ */
+
+#ifndef STARTUP_ARM_H_
+#define STARTUP_ARM_H_
+
+//Enable the MMU and caches
+// - Builds a flat translation table, with DDR and on-chip RAM cacheable, and
+//   the FPGA bridges and HPS peripherals uncached.
+// - Enables the Snoop Control Unit and joins the SMP coherency domain.
+// - Then enables the L1 and L2 caches, branch prediction and prefetch.
+// - Called before main() if STARTUP_ENABLE_CACHES is defined.
+// - A second core must call this itself once started. It reuses the table
+//   built by core 0, and enables only its own L1 caches.
+void __enable_caches(void);
+
+//Disable the caches and MMU
+// - Dirty data is written back to memory first.
+// - The shared L2 cache is only disabled when called on core 0.
+void __disable_caches(void);
+
+#endif /* STARTUP_ARM_H_ */
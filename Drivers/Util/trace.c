@@ -0,0 +1,45 @@
+/*
+ * Deferred Binary Trace Logging
+ * -----------------------------
+ *
+ * Provides a `TracePrintf` logging macro which stores the
+ * format string address, a timestamp, and the raw arguments
+ * into a RAM ring buffer for decoding on the host.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#include "trace.h"
+
+#include <string.h>
+
+// Buffer index is masked, so must be a power of 2
+#if (TRACE_BUFFER_WORDS & (TRACE_BUFFER_WORDS - 1))
+#error "TRACE_BUFFER_WORDS must be a power of 2"
+#endif
+
+// Trace buffer
+TraceBuffer_t __traceBuffer;
+
+// Initialise trace buffer
+void trace_initialise(void) {
+    // Enable the cycle counter, reset, and divide by 64
+    unsigned int pmcr = __GET_SYSREG(SYSREG_COPROC, PMCR);
+    pmcr |= (1 << SYSREG_PMCR_BIT_E) | (1 << SYSREG_PMCR_BIT_C) | (1 << SYSREG_PMCR_BIT_D);
+    __SET_SYSREG(SYSREG_COPROC, PMCR, pmcr);
+    __SET_SYSREG(SYSREG_COPROC, PMCNTENSET, (1U << SYSREG_PMCNTENSET_BIT_C));
+    // Clear the buffer
+    memset(__traceBuffer.data, 0, sizeof(__traceBuffer.data));
+    __traceBuffer.head = 0;
+    __traceBuffer.sizeWords = TRACE_BUFFER_WORDS;
+    __traceBuffer.tickHz = TRACE_CPU_FREQ / 64;
+    __traceBuffer.magic = TRACE_MAGIC;
+}
@@ -0,0 +1,135 @@
+/*
+ * Deferred Binary Trace Logging
+ * -----------------------------
+ *
+ * Provides a `TracePrintf` logging macro which, rather than
+ * formatting the message with printf at the call site, stores
+ * the address of the format string, a timestamp, and the raw
+ * arguments into a RAM ring buffer. Each call costs tens of
+ * cycles regardless of the message.
+ *
+ * For example `TracePrintf(VERBOSE_INFO, "Read %u sectors", n)`
+ * will only log the message if the info flag is enabled in
+ * the verbosity mask, as with `DbgPrintf`.
+ *
+ * If VERBOSE_BINARY_TRACE is globally defined, `DbgPrintf` in
+ * Util/verbosity.h uses this trace instead of printf.
+ *
+ * The buffer holds the most recent TRACE_BUFFER_WORDS words of
+ * records, and older records are overwritten. To view the log,
+ * dump the `__traceBuffer` variable to a file from the debugger,
+ * for example with the Arm DS command:
+ *
+ *    dump binary value trace.bin __traceBuffer
+ *
+ * then decode it on the host using the application image with:
+ *
+ *    python Tools/traceDecode.py <image.axf> trace.bin
+ *
+ * Restrictions:
+ *  - The format must be a string literal.
+ *  - Up to 7 arguments, each stored as a 32-bit word. Pointers
+ *    and integers up to 32-bit are supported. 64-bit integers
+ *    are truncated, and floating point values are not supported.
+ *  - %s arguments are stored as pointers, so are only decoded if
+ *    the string is constant data in the application image.
+ *
+ * Record Format:
+ *
+ *    Word 0 : Format string address | argument count (bits 2:0)
+ *    Word 1 : Timestamp (PMU cycle counter)
+ *    Word 2+: Arguments
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 17/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <stdint.h>
+#include "Util/verbosity.h"
+#include "Util/lowlevel.h"
+
+//Size of trace buffer in 32-bit words. Must be a power of 2.
+#ifndef TRACE_BUFFER_WORDS
+#define TRACE_BUFFER_WORDS 2048
+#endif
+
+//Processor clock frequency, used by the decoder to convert timestamps.
+// - Default is 800MHz (Cyclone V) or 1.2GHz (Arria 10).
+#ifndef TRACE_CPU_FREQ
+#ifdef __ARRIA10__
+#define TRACE_CPU_FREQ 1200000000
+#else
+#define TRACE_CPU_FREQ 800000000
+#endif
+#endif
+
+//Marker word at start of buffer ("TRC1")
+#define TRACE_MAGIC 0x31435254
+
+//Trace buffer
+typedef struct {
+    uint32_t magic;      // TRACE_MAGIC once initialised
+    uint32_t sizeWords;  // Number of words in data[]
+    uint32_t tickHz;     // Timestamp frequency
+    volatile uint32_t head; // Total words ever written (wraps)
+    uint32_t data[TRACE_BUFFER_WORDS];
+} TraceBuffer_t;
+
+extern TraceBuffer_t __traceBuffer;
+
+//Initialise trace buffer
+// - Clears the buffer and starts the PMU cycle counter used for
+//   timestamps. The cycle counter is divided by 64 so that the
+//   32-bit timestamp wraps less often.
+void trace_initialise(void);
+
+//Write a trace record
+// - Use TracePrintf() rather than calling this directly.
+// - Space is reserved with an atomic add so records can be written
+//   from both thread and interrupt context.
+static inline void trace_write(const char* fmt, unsigned int nargs, const uint32_t* args) {
+    uint32_t pos = __atomic_fetch_add(&__traceBuffer.head, nargs + 2, __ATOMIC_RELAXED);
+    __traceBuffer.data[(pos++) & (TRACE_BUFFER_WORDS - 1)] = (uint32_t)fmt | nargs;
+    __traceBuffer.data[(pos++) & (TRACE_BUFFER_WORDS - 1)] = __GET_SYSREG(SYSREG_COPROC, PMCCNTR);
+    for (unsigned int idx = 0; idx < nargs; idx++) {
+        __traceBuffer.data[(pos++) & (TRACE_BUFFER_WORDS - 1)] = args[idx];
+    }
+}
+
+//Argument counting and conversion helpers
+#define _TRACE_W(x) ((uint32_t)(x))
+#define _TRACE_MAP0()
+#define _TRACE_MAP1(a)             ,_TRACE_W(a)
+#define _TRACE_MAP2(a,b)           ,_TRACE_W(a),_TRACE_W(b)
+#define _TRACE_MAP3(a,b,c)         ,_TRACE_W(a),_TRACE_W(b),_TRACE_W(c)
+#define _TRACE_MAP4(a,b,c,d)       ,_TRACE_W(a),_TRACE_W(b),_TRACE_W(c),_TRACE_W(d)
+#define _TRACE_MAP5(a,b,c,d,e)     ,_TRACE_W(a),_TRACE_W(b),_TRACE_W(c),_TRACE_W(d),_TRACE_W(e)
+#define _TRACE_MAP6(a,b,c,d,e,f)   ,_TRACE_W(a),_TRACE_W(b),_TRACE_W(c),_TRACE_W(d),_TRACE_W(e),_TRACE_W(f)
+#define _TRACE_MAP7(a,b,c,d,e,f,g) ,_TRACE_W(a),_TRACE_W(b),_TRACE_W(c),_TRACE_W(d),_TRACE_W(e),_TRACE_W(f),_TRACE_W(g)
+#define _TRACE_NARGS_(_0,_1,_2,_3,_4,_5,_6,_7,N,...) N
+#define _TRACE_NARGS(...) _TRACE_NARGS_(0, ##__VA_ARGS__, 7, 6, 5, 4, 3, 2, 1, 0)
+#define _TRACE_CAT_(a,b) a##b
+#define _TRACE_CAT(a,b) _TRACE_CAT_(a,b)
+
+//Log a message with level check
+// - Format strings are aligned so the argument count fits in the low bits of the address.
+#define TracePrintf(level, fmt, ...)                                                          \
+    do {                                                                                      \
+        if (verbose_levelEnabled(level)) {                                                    \
+            static const char __attribute__((aligned(8))) _traceFmt[] = fmt;                  \
+            trace_write(_traceFmt, _TRACE_NARGS(__VA_ARGS__),                                 \
+                        (const uint32_t[]){0 _TRACE_CAT(_TRACE_MAP, _TRACE_NARGS(__VA_ARGS__))(__VA_ARGS__)} + 1); \
+        }                                                                                     \
+    } while (0)
+
+#endif /* TRACE_H_ */
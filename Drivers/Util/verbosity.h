@@ -11,6 +11,10 @@
  * will only log the message if the info flag is enabled in
  * the verbosity mask.
  *
+ * If VERBOSE_BINARY_TRACE is globally defined, `DbgPrintf`
+ * instead stores messages to a binary trace buffer to be
+ * decoded on the host, avoiding the printf cost.
+ *
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -18,6 +22,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 17/10/2026 | Add option to log to binary trace
  * 29/12/2023 | Creation of driver
  *
  */
@@ -76,6 +81,13 @@ VerbosityLevelMasks verbose_getMask();
 bool verbose_levelEnabled(VerbosityLevelMasks mask);
 
 // Printf with level check
+// - If VERBOSE_BINARY_TRACE is globally defined, messages are logged to the
+//   binary trace buffer instead (see Util/trace.h).
+#ifdef VERBOSE_BINARY_TRACE
+#include "Util/trace.h"
+#define DbgPrintf(level, ...) TracePrintf(level, __VA_ARGS__)
+#else
 #define DbgPrintf(level, ...) if (verbose_levelEnabled(level)) printf(__VA_ARGS__)
+#endif
 
 #endif /* VERBOSITY_H_ */
@@ -0,0 +1,66 @@
+/*
+ * Memory Bandwidth Benchmark
+ *
+ * Measures read, write and copy bandwidth of a buffer in DDR, first with the
+ * MMU and caches disabled (as after reset), then again after enabling them
+ * with __enable_caches() from Util/startup_arm.c.
+ *
+ * Build WITHOUT -D STARTUP_ENABLE_CACHES so that the first set of results is
+ * uncached, and include FatFS/hwlib/alt_cache.c in the project.
+ */
+
+#include "Util/lowlevel.h"
+#include "Util/startup_arm.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+//Processor clock, used to convert cycles to bandwidth
+#define CPU_CLOCK_MHZ 800
+
+//Buffer size. Larger than the L2 cache, so results are for DDR.
+#define BENCH_SIZE (2 * 1024 * 1024)
+
+static uint32_t srcBuff[BENCH_SIZE / sizeof(uint32_t)];
+static uint32_t destBuff[BENCH_SIZE / sizeof(uint32_t)];
+
+//Convert a cycle count for BENCH_SIZE bytes into MB/s
+static unsigned int bandwidth(uint32_t cycles) {
+    return (unsigned int)(((uint64_t)BENCH_SIZE * CPU_CLOCK_MHZ) / cycles);
+}
+
+static void runBenchmark(const char* name) {
+    volatile uint32_t sum = 0;
+    uint32_t start, readTime, writeTime, copyTime;
+    //Read: sum every word of the buffer
+    start = __GET_SYSREG(SYSREG_COPROC, PMCCNTR);
+    for (unsigned int i = 0; i < BENCH_SIZE / sizeof(uint32_t); i++) {
+        sum += srcBuff[i];
+    }
+    readTime = __GET_SYSREG(SYSREG_COPROC, PMCCNTR) - start;
+    //Write: fill the buffer
+    start = __GET_SYSREG(SYSREG_COPROC, PMCCNTR);
+    memset(destBuff, 0xA5, BENCH_SIZE);
+    writeTime = __GET_SYSREG(SYSREG_COPROC, PMCCNTR) - start;
+    //Copy: one buffer to the other
+    start = __GET_SYSREG(SYSREG_COPROC, PMCCNTR);
+    memcpy(destBuff, srcBuff, BENCH_SIZE);
+    copyTime = __GET_SYSREG(SYSREG_COPROC, PMCCNTR) - start;
+    printf("%-10s Read %5u MB/s, Write %5u MB/s, Copy %5u MB/s\n", name, bandwidth(readTime), bandwidth(writeTime), bandwidth(copyTime));
+}
+
+int main(void) {
+    //Start the PMU cycle counter, counting every cycle
+    unsigned int pmcr = __GET_SYSREG(SYSREG_COPROC, PMCR);
+    pmcr &= ~(1 << SYSREG_PMCR_BIT_D);
+    __SET_SYSREG(SYSREG_COPROC, PMCR, pmcr | (1 << SYSREG_PMCR_BIT_E) | (1 << SYSREG_PMCR_BIT_C));
+    __SET_SYSREG(SYSREG_COPROC, PMCNTENSET, (1U << SYSREG_PMCNTENSET_BIT_C));
+    memset(srcBuff, 0x5A, BENCH_SIZE);
+    //Before: MMU and caches off
+    runBenchmark("Uncached");
+    //After: flat mapped, with L1/L2 caches, branch prediction and prefetch
+    __enable_caches();
+    runBenchmark("Cached");
+    while (1);
+}
@@ -0,0 +1,105 @@
+/*
+ * CRC Throughput Benchmark
+ *
+ * Measures the throughput of a CRC32 over a buffer in DDR using:
+ *
+ *   - A bit-at-a-time loop, as a baseline
+ *   - The slicing-by-8 software CRC (Util/crc_software.c), called directly
+ *   - The software CRC through the generic CRC interface (CRC_calculate())
+ *   - A hardware CRC core through the generic CRC interface, if provided
+ *
+ * No hardware CRC driver is included in the repository. To compare one,
+ * define benchHardwareCrc() in another file of the project, initialise the
+ * driver for a reflected CRC32 (poly 0x04C11DB7) in it, and return its
+ * CRCCtx_t. The hardware result is checked against the software one.
+ *
+ * Include Util/crc_software.c, Util/driver_crc.c and Util/driver_ctx.c in
+ * the project. Build with -D STARTUP_ENABLE_CACHES for cached results.
+ */
+
+#include "Util/lowlevel.h"
+#include "Util/driver_crc.h"
+#include "Util/crc_software.h"
+
+#include <stdio.h>
+#include <stdint.h>
+
+//Processor clock, used to convert cycles to bandwidth
+#define CPU_CLOCK_MHZ 800
+
+//Buffer size
+#define BENCH_SIZE (256 * 1024)
+
+static uint8_t buff[BENCH_SIZE];
+
+//Hardware CRC context to compare against. Override to return a hardware CRC driver.
+__attribute__((weak)) PCRCCtx_t benchHardwareCrc(void) {
+    return NULL;
+}
+
+//Convert a cycle count for BENCH_SIZE bytes into MB/s
+static unsigned int bandwidth(uint32_t cycles) {
+    return (unsigned int)(((uint64_t)BENCH_SIZE * CPU_CLOCK_MHZ) / cycles);
+}
+
+//Reflected CRC32, one bit at a time
+static uint32_t bitwiseCrc32(uint32_t crc, const uint8_t* data, unsigned int length) {
+    while (length--) {
+        crc ^= *data++;
+        for (unsigned int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+        }
+    }
+    return crc;
+}
+
+//Time a CRC over the buffer through the generic interface
+static uint32_t timeGeneric(PCRCCtx_t crcCtx, unsigned int* crc) {
+    *crc = 0xFFFFFFFF;
+    uint32_t start = __GET_SYSREG(SYSREG_COPROC, PMCCNTR);
+    HpsErr_t status = CRC_calculate(crcCtx, true, buff, BENCH_SIZE, crc);
+    uint32_t cycles = __GET_SYSREG(SYSREG_COPROC, PMCCNTR) - start;
+    if (IS_ERROR(status)) printf("CRC_calculate failed (%d)\n", status);
+    return cycles;
+}
+
+int main(void) {
+    //Start the PMU cycle counter, counting every cycle
+    unsigned int pmcr = __GET_SYSREG(SYSREG_COPROC, PMCR);
+    pmcr &= ~(1 << SYSREG_PMCR_BIT_D);
+    __SET_SYSREG(SYSREG_COPROC, PMCR, pmcr | (1 << SYSREG_PMCR_BIT_E) | (1 << SYSREG_PMCR_BIT_C));
+    __SET_SYSREG(SYSREG_COPROC, PMCNTENSET, (1U << SYSREG_PMCNTENSET_BIT_C));
+    for (unsigned int i = 0; i < BENCH_SIZE; i++) {
+        buff[i] = (uint8_t)(i * 7 + (i >> 8));
+    }
+    uint32_t start, cycles, crc;
+    //Baseline: bit-at-a-time
+    start = __GET_SYSREG(SYSREG_COPROC, PMCCNTR);
+    uint32_t refCrc = bitwiseCrc32(0xFFFFFFFF, buff, BENCH_SIZE);
+    cycles = __GET_SYSREG(SYSREG_COPROC, PMCCNTR) - start;
+    printf("%-18s %5u MB/s, CRC %08X\n", "Bitwise", bandwidth(cycles), (unsigned int)refCrc);
+    //Software CRC, called directly
+    start = __GET_SYSREG(SYSREG_COPROC, PMCCNTR);
+    crc = SWCRC_update(&SWCRC_CRC32, 0xFFFFFFFF, buff, BENCH_SIZE);
+    cycles = __GET_SYSREG(SYSREG_COPROC, PMCCNTR) - start;
+    printf("%-18s %5u MB/s, CRC %08X\n", "Software (direct)", bandwidth(cycles), (unsigned int)crc);
+    //Software CRC through the generic interface
+    PSWCRCCtx_t swCrc;
+    HpsErr_t status = SWCRC_initialise(&SWCRC_CRC32, CRC_FUNC_COMBINED, &swCrc);
+    if (IS_ERROR(status)) {
+        printf("SWCRC_initialise failed (%d)\n", status);
+        while (1);
+    }
+    unsigned int genCrc;
+    cycles = timeGeneric(&swCrc->crc, &genCrc);
+    printf("%-18s %5u MB/s, CRC %08X\n", "Software (generic)", bandwidth(cycles), genCrc);
+    //Hardware CRC through the generic interface
+    PCRCCtx_t hwCrc = benchHardwareCrc();
+    if (hwCrc) {
+        cycles = timeGeneric(hwCrc, &genCrc);
+        printf("%-18s %5u MB/s, CRC %08X%s\n", "Hardware (generic)", bandwidth(cycles), genCrc, (genCrc == refCrc) ? "" : " MISMATCH");
+    } else {
+        printf("No hardware CRC provided (see benchHardwareCrc())\n");
+    }
+    while (1);
+}
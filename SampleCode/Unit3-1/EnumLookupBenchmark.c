@@ -0,0 +1,92 @@
+/*
+ * Enum Lookup Benchmark
+ *
+ * Compares the linear scan and the indexed (sorted and hashed) lookups of
+ * Util/enum_lookup.c, using the error code table from Util/error.c. Each
+ * error code is converted to a string and each string back to a code, and
+ * the average number of cycles per lookup is printed.
+ *
+ * Build with -D ENUM_LOOKUP_ENABLED, and include Util/enum_lookup.c and
+ * Util/error.c in the project.
+ */
+
+#include "Util/lowlevel.h"
+#include "Util/error.h"
+#include "Util/enum_lookup.h"
+
+#include <stdio.h>
+#include <stdint.h>
+
+//Number of passes over the table for each measurement
+#define BENCH_PASSES 100
+
+static uint32_t linearToString(void) {
+    volatile const char* str;
+    uint32_t start = __GET_SYSREG(SYSREG_COPROC, PMCCNTR);
+    for (unsigned int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (size_t i = 0; i < ErrCodes_Lookup_Length; i++) {
+            //Plain table and length, so uses the linear scan
+            str = enumToString(ErrCodes_Lookup[i].enumVal, ErrCodes_Lookup, ErrCodes_Lookup_Length);
+        }
+    }
+    (void)str;
+    return __GET_SYSREG(SYSREG_COPROC, PMCCNTR) - start;
+}
+
+static uint32_t indexedToString(void) {
+    volatile const char* str;
+    uint32_t start = __GET_SYSREG(SYSREG_COPROC, PMCCNTR);
+    for (unsigned int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (size_t i = 0; i < ErrCodes_Lookup_Length; i++) {
+            //EnumLookupTableAndSize() also passes the index
+            str = enumToString(ErrCodes_Lookup[i].enumVal, EnumLookupTableAndSize(ErrCodes));
+        }
+    }
+    (void)str;
+    return __GET_SYSREG(SYSREG_COPROC, PMCCNTR) - start;
+}
+
+static uint32_t linearToEnum(void) {
+    volatile size_t val;
+    uint32_t start = __GET_SYSREG(SYSREG_COPROC, PMCCNTR);
+    for (unsigned int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (size_t i = 0; i < ErrCodes_Lookup_Length; i++) {
+            val = stringToEnum(ErrCodes_Lookup[i].str, ErrCodes_Lookup, ErrCodes_Lookup_Length, 0);
+        }
+    }
+    (void)val;
+    return __GET_SYSREG(SYSREG_COPROC, PMCCNTR) - start;
+}
+
+static uint32_t indexedToEnum(void) {
+    volatile size_t val;
+    uint32_t start = __GET_SYSREG(SYSREG_COPROC, PMCCNTR);
+    for (unsigned int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (size_t i = 0; i < ErrCodes_Lookup_Length; i++) {
+            val = stringToEnum(ErrCodes_Lookup[i].str, EnumLookupTableAndSize(ErrCodes), 0);
+        }
+    }
+    (void)val;
+    return __GET_SYSREG(SYSREG_COPROC, PMCCNTR) - start;
+}
+
+//Convert a total cycle count into cycles per lookup
+static unsigned int perLookup(uint32_t cycles) {
+    return (unsigned int)(cycles / (BENCH_PASSES * ErrCodes_Lookup_Length));
+}
+
+int main(void) {
+    //Start the PMU cycle counter, counting every cycle
+    unsigned int pmcr = __GET_SYSREG(SYSREG_COPROC, PMCR);
+    pmcr &= ~(1 << SYSREG_PMCR_BIT_D);
+    __SET_SYSREG(SYSREG_COPROC, PMCR, pmcr | (1 << SYSREG_PMCR_BIT_E) | (1 << SYSREG_PMCR_BIT_C));
+    __SET_SYSREG(SYSREG_COPROC, PMCNTENSET, (1U << SYSREG_PMCNTENSET_BIT_C));
+    //One-off cost of building the index (otherwise paid by the first indexed lookup)
+    uint32_t start = __GET_SYSREG(SYSREG_COPROC, PMCCNTR);
+    EnumLookupBuildIndex(ErrCodes);
+    uint32_t buildTime = __GET_SYSREG(SYSREG_COPROC, PMCCNTR) - start;
+    printf("%u entries. Index built in %u cycles.\n", (unsigned int)ErrCodes_Lookup_Length, (unsigned int)buildTime);
+    printf("Enum to string: Linear %5u cycles, Indexed %5u cycles\n", perLookup(linearToString()), perLookup(indexedToString()));
+    printf("String to enum: Linear %5u cycles, Indexed %5u cycles\n", perLookup(linearToEnum()), perLookup(indexedToEnum()));
+    while (1);
+}
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+#
+# Binary Trace Decoder
+# --------------------
+#
+# Decodes a dump of the `__traceBuffer` variable written by
+# Drivers/Util/trace.h back into text, using the application
+# image (.axf) to look up the format strings.
+#
+# Usage:
+#
+#    python traceDecode.py <image.axf> <trace.bin>
+#
+# Company: University of Leeds
+# Author: T Carpenter
+#
+# Change Log:
+#
+# Date       | Changes
+# -----------+----------------------------------
+# 17/10/2026 | Creation of tool
+#
+
+import re
+import struct
+import sys
+
+TRACE_MAGIC = 0x31435254
+TRACE_HEADER_WORDS = 4
+
+# printf conversion specifier
+CONVERSION = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|j|z|t|L)?([diouxXcspfFeEgGaA%])")
+
+
+class Image:
+    """Loadable sections of a little-endian ELF32 image"""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            elf = f.read()
+        if elf[:4] != b"\x7fELF" or elf[4] != 1 or elf[5] != 1:
+            raise ValueError("Not a little-endian ELF32 image")
+        shoff, = struct.unpack_from("<I", elf, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", elf, 0x2E)
+        self.sections = []
+        for idx in range(shnum):
+            _, shtype, flags, addr, offset, size = struct.unpack_from("<IIIIII", elf, shoff + idx * shentsize)
+            # Allocated sections with data in the file (SHT_PROGBITS, SHF_ALLOC)
+            if shtype == 1 and (flags & 0x2) and size:
+                self.sections.append((addr, elf[offset:offset + size]))
+
+    def string(self, addr):
+        """Null-terminated string at addr, or None if not in the image"""
+        for base, data in self.sections:
+            if base <= addr < base + len(data):
+                end = data.find(b"\0", addr - base)
+                if end < 0:
+                    return None
+                return data[addr - base:end].decode("latin-1")
+        return None
+
+
+def signed(word):
+    return word - (1 << 32) if word & 0x80000000 else word
+
+
+def format_message(image, fmt, args):
+    """Apply printf format to the 32-bit argument words"""
+    args = list(args)
+
+    def convert(match):
+        flags, _, conv = match.groups()
+        if conv == "%":
+            return "%"
+        word = args.pop(0) if args else 0
+        if conv in "di":
+            return ("%" + flags + "d") % signed(word)
+        if conv in "ouxX":
+            return ("%" + flags + conv) % word
+        if conv == "c":
+            return ("%" + flags + "c") % chr(word & 0xFF)
+        if conv == "s":
+            text = image.string(word)
+            return ("%" + flags + "s") % (text if text is not None else "<0x%08x>" % word)
+        if conv == "p":
+            return "0x%08x" % word
+        # Floating point is not supported by the trace
+        return "<0x%08x>" % word
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def parse_header(image, word):
+    """Return (format, argument count) if word is a valid record header"""
+    nargs = word & 0x7
+    fmt = image.string(word & ~0x7)
+    if fmt is None:
+        return None
+    if sum(1 for m in CONVERSION.finditer(fmt) if m.group(3) != "%") != nargs:
+        return None
+    return fmt, nargs
+
+
+def decode(image, dump):
+    magic, size, tick_hz, head = struct.unpack_from("<IIII", dump, 0)
+    if magic != TRACE_MAGIC:
+        raise ValueError("Trace buffer not initialised (bad magic 0x%08x)" % magic)
+    data = struct.unpack_from("<%dI" % size, dump, TRACE_HEADER_WORDS * 4)
+    # Oldest available word. If the buffer has wrapped, the first record may
+    # be partially overwritten, so skip forward until a valid header is found.
+    count = min(head, size)
+    pos = head - count
+    synced = (head <= size)
+    last_ts = None
+    time = 0
+    while pos + 2 <= head:
+        record = parse_header(image, data[pos % size])
+        if record is None or (pos + 2 + record[1]) > head:
+            if synced:
+                print("!! Corrupt record at word %d" % pos)
+            pos += 1
+            continue
+        synced = True
+        fmt, nargs = record
+        ts = data[(pos + 1) % size]
+        args = [data[(pos + 2 + idx) % size] for idx in range(nargs)]
+        pos += 2 + nargs
+        # Unwrap the 32-bit timestamp
+        if last_ts is not None:
+            time += (ts - last_ts) & 0xFFFFFFFF
+        last_ts = ts
+        message = format_message(image, fmt, args)
+        print("[%12.6f] %s" % (time / tick_hz, message.rstrip("\n")))
+
+
+def main():
+    if len(sys.argv) != 3:
+        print("Usage: %s <image.axf> <trace.bin>" % sys.argv[0])
+        return 1
+    image = Image(sys.argv[1])
+    with open(sys.argv[2], "rb") as f:
+        dump = f.read()
+    decode(image, dump)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())